@@ -0,0 +1,18 @@
+package com.podofo.android;
+
+/**
+ * Receives the duration and size of each completed signing phase.
+ * Callbacks are delivered synchronously on the thread calling into PoDoFoWrapper.
+ */
+public interface PoDoFoMetricsListener {
+
+    /**
+     * Called when a signing phase completes
+     *
+     * @param phase One of "load", "save", "hash", "computeSignature" or "dssUpdate"
+     * @param durationNanos The duration of the phase in nanoseconds
+     * @param byteCount The bytes processed by the phase: the document size for "load",
+     *                  the bytes read back for "hash" and the bytes written for the others
+     */
+    void onPhaseCompleted(String phase, long durationNanos, long byteCount);
+}
\ No newline at end of file
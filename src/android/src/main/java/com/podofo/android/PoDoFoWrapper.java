@@ -244,6 +244,19 @@ public class PoDoFoWrapper {
         return nativeGetCertificateIssuerUrlFromCertificate(nativeHandle, base64Cert);
     }
 
+    /**
+     * Set a listener receiving the timings and byte counts of the signing phases
+     *
+     * @param listener The listener, or null to stop reporting
+     * @throws PoDoFoException if the session is not initialized
+     */
+    public void setMetricsListener(PoDoFoMetricsListener listener) throws PoDoFoException {
+        if (nativeHandle == 0) {
+            throw new PoDoFoException("Session not initialized");
+        }
+        nativeSetMetricsListener(nativeHandle, listener);
+    }
+
     // Native methods implemented in C++
     private native long nativeInit(String conformanceLevel, String hashAlgorithm,
                                    String inputPath, String outputPath,
@@ -262,6 +275,7 @@ public class PoDoFoWrapper {
     private native String nativeGetOCSPFromCertificate(long handle, String base64Cert, String base64IssuerCert);
     private native String nativeBuildOCSPRequestFromCertificates(long handle, String base64Cert, String base64IssuerCert);
     private native String nativeGetCertificateIssuerUrlFromCertificate(long handle, String base64Cert);
+    private native void nativeSetMetricsListener(long handle, PoDoFoMetricsListener listener);
 
     /**
      * Clean up native resources
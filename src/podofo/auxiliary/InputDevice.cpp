@@ -25,6 +25,18 @@ bool InputStreamDevice::Peek(char& ch) const
     return peek(ch);
 }
 
+bool InputStreamDevice::TryGetView(string_view& view) const
+{
+    EnsureAccess(DeviceAccess::Read);
+    return tryGetView(view);
+}
+
+bool InputStreamDevice::tryGetView(string_view& view) const
+{
+    view = { };
+    return false;
+}
+
 void InputStreamDevice::checkRead() const
 {
     EnsureAccess(DeviceAccess::Read);
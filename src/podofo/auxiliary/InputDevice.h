@@ -31,12 +31,25 @@ public:
      */
     bool Peek(char& ch) const;
 
+    /** Try to get a view of the whole device contents, when
+     * they are contiguous in memory. Consumers can then scan
+     * the data directly, seeking the device to keep it in sync
+     * \remarks The view is valid until the device is written or closed
+     * \returns false if the device doesn't support it
+     */
+    bool TryGetView(std::string_view& view) const;
+
 protected:
     /** Peek at next char in stream.
      *  /returns true if success, false if EOF
      */
     virtual bool peek(char& ch) const = 0;
 
+    /** Get a view of the whole device contents, if contiguous in memory.
+     * The default implementation returns false
+     */
+    virtual bool tryGetView(std::string_view& view) const;
+
     void checkRead() const override;
 };
 
@@ -11,6 +11,16 @@
 
 #include <podofo/private/FileSystem.h>
 
+#ifdef _WIN32
+#include <podofo/private/WindowsLeanMean.h>
+#include <podofo/private/utfcpp_extensions.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif // _WIN32
+
 using namespace std;
 using namespace PoDoFo;
 
@@ -86,6 +96,8 @@ void seek(TStream& stream, ssize_t pos, SeekDirection direction)
 }
 
 static FILE* createFile(const string_view& filename, FileMode mode, DeviceAccess access);
+static const char* mapFile(const string_view& filepath, size_t& length);
+static void unmapFile(const char* data, size_t length);
 
 StreamDevice::StreamDevice(DeviceAccess access)
     : InputStreamDevice(false), OutputStreamDevice(false)
@@ -553,6 +565,100 @@ void FileStreamDevice::close()
     m_file = nullptr;
 }
 
+MappedFileStreamDevice::MappedFileStreamDevice(const string_view& filepath)
+    : StreamDevice(DeviceAccess::Read), m_Length(0), m_Position(0), m_Filepath(filepath)
+{
+    m_data = mapFile(filepath, m_Length);
+}
+
+MappedFileStreamDevice::~MappedFileStreamDevice()
+{
+    close();
+}
+
+size_t MappedFileStreamDevice::GetLength() const
+{
+    return m_Length;
+}
+
+size_t MappedFileStreamDevice::GetPosition() const
+{
+    return m_Position;
+}
+
+bool MappedFileStreamDevice::CanSeek() const
+{
+    return true;
+}
+
+bool MappedFileStreamDevice::Eof() const
+{
+    return m_Position == m_Length;
+}
+
+void MappedFileStreamDevice::writeBuffer(const char* buffer, size_t size)
+{
+    (void)buffer;
+    (void)size;
+    PODOFO_RAISE_ERROR_INFO(PdfErrorCode::InternalLogic, "A mapped file device is read-only");
+}
+
+size_t MappedFileStreamDevice::readBuffer(char* buffer, size_t size, bool& eof)
+{
+    size_t readCount = std::min(size, m_Length - m_Position);
+    std::memcpy(buffer, m_data + m_Position, readCount);
+    m_Position += readCount;
+    eof = m_Position == m_Length;
+    return readCount;
+}
+
+bool MappedFileStreamDevice::readChar(char& ch)
+{
+    if (m_Position == m_Length)
+    {
+        ch = '\0';
+        return false;
+    }
+
+    ch = m_data[m_Position];
+    m_Position++;
+    return true;
+}
+
+bool MappedFileStreamDevice::peek(char& ch) const
+{
+    if (m_Position == m_Length)
+    {
+        ch = '\0';
+        return false;
+    }
+
+    ch = m_data[m_Position];
+    return true;
+}
+
+void MappedFileStreamDevice::seek(ssize_t offset, SeekDirection direction)
+{
+    m_Position = SeekPosition(m_Position, m_Length, offset, direction);
+}
+
+bool MappedFileStreamDevice::tryGetView(string_view& view) const
+{
+    view = string_view(m_data, m_Length);
+    return true;
+}
+
+void MappedFileStreamDevice::close()
+{
+    if (m_data == nullptr)
+        return;
+
+    unmapFile(m_data, m_Length);
+    m_data = nullptr;
+    m_Length = 0;
+    m_Position = 0;
+}
+
 NullStreamDevice::NullStreamDevice()
     : StreamDevice(DeviceAccess::ReadWrite), m_Length(0), m_Position(0)
 {
@@ -719,6 +825,126 @@ void SpanStreamDevice::seek(ssize_t offset, SeekDirection direction)
     m_Position = SeekPosition(m_Position, m_Length, offset, direction);
 }
 
+bool SpanStreamDevice::tryGetView(string_view& view) const
+{
+    view = string_view(m_buffer, m_Length);
+    return true;
+}
+
+DeltaStreamDevice::DeltaStreamDevice(shared_ptr<InputStreamDevice> base, shared_ptr<StreamDevice> delta)
+    : StreamDevice(DeviceAccess::ReadWrite), m_base(std::move(base)), m_delta(std::move(delta)), m_Position(0)
+{
+    if (m_base == nullptr || m_delta == nullptr)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::InvalidHandle, "The base and the delta devices must be not null");
+
+    if (!m_base->CanSeek() || !m_delta->CanSeek())
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::IOError, "The base and the delta devices must be seekable");
+
+    m_BaseLength = m_base->GetLength();
+}
+
+size_t DeltaStreamDevice::GetLength() const
+{
+    return m_BaseLength + m_delta->GetLength();
+}
+
+size_t DeltaStreamDevice::GetPosition() const
+{
+    return m_Position;
+}
+
+bool DeltaStreamDevice::Eof() const
+{
+    return m_Position == GetLength();
+}
+
+bool DeltaStreamDevice::CanSeek() const
+{
+    return true;
+}
+
+void DeltaStreamDevice::writeBuffer(const char* buffer, size_t size)
+{
+    if (m_Position < m_BaseLength)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::IOError, "Attempt to write inside the read-only base content");
+
+    m_delta->Seek(m_Position - m_BaseLength);
+    m_delta->Write(buffer, size);
+    m_Position += size;
+}
+
+void DeltaStreamDevice::flush()
+{
+    m_delta->Flush();
+}
+
+size_t DeltaStreamDevice::readBuffer(char* buffer, size_t size, bool& eof)
+{
+    size_t readCount = 0;
+    bool partEof;
+    if (m_Position < m_BaseLength)
+    {
+        m_base->Seek(m_Position);
+        readCount = m_base->Read(buffer, std::min(size, m_BaseLength - m_Position), partEof);
+        m_Position += readCount;
+    }
+
+    if (readCount < size && m_Position >= m_BaseLength)
+    {
+        m_delta->Seek(m_Position - m_BaseLength);
+        size_t deltaReadCount = m_delta->Read(buffer + readCount, size - readCount, partEof);
+        m_Position += deltaReadCount;
+        readCount += deltaReadCount;
+    }
+
+    eof = m_Position == GetLength();
+    return readCount;
+}
+
+bool DeltaStreamDevice::readChar(char& ch)
+{
+    if (!peek(ch))
+        return false;
+
+    m_Position++;
+    return true;
+}
+
+bool DeltaStreamDevice::peek(char& ch) const
+{
+    if (m_Position < m_BaseLength)
+    {
+        m_base->Seek(m_Position);
+        return m_base->Peek(ch);
+    }
+
+    if (m_Position == GetLength())
+    {
+        ch = '\0';
+        return false;
+    }
+
+    m_delta->Seek(m_Position - m_BaseLength);
+    return m_delta->Peek(ch);
+}
+
+void DeltaStreamDevice::seek(ssize_t offset, SeekDirection direction)
+{
+    m_Position = SeekPosition(m_Position, GetLength(), offset, direction);
+}
+
+bool DeltaStreamDevice::tryGetView(string_view& view) const
+{
+    // The contents are contiguous only until something is appended
+    if (m_delta->GetLength() != 0)
+    {
+        view = { };
+        return false;
+    }
+
+    return m_base->TryGetView(view);
+}
+
 FILE* createFile(const string_view& filepath, FileMode mode, DeviceAccess access)
 {
     string cmode;
@@ -858,3 +1084,82 @@ FILE* createFile(const string_view& filepath, FileMode mode, DeviceAccess access
 
     return stream;
 }
+
+const char* mapFile(const string_view& filepath, size_t& length)
+{
+    length = 0;
+#ifdef _WIN32
+    auto filepath16 = utf8::utf8to16((string)filepath);
+    HANDLE file = CreateFileW((LPCWSTR)filepath16.c_str(), GENERIC_READ, FILE_SHARE_READ,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::IOError, "Error accessing file {}", filepath);
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::IOError, "Error reading the size of file {}", filepath);
+    }
+
+    if (size.QuadPart == 0)
+    {
+        // Empty files can't be mapped
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::IOError, "Error mapping file {}", filepath);
+
+    // The view keeps the mapping alive
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::IOError, "Error mapping file {}", filepath);
+
+    length = (size_t)size.QuadPart;
+    return (const char*)data;
+#else
+    int fd = ::open(string(filepath).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::IOError, "Error accessing file {}", filepath);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::IOError, "Error reading the size of file {}", filepath);
+    }
+
+    if (st.st_size == 0)
+    {
+        // Empty files can't be mapped
+        ::close(fd);
+        return nullptr;
+    }
+
+    void* data = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::IOError, "Error mapping file {}", filepath);
+
+    // The parser visits most of the file, although not sequentially,
+    // so ask for the whole file to be read ahead
+    (void)::madvise(data, (size_t)st.st_size, MADV_WILLNEED);
+    length = (size_t)st.st_size;
+    return (const char*)data;
+#endif // _WIN32
+}
+
+void unmapFile(const char* data, size_t length)
+{
+#ifdef _WIN32
+    (void)length;
+    (void)UnmapViewOfFile(data);
+#else
+    (void)::munmap(const_cast<char*>(data), length);
+#endif // _WIN32
+}
@@ -140,6 +140,50 @@ private:
     std::string m_Filepath;
 };
 
+/** A read-only device that maps a whole file in memory.
+ * The contents are exposed with TryGetView(), so consumers
+ * like PdfTokenizer can scan them directly instead of
+ * reading them character by character
+ * \remarks The file must not be truncated while it's mapped
+ */
+class PODOFO_API MappedFileStreamDevice final : public StreamDevice
+{
+public:
+    MappedFileStreamDevice(const std::string_view& filepath);
+
+    ~MappedFileStreamDevice();
+
+public:
+    const std::string& GetFilepath() const { return m_Filepath; }
+
+    size_t GetLength() const override;
+
+    size_t GetPosition() const override;
+
+    bool CanSeek() const override;
+
+    bool Eof() const override;
+
+protected:
+    void writeBuffer(const char* buffer, size_t size) override;
+    size_t readBuffer(char* buffer, size_t size, bool& eof) override;
+    bool readChar(char& ch) override;
+    bool peek(char& ch) const override;
+    void seek(ssize_t offset, SeekDirection direction) override;
+    bool tryGetView(std::string_view& view) const override;
+    void close() override;
+
+private:
+    MappedFileStreamDevice(const MappedFileStreamDevice&) = delete;
+    MappedFileStreamDevice& operator=(const MappedFileStreamDevice&) = delete;
+
+private:
+    const char* m_data;
+    size_t m_Length;
+    size_t m_Position;
+    std::string m_Filepath;
+};
+
 template <typename TContainer>
 class ContainerStreamDevice : public StreamDevice
 {
@@ -220,6 +264,12 @@ protected:
         m_Position = SeekPosition(m_Position, m_container->size(), offset, direction);
     }
 
+    bool tryGetView(std::string_view& view) const override
+    {
+        view = std::string_view(m_container->data(), m_container->size());
+        return true;
+    }
+
 private:
     TContainer* m_container;
     size_t m_Position;
@@ -258,6 +308,7 @@ protected:
     bool readChar(char& ch) override;
     bool peek(char& ch) const override;
     void seek(ssize_t offset, SeekDirection direction) override;
+    bool tryGetView(std::string_view& view) const override;
 
 private:
     SpanStreamDevice(std::nullptr_t) = delete;
@@ -295,6 +346,50 @@ private:
     size_t m_Position;
 };
 
+/**
+ * A device that exposes a read-only base content followed by
+ * a writable delta, stored on a separate device. Writing is only
+ * allowed past the end of the base content, which makes it suitable
+ * for incremental updates where only the appended section has to
+ * be stored, eg. by storage layers that concatenate the revisions
+ */
+class PODOFO_API DeltaStreamDevice final : public StreamDevice
+{
+public:
+    /**
+     * \param base the original content, which is never modified
+     * \param delta the device where the data written past the base content is stored.
+     *      It must be seekable and it's expected to be initially empty
+     */
+    DeltaStreamDevice(std::shared_ptr<InputStreamDevice> base, std::shared_ptr<StreamDevice> delta);
+
+public:
+    size_t GetLength() const override;
+
+    size_t GetPosition() const override;
+
+    bool Eof() const override;
+
+    bool CanSeek() const override;
+
+    size_t GetBaseLength() const { return m_BaseLength; }
+
+protected:
+    void writeBuffer(const char* buffer, size_t size) override;
+    void flush() override;
+    size_t readBuffer(char* buffer, size_t size, bool& eof) override;
+    bool readChar(char& ch) override;
+    bool peek(char& ch) const override;
+    void seek(ssize_t offset, SeekDirection direction) override;
+    bool tryGetView(std::string_view& view) const override;
+
+private:
+    std::shared_ptr<InputStreamDevice> m_base;
+    std::shared_ptr<StreamDevice> m_delta;
+    size_t m_BaseLength;
+    size_t m_Position;
+};
+
 using VectorStreamDevice = ContainerStreamDevice<std::vector<char>>;
 using StringStreamDevice = ContainerStreamDevice<std::string>;
 using BufferStreamDevice = ContainerStreamDevice<charbuff>;
@@ -12,6 +12,7 @@
 #include <string_view>
 #include <vector>
 #include <map>
+#include <memory_resource>
 #include <set>
 #include <unordered_set>
 #include <unordered_map>
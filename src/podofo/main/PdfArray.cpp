@@ -14,6 +14,9 @@ using namespace PoDoFo;
 
 PdfArray::PdfArray() { }
 
+PdfArray::PdfArray(pmr::memory_resource& resource)
+    : m_Objects(&resource) { }
+
 PdfArray::PdfArray(const PdfArray& rhs)
     : m_Objects(rhs.m_Objects)
 {
@@ -13,7 +13,7 @@
 namespace PoDoFo {
 
 class PdfArray;
-using PdfArrayList = std::vector<PdfObject>;
+using PdfArrayList = std::pmr::vector<PdfObject>;
 
 /**
  * Helper class to iterate through array indirect objects
@@ -96,6 +96,13 @@ public:
      */
     PdfArray();
 
+    /** Create an empty array which allocates its
+     *  items from the given memory resource
+     *  \remarks The resource must outlive the array. Copies
+     *      of the array use the default heap
+     */
+    PdfArray(std::pmr::memory_resource& resource);
+
     /** Deep copy an existing PdfArray
      *
      *  \param rhs the array to copy
@@ -9,6 +9,8 @@
 #include "PdfCommon.h"
 #include "PdfFontManager.h"
 
+#include <atomic>
+
 using namespace std;
 using namespace PoDoFo;
 
@@ -39,6 +41,9 @@ PODOFO_EXPORT ssl::OpenSSLMain s_SSL;
 
 static unsigned s_MaxObjectCount = (1U << 23) - 1;
 
+// Read by the stream compression workers when saving on multiple threads
+static atomic<int> s_FlateCompressionLevel(-1);
+
 void ssl::Init()
 {
     // Initialize the OpenSSL singleton
@@ -95,3 +100,16 @@ unsigned PdfCommon::GetMaxRecursionDepth()
 {
     return s_MaxRecursionDepth;
 }
+
+void PdfCommon::SetFlateCompressionLevel(int level)
+{
+    if (level < -1 || level > 9)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::ValueOutOfRange, "The compression level must be between -1 and 9");
+
+    s_FlateCompressionLevel.store(level, memory_order_relaxed);
+}
+
+int PdfCommon::GetFlateCompressionLevel()
+{
+    return s_FlateCompressionLevel.load(memory_order_relaxed);
+}
@@ -46,6 +46,16 @@ public:
 
     static unsigned GetMaxObjectCount();
     static void SetMaxObjectCount(unsigned maxObjectCount);
+
+    /** Set the compression level used by the FlateDecode filter
+     *  when encoding streams
+     *
+     *  \param level from 0 (no compression) to 9 (best compression),
+     *      or -1 for the default level of the deflate implementation
+     */
+    static void SetFlateCompressionLevel(int level);
+
+    static int GetFlateCompressionLevel();
 };
 
 }
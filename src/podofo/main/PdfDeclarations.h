@@ -490,6 +490,14 @@ enum class PdfSaveOptions
      * a regular save operation
      */
     SaveOnSigning = 64,
+    /** Pack the objects that are not streams in object streams,
+     * flate compressed unless NoFlateCompress is set, and write the
+     * cross-reference section as an XRef stream. This requires at
+     * least PDF 1.5 and it has no effect on incremental updates
+     *
+     * \see PdfMemDocument::SetObjectStreamSize
+     */
+    UseObjectStreams = 128,
 
     /**
       * \deprecated Use NoMetadataUpdate instead
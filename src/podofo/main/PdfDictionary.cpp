@@ -15,6 +15,9 @@ using namespace PoDoFo;
 
 PdfDictionary::PdfDictionary() { }
 
+PdfDictionary::PdfDictionary(pmr::memory_resource& resource)
+    : m_Map(&resource) { }
+
 PdfDictionary::PdfDictionary(const PdfDictionary& rhs)
     : m_Map(rhs.m_Map)
 {
@@ -160,7 +163,7 @@ void PdfDictionary::RemoveKeyNoDirtySet(const string_view& key)
 
 PdfObject& PdfDictionary::EmplaceNoDirtySet(const PdfName& key)
 {
-    return m_Map.emplace(key, nullptr).first->second;
+    return m_Map.try_emplace(key, nullptr).first->second;
 }
 
 PdfObject* PdfDictionary::getKey(const string_view& key) const
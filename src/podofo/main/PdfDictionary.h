@@ -9,6 +9,7 @@
 
 #include "PdfDeclarations.h"
 #include "PdfDataContainer.h"
+#include "PdfDictionaryMap.h"
 
 namespace PoDoFo {
 
@@ -67,8 +68,8 @@ private:
     PdfDictionary* m_dict;
 };
 
-using PdfDictionaryIndirectIterable = PdfDictionaryIndirectIterableBase<PdfObject, PdfNameMap<PdfObject>::iterator>;
-using PdfDictionaryConstIndirectIterable = PdfDictionaryIndirectIterableBase<const PdfObject, PdfNameMap<PdfObject>::const_iterator>;
+using PdfDictionaryIndirectIterable = PdfDictionaryIndirectIterableBase<PdfObject, PdfDictionaryMap::iterator>;
+using PdfDictionaryConstIndirectIterable = PdfDictionaryIndirectIterableBase<const PdfObject, PdfDictionaryMap::const_iterator>;
 
 /** The PDF dictionary data type of PoDoFo (inherits from PdfDataContainer,
  * the base class for such representations)
@@ -91,6 +92,13 @@ public:
      */
     PdfDictionary();
 
+    /** Create a new, empty dictionary which allocates
+     *  its entries from the given memory resource
+     *  \remarks The resource must outlive the dictionary. Copies
+     *      of the dictionary use the default heap
+     */
+    PdfDictionary(std::pmr::memory_resource& resource);
+
     /** Deep copy a dictionary
      *  \param rhs the PdfDictionary to copy
      */
@@ -320,8 +328,8 @@ public:
     PdfDictionaryConstIndirectIterable GetIndirectIterator() const;
 
 public:
-    using iterator = PdfNameMap<PdfObject>::iterator;
-    using const_iterator = PdfNameMap<PdfObject>::const_iterator;
+    using iterator = PdfDictionaryMap::iterator;
+    using const_iterator = PdfDictionaryMap::const_iterator;
 
 public:
     iterator begin();
@@ -351,7 +359,7 @@ private:
         const PdfStatefulEncrypt* encrypt, charbuff& buffer) const;
 
 private:
-    PdfNameMap<PdfObject> m_Map;
+    PdfDictionaryMap m_Map;
 };
 
 template<typename T>
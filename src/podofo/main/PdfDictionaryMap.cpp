@@ -0,0 +1,302 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#include <podofo/private/PdfDeclarationsPrivate.h>
+#include "PdfDictionaryMap.h"
+
+using namespace std;
+using namespace PoDoFo;
+
+static_assert(sizeof(PdfDictionaryMap::value_type) >= sizeof(void*),
+    "The slot of a removed entry must fit a pointer to the next free slot");
+
+// The header of a block of entries, followed by the entry slots
+struct PdfDictionaryMap::Block
+{
+    Block* Previous;
+    unsigned Capacity;
+    unsigned Used;
+};
+
+// Size of the block header, rounded so the slots are aligned
+constexpr size_t BlockHeaderSize = (sizeof(void*) + 2 * sizeof(unsigned) + alignof(PdfDictionaryMap::value_type) - 1)
+    / alignof(PdfDictionaryMap::value_type) * alignof(PdfDictionaryMap::value_type);
+constexpr size_t BlockAlignment = std::max(alignof(void*), alignof(PdfDictionaryMap::value_type));
+
+PdfDictionaryMap::PdfDictionaryMap()
+    : m_tree(nullptr), m_block(nullptr), m_freeSlot(nullptr), m_capacity(0) { }
+
+PdfDictionaryMap::PdfDictionaryMap(const allocator_type& allocator)
+    : m_entries(allocator), m_tree(nullptr), m_block(nullptr), m_freeSlot(nullptr), m_capacity(0) { }
+
+PdfDictionaryMap::PdfDictionaryMap(const PdfDictionaryMap& rhs)
+    : m_entries(rhs.m_entries.get_allocator().select_on_container_copy_construction()),
+    m_tree(nullptr), m_block(nullptr), m_freeSlot(nullptr), m_capacity(0)
+{
+    try
+    {
+        copyFrom(rhs);
+    }
+    catch (...)
+    {
+        // The destructor is not run if the constructor throws
+        clear();
+        throw;
+    }
+}
+
+PdfDictionaryMap::PdfDictionaryMap(PdfDictionaryMap&& rhs) noexcept
+    : m_entries(std::move(rhs.m_entries)), m_tree(rhs.m_tree), m_block(rhs.m_block),
+    m_freeSlot(rhs.m_freeSlot), m_capacity(rhs.m_capacity)
+{
+    rhs.m_entries.clear();
+    rhs.m_tree = nullptr;
+    rhs.m_block = nullptr;
+    rhs.m_freeSlot = nullptr;
+    rhs.m_capacity = 0;
+}
+
+PdfDictionaryMap::~PdfDictionaryMap()
+{
+    clear();
+}
+
+PdfDictionaryMap& PdfDictionaryMap::operator=(const PdfDictionaryMap& rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    // Copy in a temporary first, so this map is left
+    // untouched if copying an entry throws
+    PdfDictionaryMap copy(get_allocator());
+    copy.copyFrom(rhs);
+    clear();
+    stealFrom(copy);
+    return *this;
+}
+
+PdfDictionaryMap& PdfDictionaryMap::operator=(PdfDictionaryMap&& rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    if (m_entries.get_allocator() == rhs.m_entries.get_allocator())
+    {
+        // The storage can be stolen
+        clear();
+        stealFrom(rhs);
+    }
+    else
+    {
+        // Move the entries in the storage of this resource
+        PdfDictionaryMap moved(get_allocator());
+        if (rhs.size() != 0)
+            moved.addBlock(std::max(InitialCapacity, (unsigned)rhs.size()));
+
+        for (auto& pair : rhs)
+            moved.try_emplace(pair.first, std::move(pair.second));
+
+        clear();
+        stealFrom(moved);
+        rhs.clear();
+    }
+
+    return *this;
+}
+
+bool PdfDictionaryMap::operator==(const PdfDictionaryMap& rhs) const
+{
+    if (size() != rhs.size())
+        return false;
+
+    return std::equal(begin(), end(), rhs.begin());
+}
+
+bool PdfDictionaryMap::operator!=(const PdfDictionaryMap& rhs) const
+{
+    return !(*this == rhs);
+}
+
+PdfDictionaryMap::iterator PdfDictionaryMap::find(const string_view& key)
+{
+    if (m_tree != nullptr)
+        return iterator(m_tree->find(key));
+
+    size_t index = lowerBound(key);
+    if (index == m_entries.size() || m_entries[index]->first.GetRawData() != key)
+        return end();
+
+    return iterator(m_entries.data() + index);
+}
+
+PdfDictionaryMap::const_iterator PdfDictionaryMap::find(const string_view& key) const
+{
+    return const_cast<PdfDictionaryMap&>(*this).find(key);
+}
+
+PdfDictionaryMap::iterator PdfDictionaryMap::erase(const const_iterator& it)
+{
+    if (m_tree != nullptr)
+    {
+        auto slot = *it.m_node;
+        auto next = m_tree->erase(it.m_node);
+        slot->~value_type();
+        releaseSlot(slot);
+        return iterator(next);
+    }
+
+    size_t index = (size_t)(it.m_entry - m_entries.data());
+    auto slot = m_entries[index];
+    m_entries.erase(m_entries.begin() + index);
+    slot->~value_type();
+    releaseSlot(slot);
+    return iterator(m_entries.data() + index);
+}
+
+void PdfDictionaryMap::clear()
+{
+    for (auto& pair : *this)
+        pair.~value_type();
+
+    m_entries.clear();
+    destroyTree();
+    releaseBlocks();
+}
+
+size_t PdfDictionaryMap::lowerBound(const string_view& key) const
+{
+    auto found = std::lower_bound(m_entries.begin(), m_entries.end(), key,
+        [](const value_type* entry, const string_view& key) {
+            return entry->first.GetRawData() < key;
+        });
+    return (size_t)(found - m_entries.begin());
+}
+
+PdfDictionaryMap::value_type* PdfDictionaryMap::allocateSlot()
+{
+    if (m_freeSlot != nullptr)
+    {
+        auto slot = m_freeSlot;
+        m_freeSlot = *reinterpret_cast<value_type**>(slot);
+        return slot;
+    }
+
+    if (m_block == nullptr || m_block->Used == m_block->Capacity)
+    {
+        // Double the total capacity, without moving the existing entries
+        addBlock(m_capacity == 0 ? InitialCapacity : m_capacity);
+    }
+
+    return getSlots(*m_block) + m_block->Used++;
+}
+
+void PdfDictionaryMap::createTree()
+{
+    PODOFO_ASSERT(m_tree == nullptr);
+    pmr::polymorphic_allocator<Tree> allocator(get_allocator().resource());
+    auto tree = new(allocator.allocate(1))Tree(allocator.resource());
+    try
+    {
+        for (auto entry : m_entries)
+            tree->insert(tree->end(), entry);
+    }
+    catch (...)
+    {
+        tree->~Tree();
+        allocator.deallocate(tree, 1);
+        throw;
+    }
+
+    m_tree = tree;
+
+    // Release the sorted array, which is not used anymore
+    pmr::vector<value_type*>(get_allocator()).swap(m_entries);
+}
+
+void PdfDictionaryMap::destroyTree()
+{
+    if (m_tree == nullptr)
+        return;
+
+    pmr::polymorphic_allocator<Tree> allocator(get_allocator().resource());
+    m_tree->~Tree();
+    allocator.deallocate(m_tree, 1);
+    m_tree = nullptr;
+}
+
+void PdfDictionaryMap::addBlock(unsigned capacity)
+{
+    // The entries are moved to a tree before
+    // the sorted array grows past the threshold
+    if (m_tree == nullptr)
+        m_entries.reserve(std::min(m_capacity + capacity, TreeThreshold));
+
+    auto resource = m_entries.get_allocator().resource();
+    auto block = static_cast<Block*>(resource->allocate(getBlockSize(capacity), BlockAlignment));
+    block->Previous = m_block;
+    block->Capacity = capacity;
+    block->Used = 0;
+    m_block = block;
+    m_capacity += capacity;
+}
+
+void PdfDictionaryMap::releaseSlot(value_type* slot)
+{
+    *reinterpret_cast<value_type**>(slot) = m_freeSlot;
+    m_freeSlot = slot;
+}
+
+void PdfDictionaryMap::releaseBlocks()
+{
+    auto resource = m_entries.get_allocator().resource();
+    while (m_block != nullptr)
+    {
+        auto previous = m_block->Previous;
+        resource->deallocate(m_block, getBlockSize(m_block->Capacity), BlockAlignment);
+        m_block = previous;
+    }
+
+    m_freeSlot = nullptr;
+    m_capacity = 0;
+}
+
+void PdfDictionaryMap::stealFrom(PdfDictionaryMap& rhs) noexcept
+{
+    PODOFO_ASSERT(m_block == nullptr && m_tree == nullptr && m_entries.get_allocator() == rhs.m_entries.get_allocator());
+    m_entries = std::move(rhs.m_entries);
+    m_tree = rhs.m_tree;
+    m_block = rhs.m_block;
+    m_freeSlot = rhs.m_freeSlot;
+    m_capacity = rhs.m_capacity;
+    rhs.m_entries.clear();
+    rhs.m_tree = nullptr;
+    rhs.m_block = nullptr;
+    rhs.m_freeSlot = nullptr;
+    rhs.m_capacity = 0;
+}
+
+void PdfDictionaryMap::copyFrom(const PdfDictionaryMap& rhs)
+{
+    PODOFO_ASSERT(m_block == nullptr);
+    if (rhs.size() == 0)
+        return;
+
+    // Copy all the entries in a single block
+    addBlock(std::max(InitialCapacity, (unsigned)rhs.size()));
+    for (auto& pair : rhs)
+        try_emplace(pair.first, pair.second);
+}
+
+PdfDictionaryMap::value_type* PdfDictionaryMap::getSlots(Block& block)
+{
+    static_assert(sizeof(Block) <= BlockHeaderSize);
+    return reinterpret_cast<value_type*>(reinterpret_cast<char*>(&block) + BlockHeaderSize);
+}
+
+size_t PdfDictionaryMap::getBlockSize(unsigned capacity)
+{
+    return BlockHeaderSize + capacity * sizeof(value_type);
+}
@@ -0,0 +1,276 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#ifndef PDF_DICTIONARY_MAP_H
+#define PDF_DICTIONARY_MAP_H
+
+#include "PdfObject.h"
+
+namespace PoDoFo {
+
+/** The container of the entries of a PdfDictionary, ordered by key
+ *
+ * Most dictionaries have just a few keys: instead of allocating a tree
+ * node for each entry, the entries are stored in blocks of growing capacity
+ * and looked up with a binary search on a contiguous sorted array of
+ * pointers to them. Blocks are never reallocated, so, like with std::map,
+ * references to the entries stay valid until the entries are removed.
+ * Above TreeThreshold entries, where moving the pointers on an out of
+ * order insertion costs more than allocating a tree node, the sorted
+ * array is replaced by a tree of the same pointers.
+ * Unlike std::map, any insertion or removal invalidates all the iterators.
+ * The storage is allocated from a std::pmr::memory_resource: copies use
+ * the default resource, while moves keep the resource of the source.
+ * Assignments keep the resource of the destination, so a move assignment
+ * from a map with a different resource moves the entries one by one and
+ * may throw
+ */
+class PODOFO_API PdfDictionaryMap final
+{
+public:
+    using key_type = PdfName;
+    using mapped_type = PdfObject;
+    using value_type = std::pair<const PdfName, PdfObject>;
+    using size_type = size_t;
+    using allocator_type = std::pmr::polymorphic_allocator<value_type*>;
+
+    /** Capacity of the first block of entries
+     */
+    static constexpr unsigned InitialCapacity = 8;
+
+    /** Count of entries above which they are indexed by a tree
+     */
+    static constexpr unsigned TreeThreshold = 4096;
+
+private:
+    struct EntryInequality
+    {
+        using is_transparent = std::true_type;
+
+        bool operator()(const value_type* lhs, const value_type* rhs) const
+        {
+            return lhs->first.GetRawData() < rhs->first.GetRawData();
+        }
+        bool operator()(const value_type* lhs, const std::string_view& rhs) const
+        {
+            return lhs->first.GetRawData() < rhs;
+        }
+        bool operator()(const std::string_view& lhs, const value_type* rhs) const
+        {
+            return lhs < rhs->first.GetRawData();
+        }
+    };
+
+    using Tree = std::pmr::set<value_type*, EntryInequality>;
+
+public:
+    template <typename TValue>
+    class Iterator final
+    {
+        friend class PdfDictionaryMap;
+        template <typename> friend class Iterator;
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = TValue;
+        using pointer = TValue*;
+        using reference = TValue&;
+        using iterator_category = std::bidirectional_iterator_tag;
+    public:
+        Iterator() : m_entry(nullptr), m_isNode(false) { }
+        template <typename TOther, typename = std::enable_if_t<std::is_const_v<TValue> && !std::is_const_v<TOther>>>
+        Iterator(const Iterator<TOther>& it) : m_entry(it.m_entry), m_node(it.m_node), m_isNode(it.m_isNode) { }
+    private:
+        Iterator(PdfDictionaryMap::value_type* const* entry) : m_entry(entry), m_isNode(false) { }
+        Iterator(const Tree::const_iterator& node) : m_entry(nullptr), m_node(node), m_isNode(true) { }
+    public:
+        Iterator(const Iterator&) = default;
+        Iterator& operator=(const Iterator&) = default;
+        bool operator==(const Iterator& rhs) const
+        {
+            return m_isNode ? m_node == rhs.m_node : m_entry == rhs.m_entry;
+        }
+        bool operator!=(const Iterator& rhs) const { return !(*this == rhs); }
+        Iterator& operator++()
+        {
+            if (m_isNode)
+                m_node++;
+            else
+                m_entry++;
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+        Iterator& operator--()
+        {
+            if (m_isNode)
+                m_node--;
+            else
+                m_entry--;
+            return *this;
+        }
+        Iterator operator--(int)
+        {
+            auto copy = *this;
+            --(*this);
+            return copy;
+        }
+        reference operator*() const { return *operator->(); }
+        pointer operator->() const { return m_isNode ? *m_node : *m_entry; }
+    private:
+        PdfDictionaryMap::value_type* const* m_entry;
+        Tree::const_iterator m_node;
+        bool m_isNode;
+    };
+
+    using iterator = Iterator<value_type>;
+    using const_iterator = Iterator<const value_type>;
+
+public:
+    PdfDictionaryMap();
+    explicit PdfDictionaryMap(const allocator_type& allocator);
+    PdfDictionaryMap(const PdfDictionaryMap& rhs);
+    PdfDictionaryMap(PdfDictionaryMap&& rhs) noexcept;
+    ~PdfDictionaryMap();
+
+    PdfDictionaryMap& operator=(const PdfDictionaryMap& rhs);
+    PdfDictionaryMap& operator=(PdfDictionaryMap&& rhs);
+
+    bool operator==(const PdfDictionaryMap& rhs) const;
+    bool operator!=(const PdfDictionaryMap& rhs) const;
+
+public:
+    /** Insert an entry with the given key, constructing the
+     * value with the given arguments, only if the key is not present.
+     * All the iterators are invalidated if the entry is inserted
+     * \returns the iterator to the entry with the key and true
+     *     if the entry was inserted
+     */
+    template <typename... TArgs>
+    std::pair<iterator, bool> try_emplace(const PdfName& key, TArgs&&... args);
+
+    iterator find(const std::string_view& key);
+    const_iterator find(const std::string_view& key) const;
+
+    /** Remove the entry pointed by the iterator. All the
+     * iterators are invalidated, except the returned one
+     * \returns the iterator following the removed entry
+     */
+    iterator erase(const const_iterator& it);
+
+    /** Remove all entries and release the storage
+     */
+    void clear();
+
+    iterator begin() { return m_tree == nullptr ? iterator(m_entries.data()) : iterator(m_tree->begin()); }
+    iterator end() { return m_tree == nullptr ? iterator(m_entries.data() + m_entries.size()) : iterator(m_tree->end()); }
+    const_iterator begin() const { return const_cast<PdfDictionaryMap&>(*this).begin(); }
+    const_iterator end() const { return const_cast<PdfDictionaryMap&>(*this).end(); }
+    size_t size() const { return m_tree == nullptr ? m_entries.size() : m_tree->size(); }
+    bool empty() const { return size() == 0; }
+    allocator_type get_allocator() const { return m_entries.get_allocator(); }
+
+private:
+    struct Block;
+
+    // Index of the first entry with a key not less than the given one
+    size_t lowerBound(const std::string_view& key) const;
+    value_type* allocateSlot();
+    template <typename... TArgs>
+    value_type* constructEntry(const PdfName& key, TArgs&&... args);
+    // Move the sorted pointers to a tree
+    void createTree();
+    void destroyTree();
+    void addBlock(unsigned capacity);
+    static value_type* getSlots(Block& block);
+    static size_t getBlockSize(unsigned capacity);
+    void releaseSlot(value_type* slot);
+    void releaseBlocks();
+    // Take the storage of a map with the same resource, this map must be empty
+    void stealFrom(PdfDictionaryMap& rhs) noexcept;
+    void copyFrom(const PdfDictionaryMap& rhs);
+
+private:
+    std::pmr::vector<value_type*> m_entries;    ///< Pointers to the entries, sorted by key, when not in m_tree
+    Tree* m_tree;                       ///< Pointers to the entries above TreeThreshold, or nullptr
+    Block* m_block;                     ///< The last allocated block, linked to the previous ones
+    value_type* m_freeSlot;             ///< Slots of the removed entries, linked for reuse
+    unsigned m_capacity;                ///< Total capacity of the blocks
+};
+
+template <typename... TArgs>
+std::pair<PdfDictionaryMap::iterator, bool> PdfDictionaryMap::try_emplace(const PdfName& key, TArgs&&... args)
+{
+    if (m_tree == nullptr && m_entries.size() >= TreeThreshold)
+        createTree();
+
+    auto raw = key.GetRawData();
+    if (m_tree != nullptr)
+    {
+        auto found = m_tree->lower_bound(raw);
+        if (found != m_tree->end() && (*found)->first.GetRawData() == raw)
+            return { iterator(found), false };
+
+        auto entry = constructEntry(key, std::forward<TArgs>(args)...);
+        try
+        {
+            return { iterator(m_tree->insert(found, entry)), true };
+        }
+        catch (...)
+        {
+            entry->~value_type();
+            releaseSlot(entry);
+            throw;
+        }
+    }
+
+    size_t index;
+    // Fast path for entries inserted in key order, as it
+    // happens for dictionaries read from documents written
+    // with sorted keys
+    if (m_entries.empty() || m_entries.back()->first.GetRawData() < raw)
+    {
+        index = m_entries.size();
+    }
+    else
+    {
+        index = lowerBound(raw);
+        if (m_entries[index]->first.GetRawData() == raw)
+            return { iterator(m_entries.data() + index), false };
+    }
+
+    auto entry = constructEntry(key, std::forward<TArgs>(args)...);
+
+    // NOTE: The vector capacity is reserved when allocating
+    // blocks, so this insertion never throws
+    m_entries.insert(m_entries.begin() + index, entry);
+    return { iterator(m_entries.data() + index), true };
+}
+
+template <typename... TArgs>
+PdfDictionaryMap::value_type* PdfDictionaryMap::constructEntry(const PdfName& key, TArgs&&... args)
+{
+    auto slot = allocateSlot();
+    try
+    {
+        new(slot)value_type(std::piecewise_construct, std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<TArgs>(args)...));
+    }
+    catch (...)
+    {
+        releaseSlot(slot);
+        throw;
+    }
+
+    return slot;
+}
+
+};
+
+#endif // PDF_DICTIONARY_MAP_H
@@ -6,6 +6,7 @@
 
 #include <podofo/private/PdfDeclarationsPrivate.h>
 #include <podofo/private/XMPUtils.h>
+#include <podofo/private/PdfDecodedStreamCache.h>
 #include "PdfDocument.h"
 
 #include "PdfExtGState.h"
@@ -29,6 +30,7 @@ PdfDocument::PdfDocument(const PdfDocument& doc) :
     m_Metadata(*this),
     m_FontManager(*this)
 {
+    SetDecodedStreamCacheSize(doc.GetDecodedStreamCacheSize());
     SetTrailer(std::make_unique<PdfObject>(doc.GetTrailer().GetObject()));
     Init();
 }
@@ -64,6 +66,24 @@ void PdfDocument::Clear()
     m_NameTrees = nullptr;
     m_Objects.Clear();
     clear();
+    m_MemoryResource = nullptr;
+    if (m_DecodedStreams != nullptr)
+        m_DecodedStreams->Clear();
+}
+
+void PdfDocument::SetDecodedStreamCacheSize(size_t budget)
+{
+    if (budget == 0)
+        m_DecodedStreams = nullptr;
+    else if (m_DecodedStreams == nullptr)
+        m_DecodedStreams.reset(new PdfDecodedStreamCache(budget));
+    else
+        m_DecodedStreams->SetBudget(budget);
+}
+
+size_t PdfDocument::GetDecodedStreamCacheSize() const
+{
+    return m_DecodedStreams == nullptr ? 0 : m_DecodedStreams->GetBudget();
 }
 
 void PdfDocument::clear()
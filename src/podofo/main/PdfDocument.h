@@ -30,6 +30,7 @@ class PdfAction;
 class PdfExtGState;
 class PdfEncrypt;
 class PdfDocument;
+class PdfDecodedStreamCache;
 
 template <typename TField>
 class PdfDocumentFieldIterableBase final
@@ -114,6 +115,8 @@ class PODOFO_API PdfDocument
     friend class PdfPageCollection;
     friend class PdfMemDocument;
     friend class PdfStreamedDocument;
+    friend class PdfObjectStream;
+    PODOFO_PRIVATE_FRIEND(class PdfDocumentTest);
 
 public:
     /** Close down/destruct the PdfDocument
@@ -386,6 +389,29 @@ public:
 
     PdfFontManager& GetFonts() { return m_FontManager; }
 
+    /** Get the memory resource the entries of the parsed
+     *  dictionaries and arrays are allocated from
+     *  \returns the memory resource, or nullptr if the default heap is used
+     *  \see PdfMemDocument::SetMemoryResource
+     */
+    std::pmr::memory_resource* GetMemoryResource() const { return m_MemoryResource.get(); }
+
+    /** Set the byte budget of the cache of the decoded streams
+     *
+     *  When enabled, the data decoded by PdfObjectStream::GetCopy()/CopyTo()
+     *  is kept in memory, so streams read many times, like a form XObject
+     *  drawn on every page, are decoded only once. The least recently used
+     *  data is evicted when the budget is exceeded, and the data of a
+     *  stream is dropped as soon as the stream or its dictionary is modified.
+     *  The cache itself is synchronized, so different streams of the document
+     *  can be read from different threads. The same stream still can't be read
+     *  concurrently, as with the cache disabled
+     *  \param budget the budget in bytes. Default is 0, which disables the cache
+     */
+    void SetDecodedStreamCacheSize(size_t budget);
+
+    size_t GetDecodedStreamCacheSize() const;
+
 protected:
     /** Set the trailer of this PdfDocument
      *  deleting the old one.
@@ -458,6 +484,10 @@ private:
     PdfDocument& operator=(const PdfDocument&) = delete;
 
 private:
+    // NOTE: The resource is declared first so it's released
+    // only after all the objects allocated from it
+    std::shared_ptr<std::pmr::memory_resource> m_MemoryResource;
+    std::unique_ptr<PdfDecodedStreamCache> m_DecodedStreams;
     PdfIndirectObjectList m_Objects;
     PdfMetadata m_Metadata;
     PdfFontManager m_FontManager;
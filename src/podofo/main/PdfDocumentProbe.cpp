@@ -0,0 +1,263 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#include <podofo/private/PdfDeclarationsPrivate.h>
+#include "PdfDocumentProbe.h"
+
+#include <podofo/auxiliary/StreamDevice.h>
+#include <podofo/private/PdfParser.h>
+#include <podofo/private/PdfObjectStreamParser.h>
+
+#include "PdfArray.h"
+#include "PdfDictionary.h"
+
+using namespace std;
+using namespace PoDoFo;
+
+// Reads the objects directly from the xref entries, without a
+// document, up to the maximum object count of the probe. The
+// objects are not owned by a document, so the references they
+// contain must be resolved with Resolve()
+class PdfDocumentProbe::ObjectReader final
+{
+public:
+    ObjectReader(InputStreamDevice& device, PdfXRefEntries& entries, bool encrypted);
+
+    /** \returns the referenced object if obj is a reference,
+     *      or obj itself otherwise
+     */
+    const PdfObject* Resolve(const PdfObject* obj);
+
+private:
+    PdfObject* readObject(const PdfReference& ref);
+    const PdfDecodedObjectStream* getObjectStream(uint32_t objectNum);
+
+private:
+    InputStreamDevice* m_device;
+    PdfXRefEntries* m_entries;
+    bool m_encrypted;
+    shared_ptr<charbuff> m_buffer;
+    unordered_map<uint32_t, unique_ptr<PdfObject>> m_objects;
+    unordered_map<uint32_t, PdfDecodedObjectStream> m_streams;
+    unsigned m_readCount;
+};
+
+PdfDocumentProbe::PdfDocumentProbe()
+{
+    reset();
+}
+
+void PdfDocumentProbe::Probe(const string_view& filename)
+{
+    if (filename.length() == 0)
+        PODOFO_RAISE_ERROR(PdfErrorCode::InvalidHandle);
+
+    FileStreamDevice device(filename);
+    Probe(device);
+}
+
+void PdfDocumentProbe::ProbeFromBuffer(const bufferview& buffer)
+{
+    if (buffer.size() == 0)
+        PODOFO_RAISE_ERROR(PdfErrorCode::InvalidHandle);
+
+    SpanStreamDevice device(buffer);
+    Probe(device);
+}
+
+void PdfDocumentProbe::Probe(InputStreamDevice& device)
+{
+    reset();
+
+    PdfIndirectObjectList objects;
+    PdfParser parser(objects);
+    if (!parser.IsPdfFile(device))
+        PODOFO_RAISE_ERROR(PdfErrorCode::InvalidPDF);
+
+    parser.ReadDocumentStructure(device);
+
+    auto& trailer = parser.GetTrailer().GetDictionary();
+    m_PdfVersion = parser.GetPdfVersion();
+    m_IncrementalUpdateCount = (unsigned)parser.GetIncrementalUpdatesCount();
+    m_HasXRefStream = parser.HasXRefStream();
+    auto encryptObj = trailer.GetKey("Encrypt");
+    m_Encrypted = encryptObj != nullptr && !encryptObj->IsNull();
+
+    ObjectReader reader(device, parser.m_entries, m_Encrypted);
+    auto catalogObj = reader.Resolve(trailer.GetKey("Root"));
+    const PdfDictionary* catalog;
+    if (catalogObj == nullptr || !catalogObj->TryGetDictionary(catalog))
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::ObjectNotFound, "Catalog object not found!");
+
+    auto versionObj = reader.Resolve(catalog->GetKey("Version"));
+    if (versionObj != nullptr && versionObj->IsName())
+    {
+        auto version = PoDoFo::GetPdfVersion(versionObj->GetName().GetString());
+        if (version != PdfVersion::Unknown)
+            m_PdfVersion = version;
+    }
+
+    m_HasDSS = catalog->GetKey("DSS") != nullptr;
+
+    const PdfDictionary* dict;
+    int64_t num;
+    auto pagesObj = reader.Resolve(catalog->GetKey("Pages"));
+    if (pagesObj != nullptr && pagesObj->TryGetDictionary(dict))
+    {
+        auto countObj = reader.Resolve(dict->GetKey("Count"));
+        if (countObj != nullptr && countObj->TryGetNumber(num) && num >= 0)
+            m_PageCount = (unsigned)num;
+    }
+
+    auto acroFormObj = reader.Resolve(catalog->GetKey("AcroForm"));
+    if (acroFormObj == nullptr || !acroFormObj->TryGetDictionary(dict))
+        return;
+
+    auto sigFlagsObj = reader.Resolve(dict->GetKey("SigFlags"));
+    if (sigFlagsObj != nullptr && sigFlagsObj->TryGetNumber(num))
+        m_SigFlags = (PdfAcroFormSigFlags)num;
+
+    if ((m_SigFlags & PdfAcroFormSigFlags::SignaturesExist) != PdfAcroFormSigFlags::None)
+    {
+        m_HasSignatures = true;
+        return;
+    }
+
+    // /SigFlags may be missing even if the document is signed:
+    // look for a signed field among the top level ones
+    auto fieldsObj = reader.Resolve(dict->GetKey("Fields"));
+    const PdfArray* fields;
+    if (fieldsObj == nullptr || !fieldsObj->TryGetArray(fields))
+        return;
+
+    for (auto& fieldRef : *fields)
+    {
+        auto fieldObj = reader.Resolve(&fieldRef);
+        const PdfDictionary* field;
+        if (fieldObj == nullptr || !fieldObj->TryGetDictionary(field))
+            continue;
+
+        auto typeObj = reader.Resolve(field->GetKey("FT"));
+        auto valueObj = field->GetKey("V");
+        if (typeObj != nullptr && typeObj->IsName() && typeObj->GetName() == "Sig"
+            && valueObj != nullptr && !valueObj->IsNull())
+        {
+            m_HasSignatures = true;
+            return;
+        }
+    }
+}
+
+void PdfDocumentProbe::reset()
+{
+    m_PdfVersion = PdfVersion::Unknown;
+    m_PageCount = 0;
+    m_Encrypted = false;
+    m_IncrementalUpdateCount = 0;
+    m_HasXRefStream = false;
+    m_HasSignatures = false;
+    m_HasDSS = false;
+    m_SigFlags = PdfAcroFormSigFlags::None;
+}
+
+PdfDocumentProbe::ObjectReader::ObjectReader(InputStreamDevice& device, PdfXRefEntries& entries, bool encrypted) :
+    m_device(&device),
+    m_entries(&entries),
+    m_encrypted(encrypted),
+    m_buffer(std::make_shared<charbuff>(PdfTokenizer::BufferSize)),
+    m_readCount(0)
+{
+}
+
+const PdfObject* PdfDocumentProbe::ObjectReader::Resolve(const PdfObject* obj)
+{
+    PdfReference ref;
+    if (obj == nullptr || !obj->TryGetReference(ref))
+        return obj;
+
+    return readObject(ref);
+}
+
+PdfObject* PdfDocumentProbe::ObjectReader::readObject(const PdfReference& ref)
+{
+    auto found = m_objects.find(ref.ObjectNumber());
+    if (found != m_objects.end())
+        return found->second.get();
+
+    if (ref.ObjectNumber() >= m_entries->GetSize()
+        || m_readCount == PdfDocumentProbe::MaxObjectCount)
+    {
+        return nullptr;
+    }
+
+    auto& entry = (*m_entries)[ref.ObjectNumber()];
+    if (!entry.Parsed)
+        return nullptr;
+
+    m_readCount++;
+    unique_ptr<PdfObject> obj;
+    switch (entry.Type)
+    {
+        case PdfXRefEntryType::InUse:
+        {
+            unique_ptr<PdfParserObject> parserObj(new PdfParserObject(*m_device, ref, (ssize_t)entry.Offset));
+            parserObj->Parse();
+            obj = std::move(parserObj);
+            break;
+        }
+        case PdfXRefEntryType::Compressed:
+        {
+            // The object stream can't be decoded without decrypting it
+            if (m_encrypted)
+                return nullptr;
+
+            auto decoded = getObjectStream((uint32_t)entry.ObjectNumber);
+            if (decoded == nullptr || entry.Index >= decoded->Objects.size())
+                return nullptr;
+
+            PdfVariant var;
+            PdfObjectStreamParser::ReadObject(*decoded, decoded->Objects[entry.Index].second, var, m_buffer);
+            obj.reset(new PdfObject(std::move(var)));
+            break;
+        }
+        default:
+            return nullptr;
+    }
+
+    auto ret = obj.get();
+    m_objects[ref.ObjectNumber()] = std::move(obj);
+    return ret;
+}
+
+const PdfDecodedObjectStream* PdfDocumentProbe::ObjectReader::getObjectStream(uint32_t objectNum)
+{
+    auto found = m_streams.find(objectNum);
+    if (found != m_streams.end())
+        return &found->second;
+
+    // The generation number of object streams is always 0
+    auto streamObj = dynamic_cast<PdfParserObject*>(readObject(PdfReference(objectNum, 0)));
+    if (streamObj == nullptr)
+        return nullptr;
+
+    // The stream can't resolve an indirect /Length by itself
+    auto& streamDict = streamObj->GetDictionary();
+    auto lengthObj = streamDict.GetKey("Length");
+    if (lengthObj != nullptr && lengthObj->IsReference())
+    {
+        int64_t length;
+        auto resolvedObj = Resolve(lengthObj);
+        if (resolvedObj == nullptr || !resolvedObj->TryGetNumber(length))
+            return nullptr;
+
+        streamDict.AddKey("Length"_n, length);
+    }
+
+    streamObj->ParseStream();
+    PdfDecodedObjectStream decoded;
+    PdfObjectStreamParser::Decode(*streamObj, decoded, m_buffer);
+    return &(m_streams[objectNum] = std::move(decoded));
+}
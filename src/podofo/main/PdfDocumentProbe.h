@@ -0,0 +1,106 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#ifndef PDF_DOCUMENT_PROBE_H
+#define PDF_DOCUMENT_PROBE_H
+
+#include <podofo/auxiliary/InputDevice.h>
+
+#include "PdfAcroForm.h"
+
+namespace PoDoFo {
+
+/** Retrieve quickly the main characteristics of a document, without loading it
+ *
+ *  Only the xref sections and the trailers are read, followed by a
+ *  bounded number of objects reachable from the catalog: the page tree
+ *  root, the AcroForm dictionary and its top level fields. Unlike
+ *  PdfMemDocument, no object is created for the other entries of the
+ *  xref, so it's suitable to triage many documents before deciding
+ *  how to process them.
+ *
+ *  Documents with a broken xref structure are not reconstructed and
+ *  an exception is thrown instead. The objects of encrypted documents
+ *  are not decrypted, so the characteristics that require reading
+ *  compressed objects are not available for them.
+ */
+class PODOFO_API PdfDocumentProbe final
+{
+public:
+    /** Maximum number of objects read when probing a document
+     */
+    static constexpr unsigned MaxObjectCount = 64;
+
+public:
+    PdfDocumentProbe();
+
+    /** Probe the document at the given path
+     */
+    void Probe(const std::string_view& filename);
+
+    /** Probe the document in the given buffer
+     */
+    void ProbeFromBuffer(const bufferview& buffer);
+
+    /** Probe the document read from the given device
+     */
+    void Probe(InputStreamDevice& device);
+
+public:
+    /** \returns the version of the document, from the header
+     *      or the /Version key of the catalog
+     */
+    inline PdfVersion GetPdfVersion() const { return m_PdfVersion; }
+
+    /** \returns the /Count of the page tree root, or 0
+     *      if the page tree couldn't be read
+     */
+    inline unsigned GetPageCount() const { return m_PageCount; }
+
+    /** \returns true if the trailer has an /Encrypt entry
+     */
+    inline bool IsEncrypted() const { return m_Encrypted; }
+
+    /** \returns the number of incremental updates applied to the document
+     */
+    inline unsigned GetIncrementalUpdateCount() const { return m_IncrementalUpdateCount; }
+
+    /** \returns true if the last xref section is an xref stream
+     */
+    inline bool HasXRefStream() const { return m_HasXRefStream; }
+
+    /** \returns true if /SigFlags states that signatures exist,
+     *      or a top level form field has a signature value
+     */
+    inline bool HasSignatures() const { return m_HasSignatures; }
+
+    /** \returns true if the catalog has a /DSS document security store
+     */
+    inline bool HasDSS() const { return m_HasDSS; }
+
+    /** \returns the /SigFlags of the AcroForm dictionary, if any
+     */
+    inline PdfAcroFormSigFlags GetSigFlags() const { return m_SigFlags; }
+
+private:
+    class ObjectReader;
+
+    void reset();
+
+private:
+    PdfVersion m_PdfVersion;
+    unsigned m_PageCount;
+    bool m_Encrypted;
+    unsigned m_IncrementalUpdateCount;
+    bool m_HasXRefStream;
+    bool m_HasSignatures;
+    bool m_HasDSS;
+    PdfAcroFormSigFlags m_SigFlags;
+};
+
+};
+
+#endif // PDF_DOCUMENT_PROBE_H
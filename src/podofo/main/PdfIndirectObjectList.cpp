@@ -67,6 +67,7 @@ namespace
 
 PdfIndirectObjectList::PdfIndirectObjectList() :
     m_Document(nullptr),
+    m_size(0),
     m_ObjectCount(0),
     m_StreamFactory(nullptr)
 {
@@ -74,6 +75,7 @@ PdfIndirectObjectList::PdfIndirectObjectList() :
 
 PdfIndirectObjectList::PdfIndirectObjectList(PdfDocument& document) :
     m_Document(&document),
+    m_size(0),
     m_ObjectCount(0),
     m_StreamFactory(nullptr)
 {
@@ -81,18 +83,20 @@ PdfIndirectObjectList::PdfIndirectObjectList(PdfDocument& document) :
 
 PdfIndirectObjectList::PdfIndirectObjectList(PdfDocument& document, const PdfIndirectObjectList& rhs)  :
     m_Document(&document),
+    m_Objects(rhs.m_Objects.size()),
+    m_size(rhs.m_size),
     m_ObjectCount(rhs.m_ObjectCount),
     m_FreeObjects(rhs.m_FreeObjects),
     m_unavailableObjects(rhs.m_unavailableObjects),
     m_StreamFactory(nullptr)
 {
     // Copy all objects from source, resetting parent and indirect reference
-    for (auto obj : rhs.m_Objects)
+    for (auto obj : rhs)
     {
         auto newObj = new PdfObject(*obj);
         newObj->SetIndirectReference(obj->GetIndirectReference());
         newObj->SetDocument(&document);
-        m_Objects.insert(newObj);
+        m_Objects[obj->GetIndirectReference().ObjectNumber()] = newObj;
     }
 }
 
@@ -107,10 +111,12 @@ void PdfIndirectObjectList::Clear()
         delete obj;
 
     m_Objects.clear();
+    m_size = 0;
     m_ObjectCount = 0;
     m_FreeObjects.clear();
     m_unavailableObjects.clear();
     m_objectStreams.clear();
+    m_dirtyObjects.clear();
 }
 
 PdfObject& PdfIndirectObjectList::MustGetObject(const PdfReference& ref) const
@@ -124,11 +130,16 @@ PdfObject& PdfIndirectObjectList::MustGetObject(const PdfReference& ref) const
 
 PdfObject* PdfIndirectObjectList::GetObject(const PdfReference& ref) const
 {
-    auto it = m_Objects.lower_bound(ref);
-    if (it == m_Objects.end() || (*it)->GetIndirectReference() != ref)
+    uint32_t objectNum = ref.ObjectNumber();
+    if (objectNum >= m_Objects.size())
         return nullptr;
 
-    return *it;
+    // The slot may hold an object with a different generation
+    auto obj = m_Objects[objectNum];
+    if (obj == nullptr || obj->GetIndirectReference() != ref)
+        return nullptr;
+
+    return obj;
 }
 
 unique_ptr<PdfObject> PdfIndirectObjectList::RemoveObject(const PdfReference& ref)
@@ -138,11 +149,10 @@ unique_ptr<PdfObject> PdfIndirectObjectList::RemoveObject(const PdfReference& re
 
 unique_ptr<PdfObject> PdfIndirectObjectList::RemoveObject(const PdfReference& ref, bool markAsFree)
 {
-    auto it = m_Objects.lower_bound(ref);
-    if (it == m_Objects.end() || (*it)->GetIndirectReference() != ref)
+    if (GetObject(ref) == nullptr)
         return nullptr;
 
-    return removeObject(it, markAsFree);
+    return removeObject(iterator(m_Objects, ref.ObjectNumber()), markAsFree);
 }
 
 unique_ptr<PdfObject> PdfIndirectObjectList::RemoveObject(const iterator& it)
@@ -159,7 +169,8 @@ unique_ptr<PdfObject> PdfIndirectObjectList::removeObject(const iterator& it, bo
     if (markAsFree)
         SafeAddFreeObject(obj->GetIndirectReference());
 
-    m_Objects.erase(it);
+    m_Objects[it.m_index] = nullptr;
+    m_size--;
     return unique_ptr<PdfObject>(obj);
 }
 
@@ -287,6 +298,53 @@ void PdfIndirectObjectList::AddObjectStream(uint32_t objectNum)
     m_objectStreams.insert(objectNum);
 }
 
+bool PdfIndirectObjectList::IsObjectStream(uint32_t objectNum) const
+{
+    return m_objectStreams.find(objectNum) != m_objectStreams.end();
+}
+
+void PdfIndirectObjectList::GetDirtyObjects(vector<PdfObject*>& objects)
+{
+    // The same object number is tracked again if the
+    // object is set dirty after being written
+    std::sort(m_dirtyObjects.begin(), m_dirtyObjects.end());
+    m_dirtyObjects.erase(std::unique(m_dirtyObjects.begin(), m_dirtyObjects.end()), m_dirtyObjects.end());
+
+    objects.clear();
+    for (uint32_t objectNum : m_dirtyObjects)
+    {
+        if (objectNum >= m_Objects.size())
+            continue;
+
+        auto obj = m_Objects[objectNum];
+        if (obj != nullptr && obj->IsDirty())
+            objects.push_back(obj);
+    }
+}
+
+void PdfIndirectObjectList::ClearDirtyObjects()
+{
+    m_dirtyObjects.clear();
+}
+
+uint32_t PdfIndirectObjectList::GetLastObjectNumber() const
+{
+    size_t index = m_Objects.size();
+    while (index != 0)
+    {
+        index--;
+        if (m_Objects[index] != nullptr)
+            return (uint32_t)index;
+    }
+
+    return 0;
+}
+
+void PdfIndirectObjectList::addDirtyObject(uint32_t objectNum)
+{
+    m_dirtyObjects.push_back(objectNum);
+}
+
 void PdfIndirectObjectList::addNewObject(PdfObject* obj)
 {
     PdfReference ref = getNextFreeObject();
@@ -298,29 +356,28 @@ void PdfIndirectObjectList::PushObject(PdfObject* obj)
 {
     obj->SetDocument(m_Document);
 
-    ObjectList::node_type node;
-    auto it = m_Objects.find(obj);
-    auto hintpos = it;
-    if (it != m_Objects.end())
+    uint32_t objectNum = obj->GetIndirectReference().ObjectNumber();
+    if (objectNum >= m_Objects.size())
+        m_Objects.resize((size_t)objectNum + 1);
+
+    auto& slot = m_Objects[objectNum];
+    if (slot == nullptr)
     {
-        // Delete existing object and replace
-        // the pointer on its node
-        hintpos++;
-        node = m_Objects.extract(it);
-        delete node.value();
-        node.value() = obj;
+        m_size++;
     }
-
-    pushObject(hintpos, node, obj);
-}
-
-void PdfIndirectObjectList::pushObject(const ObjectList::const_iterator& hintpos, ObjectList::node_type& node, PdfObject* obj)
-{
-    if (node.empty())
-        m_Objects.insert(hintpos, obj);
     else
-        m_Objects.insert(hintpos, std::move(node));
+    {
+        // Delete the existing object and replace it. Only
+        // one generation of an object number can be in use
+        delete slot;
+    }
+
+    slot = obj;
     tryIncrementObjectCount(obj->GetIndirectReference());
+
+    // Objects are usually created dirty before being added
+    if (obj->IsDirty())
+        m_dirtyObjects.push_back(objectNum);
 }
 
 void PdfIndirectObjectList::CollectGarbage()
@@ -330,26 +387,21 @@ void PdfIndirectObjectList::CollectGarbage()
 
     unordered_set<PdfReference> referencedOjects;
     visitObject(m_Document->GetTrailer().GetObject(), referencedOjects);
-    vector<PdfObject*> objectsToDelete;
-    ObjectList newlist;
-    for (PdfObject* obj : m_Objects)
+    for (auto& obj : m_Objects)
     {
+        if (obj == nullptr)
+            continue;
+
         auto& ref = obj->GetIndirectReference();
         if (referencedOjects.find(ref) == referencedOjects.end()
             && m_objectStreams.find(ref.ObjectNumber()) == m_objectStreams.end())
         {
             SafeAddFreeObject(ref);
-            objectsToDelete.push_back(obj);
-            continue;
+            delete obj;
+            obj = nullptr;
+            m_size--;
         }
-
-        newlist.insert(obj);
     }
-
-    for (auto obj : objectsToDelete)
-        delete obj;
-
-    m_Objects.swap(newlist);
 }
 
 void PdfIndirectObjectList::visitObject(const PdfObject& obj, unordered_set<PdfReference>& referencedObjects)
@@ -440,7 +492,7 @@ void PdfIndirectObjectList::EndAppendStream(PdfObjectStream& stream)
 
 unsigned PdfIndirectObjectList::GetSize() const
 {
-    return (unsigned)m_Objects.size();
+    return m_size;
 }
 
 void PdfIndirectObjectList::AttachObserver(Observer& observer)
@@ -465,25 +517,29 @@ void PdfIndirectObjectList::tryIncrementObjectCount(const PdfReference& ref)
 
 PdfIndirectObjectList::iterator PdfIndirectObjectList::begin() const
 {
-    return m_Objects.begin();
+    size_t index = 0;
+    while (index < m_Objects.size() && m_Objects[index] == nullptr)
+        index++;
+
+    return iterator(m_Objects, index);
 }
 
 PdfIndirectObjectList::iterator PdfIndirectObjectList::end() const
 {
-    return m_Objects.end();
+    return iterator(m_Objects, m_Objects.size());
 }
 
 PdfIndirectObjectList::reverse_iterator PdfIndirectObjectList::rbegin() const
 {
-    return m_Objects.rbegin();
+    return reverse_iterator(end());
 }
 
 PdfIndirectObjectList::reverse_iterator PdfIndirectObjectList::rend() const
 {
-    return m_Objects.rend();
+    return reverse_iterator(begin());
 }
 
 size_t PdfIndirectObjectList::size() const
 {
-    return m_Objects.size();
+    return m_size;
 }
@@ -29,6 +29,7 @@ using PdfFreeObjectList = std::deque<PdfReference>;
 class PODOFO_API PdfIndirectObjectList final
 {
     friend class PdfDocument;
+    friend class PdfDocumentProbe;
     friend class PdfObject;
     friend class PdfObjectOutputStream;
     PODOFO_PRIVATE_FRIEND(class PdfObjectStreamParser);
@@ -154,15 +155,84 @@ private:
     using ObjectNumSet = std::set<uint32_t>;
     using ReferenceSet = std::set<PdfReference>;
     using ObserverList = std::vector<Observer*>;
-    using ObjectList = std::set<PdfObject*, PdfObjectInequality>;
+    // Objects are indexed by object number, with empty slots
+    // for the object numbers that are not in use
+    using ObjectList = std::vector<PdfObject*>;
 
 public:
+    /** Iterates the objects ordered by object number, skipping
+     *  the object numbers that are not in use
+     *  \remarks The iterator stays valid when objects are added or
+     *      removed, except for the removed object itself
+     */
+    class PODOFO_API Iterator final
+    {
+        friend class PdfIndirectObjectList;
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = PdfObject*;
+        using pointer = PdfObject* const*;
+        using reference = PdfObject* const&;
+        using iterator_category = std::bidirectional_iterator_tag;
+    public:
+        Iterator() : m_objects(nullptr), m_index(0) { }
+    private:
+        Iterator(const ObjectList& objects, size_t index)
+            : m_objects(&objects), m_index(index) { }
+    public:
+        Iterator(const Iterator&) = default;
+        Iterator& operator=(const Iterator&) = default;
+        bool operator==(const Iterator& rhs) const
+        {
+            return m_index == rhs.m_index;
+        }
+        bool operator!=(const Iterator& rhs) const
+        {
+            return m_index != rhs.m_index;
+        }
+        Iterator& operator++()
+        {
+            do
+            {
+                m_index++;
+            } while (m_index < m_objects->size() && (*m_objects)[m_index] == nullptr);
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+        Iterator& operator--()
+        {
+            do
+            {
+                m_index--;
+            } while (m_index != 0 && (*m_objects)[m_index] == nullptr);
+            return *this;
+        }
+        Iterator operator--(int)
+        {
+            auto copy = *this;
+            --(*this);
+            return copy;
+        }
+        reference operator*() const
+        {
+            return (*m_objects)[m_index];
+        }
+        pointer operator->() const
+        {
+            return &(*m_objects)[m_index];
+        }
+    private:
+        const ObjectList* m_objects;
+        size_t m_index;
+    };
 
-    // An incomplete set of container typedefs, just enough to handle
-    // the begin() and end() methods we wrap from the internal vector.
-    // TODO: proper wrapper iterator class.
-    using iterator = ObjectList::const_iterator;
-    using reverse_iterator = ObjectList::const_reverse_iterator;
+    using iterator = Iterator;
+    using reverse_iterator = std::reverse_iterator<Iterator>;
 
     /** Iterator pointing at the beginning of the vector
      *  \returns beginning iterator
@@ -248,9 +318,9 @@ private:
      */
     void EndAppendStream(PdfObjectStream& stream);
 
-    /** Insert an object into this vector so that
-     *  the vector remains sorted w.r.t.
-     *  the ordering based on object and generation numbers
+    /** Insert an object into this vector at the slot of its
+     *  object number, replacing and deleting any object with the
+     *  same object number, regardless of the generation.
      *  m_ObjectCount will be increased for the object.
      *
      *  \param obj pointer to the object you want to insert
@@ -293,6 +363,27 @@ private:
      */
     void AddObjectStream(uint32_t objectNum);
 
+    /** \returns true if the object number was added as an object stream
+     */
+    bool IsObjectStream(uint32_t objectNum) const;
+
+    /** Get the objects that are still dirty among the ones set
+     *  dirty since the tracked object numbers were last cleared,
+     *  sorted by object number
+     *  \remarks The object numbers stay tracked until ClearDirtyObjects()
+     *      is called, so the objects are not lost if writing them fails
+     */
+    void GetDirtyObjects(std::vector<PdfObject*>& objects);
+
+    /** Clear the tracked object numbers, after all
+     *  objects have been written
+     */
+    void ClearDirtyObjects();
+
+    /** \returns the highest number of the objects in the list, or 0 if it's empty
+     */
+    uint32_t GetLastObjectNumber() const;
+
     std::unique_ptr<PdfObject> RemoveObject(const PdfReference& ref, bool markAsFree);
 
     /** Sets a StreamFactory which is used whenever CreateStream is called.
@@ -302,8 +393,6 @@ private:
     void SetStreamFactory(StreamFactory* factory);
 
 private:
-    void pushObject(const ObjectList::const_iterator& hintpos, ObjectList::node_type& node, PdfObject* obj);
-
     std::unique_ptr<PdfObject> removeObject(const iterator& it, bool markAsFree);
 
     void addNewObject(PdfObject* obj);
@@ -325,13 +414,21 @@ private:
      */
     void tryIncrementObjectCount(const PdfReference& ref);
 
+    /** Track the object number of an object of the list that has just
+     *  been set dirty, so the dirty objects can be retrieved without
+     *  scanning the whole list
+     */
+    void addDirtyObject(uint32_t objectNum);
+
 private:
     PdfDocument* m_Document;
     ObjectList m_Objects;
+    unsigned m_size;                 ///< Number of objects in m_Objects
     unsigned m_ObjectCount;
     PdfFreeObjectList m_FreeObjects;
     ObjectNumSet m_unavailableObjects;
     ObjectNumSet m_objectStreams;
+    std::vector<uint32_t> m_dirtyObjects;   ///< May have duplicates and objects no longer dirty
 
     ObserverList m_observers;
     StreamFactory* m_StreamFactory;
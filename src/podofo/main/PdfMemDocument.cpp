@@ -24,6 +24,9 @@ PdfMemDocument::PdfMemDocument(bool empty) :
     m_Version(PdfVersionDefault),
     m_InitialVersion(PdfVersionDefault),
     m_HasXRefStream(false),
+    m_ObjectStreamSize(PdfWriter::DefaultObjectStreamSize),
+    m_SaveThreadCount(1),
+    m_LoadThreadCount(1),
     m_PrevXRefOffset(-1)
 {
 }
@@ -42,6 +45,9 @@ PdfMemDocument::PdfMemDocument(const PdfMemDocument& rhs) :
     m_Version(rhs.m_Version),
     m_InitialVersion(rhs.m_InitialVersion),
     m_HasXRefStream(rhs.m_HasXRefStream),
+    m_ObjectStreamSize(rhs.m_ObjectStreamSize),
+    m_SaveThreadCount(rhs.m_SaveThreadCount),
+    m_LoadThreadCount(rhs.m_LoadThreadCount),
     m_PrevXRefOffset(rhs.m_PrevXRefOffset)
 {
     // Do a full copy of the encrypt session
@@ -92,7 +98,13 @@ void PdfMemDocument::Load(const string_view& filename, const string_view& passwo
     if (filename.length() == 0)
         PODOFO_RAISE_ERROR(PdfErrorCode::InvalidHandle);
 
-    auto device = std::make_shared<FileStreamDevice>(filename);
+    // Parallel loading parses the objects from a memory view of the input
+    shared_ptr<InputStreamDevice> device;
+    if (m_LoadThreadCount == 1)
+        device = std::make_shared<FileStreamDevice>(filename);
+    else
+        device = std::make_shared<MappedFileStreamDevice>(filename);
+
     Load(device, password);
 }
 
@@ -114,15 +126,25 @@ void PdfMemDocument::Load(shared_ptr<InputStreamDevice> device, const string_vie
     loadFromDevice(std::move(device), password);
 }
 
+void PdfMemDocument::SetMemoryResource(shared_ptr<pmr::memory_resource> resource)
+{
+    m_LoadMemoryResource = std::move(resource);
+}
+
 void PdfMemDocument::loadFromDevice(shared_ptr<InputStreamDevice>&& device, const string_view& password)
 {
     m_device = std::move(device);
 
+    // NOTE: The document is empty here, so no
+    // object was allocated from the previous resource
+    PdfDocument::m_MemoryResource = m_LoadMemoryResource;
+
     // Call parse file instead of using the constructor
     // so that m_Parser is initialized for encrypted documents
     PdfParser parser(PdfDocument::GetObjects());
     parser.SetPassword(password);
-    parser.Parse(*m_device, true);
+    parser.SetLoadThreadCount(m_LoadThreadCount);
+    parser.Parse(*m_device, m_LoadThreadCount == 1);
     initFromParser(parser);
 }
 
@@ -140,6 +162,8 @@ void PdfMemDocument::Save(OutputStreamDevice& device, PdfSaveOptions opts)
     writer.SetPdfVersion(GetMetadata().GetPdfVersion());
     writer.SetPdfALevel(GetMetadata().GetPdfALevel());
     writer.SetSaveOptions(opts);
+    writer.SetObjectStreamSize(m_ObjectStreamSize);
+    writer.SetSaveThreadCount(m_SaveThreadCount);
 
     if (m_Encrypt != nullptr)
         writer.SetEncrypt(*m_Encrypt);
@@ -153,6 +177,10 @@ void PdfMemDocument::Save(OutputStreamDevice& device, PdfSaveOptions opts)
         PODOFO_PUSH_FRAME(e);
         throw;
     }
+
+    // Updates appended to the same device must refer to this revision
+    m_PrevXRefOffset = writer.GetXRefOffset();
+    m_HasXRefStream = writer.GetUseXRefStream();
 }
 
 void PdfMemDocument::SaveUpdate(const string_view& filename, PdfSaveOptions opts)
@@ -172,6 +200,7 @@ void PdfMemDocument::SaveUpdate(OutputStreamDevice& device, PdfSaveOptions opts)
     writer.SetPrevXRefOffset(m_PrevXRefOffset);
     writer.SetUseXRefStream(m_HasXRefStream);
     writer.SetIncrementalUpdate(false);
+    writer.SetSaveThreadCount(m_SaveThreadCount);
 
     if (m_Encrypt != nullptr)
         writer.SetEncrypt(*m_Encrypt);
@@ -194,6 +223,11 @@ void PdfMemDocument::SaveUpdate(OutputStreamDevice& device, PdfSaveOptions opts)
         PODOFO_PUSH_FRAME(e);
         throw;
     }
+
+    // The written objects are not dirty anymore, so the document
+    // can be further updated on the same device without reloading
+    // it, as long as the next update refers to this revision
+    m_PrevXRefOffset = writer.GetXRefOffset();
 }
 
 void PdfMemDocument::beforeWrite(PdfSaveOptions opts)
@@ -231,6 +265,14 @@ void PdfMemDocument::SetEncrypt(unique_ptr<PdfEncrypt>&& encrypt)
         m_Encrypt.reset(new PdfEncryptSession(std::move(encrypt)));
 }
 
+void PdfMemDocument::SetObjectStreamSize(unsigned size)
+{
+    if (size == 0 || size > numeric_limits<uint16_t>::max())
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::ValueOutOfRange, "The object stream size must be between 1 and 65535");
+
+    m_ObjectStreamSize = size;
+}
+
 const PdfEncrypt* PdfMemDocument::GetEncrypt() const
 {
     if (m_Encrypt == nullptr)
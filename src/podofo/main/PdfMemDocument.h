@@ -37,6 +37,7 @@ class PdfEncryptSession;
 class PODOFO_API PdfMemDocument final : public PdfDocument
 {
     PODOFO_PRIVATE_FRIEND(class PdfWriter);
+    PODOFO_PRIVATE_FRIEND(class PdfDocumentTest);
 
 public:
     /** Construct a new PdfMemDocument
@@ -76,6 +77,23 @@ public:
      */
     void Load(std::shared_ptr<InputStreamDevice> device, const std::string_view& password = { });
 
+    /** Set a memory resource, such as a std::pmr::monotonic_buffer_resource,
+     *  the entries of the dictionaries and arrays parsed by the following
+     *  loads are allocated from
+     *
+     *  \param resource the memory resource, or nullptr to use the default heap
+     *
+     *  The resource is shared by the document with the loaded objects and it's
+     *  released only after all of them are destroyed, when the document is
+     *  cleared, reloaded or destroyed. Using a new monotonic resource for each
+     *  load makes tearing down the document a single release of its memory.
+     *  \remarks Copies of the parsed dictionaries and arrays use the default heap,
+     *      while the moved ones keep allocating from the resource: they must not
+     *      outlive the document
+     *  \see PdfDocument::GetMemoryResource
+     */
+    void SetMemoryResource(std::shared_ptr<std::pmr::memory_resource> resource);
+
     /** Save the complete document to a file
      *
      *  \param filename filename of the document
@@ -122,6 +140,10 @@ public:
      *  The document should be loaded with bForUpdate = true, otherwise
      *  an exception is thrown.
      *
+     *  Further changes can be saved as successive incremental updates
+     *  by calling SaveUpdate again on the same device, without reloading
+     *  the document
+     *
      *  \see Save, SaveUpdate
      */
     void SaveUpdate(OutputStreamDevice& device, PdfSaveOptions opts = PdfSaveOptions::None);
@@ -152,6 +174,47 @@ public:
 
     const PdfEncrypt* GetEncrypt() const override;
 
+    /** Set the maximum number of objects packed in each object
+     *  stream, when saving with PdfSaveOptions::UseObjectStreams
+     *
+     *  \param size the number of objects, from 1 to 65535. Larger
+     *      object streams compress better, but readers must decode
+     *      a whole stream to access any object in it
+     */
+    void SetObjectStreamSize(unsigned size);
+
+    inline unsigned GetObjectStreamSize() const { return m_ObjectStreamSize; }
+
+    /** Set the number of threads used to flate compress the
+     *  streams when saving the document
+     *
+     *  \param count the number of threads. Default is 1, which
+     *      compresses the streams while writing them. If 0,
+     *      std::thread::hardware_concurrency() is used
+     */
+    inline void SetSaveThreadCount(unsigned count) { m_SaveThreadCount = count; }
+
+    inline unsigned GetSaveThreadCount() const { return m_SaveThreadCount; }
+
+    /** Set the number of threads used to parse the objects
+     *  when loading the document
+     *
+     *  \param count the number of threads. Default is 1, which
+     *      loads the objects on demand. Otherwise all the objects are
+     *      parsed at load on the given number of threads. If 0,
+     *      std::thread::hardware_concurrency() is used
+     *  \remarks the objects are parsed in parallel from a memory view
+     *      of the input, so Load(filename) maps the file when the count
+     *      is not 1. Loading from a device without a view, as a
+     *      FileStreamDevice, parses all the objects sequentially
+     *  \remarks the memory resource set with SetMemoryResource(), if
+     *      any, must be thread safe to load on more than one thread
+     *  \see PdfParser::SetLoadThreadCount
+     */
+    inline void SetLoadThreadCount(unsigned count) { m_LoadThreadCount = count; }
+
+    inline unsigned GetLoadThreadCount() const { return m_LoadThreadCount; }
+
 protected:
     /** Set the PDF Version of the document. Has to be called before Write() to
      *  have an effect.
@@ -188,9 +251,13 @@ private:
     PdfVersion m_Version;
     PdfVersion m_InitialVersion;
     bool m_HasXRefStream;
+    unsigned m_ObjectStreamSize;
+    unsigned m_SaveThreadCount;
+    unsigned m_LoadThreadCount;
     int64_t m_PrevXRefOffset;
     std::unique_ptr<PdfEncryptSession> m_Encrypt;
     std::shared_ptr<InputStreamDevice> m_device;
+    std::shared_ptr<std::pmr::memory_resource> m_LoadMemoryResource;
 };
 
 };
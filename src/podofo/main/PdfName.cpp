@@ -8,6 +8,7 @@
 #include "PdfName.h"
 
 #include <podofo/private/PdfEncodingPrivate.h>
+#include <podofo/private/PdfKnownNames.h>
 
 #include <podofo/auxiliary/OutputDevice.h>
 #include "PdfTokenizer.h"
@@ -121,6 +122,15 @@ void PdfName::initFromUtf8String(const string_view& view)
         return;
     }
 
+    string_view known;
+    if (TryGetKnownName(view, known))
+    {
+        // Well known names are ASCII: share the static storage
+        new(&m_Utf8View)string_view(known);
+        m_dataAllocated = false;
+        return;
+    }
+
     bool isAsciiEqual;
     if (!PoDoFo::CheckValidUTF8ToPdfDocEcondingChars(view, isAsciiEqual))
         PODOFO_RAISE_ERROR_INFO(PdfErrorCode::InvalidName, "Characters in string must be PdfDocEncoding character set");
@@ -148,26 +158,22 @@ void PdfName::moveFrom(PdfName&& rhs)
 
 PdfName PdfName::FromEscaped(const string_view& view)
 {
-    // Slightly optimize memory usage by checking
-    // against some well known values
-    if (view == "Filter"sv)
-        return "Filter"_n;
-    else if (view == "Length"sv)
-        return "Length"_n;
-    else if (view == "FlateDecode"sv)
-        return "FlateDecode"_n;
-    else if (view == "Type"sv)
-        return "Type"_n;
-    else if (view == "Subtype"sv)
-        return "Subtype"_n;
-    else if (view == "Parent"sv)
-        return "Parent"_n;
+    // Optimize memory usage by sharing the storage
+    // of well known names, which are the majority
+    // of the names read from documents
+    string_view known;
+    if (view.find('#') == string_view::npos && TryGetKnownName(view, known))
+        return PdfName(*known.data(), known.size());
     else
         return PdfName(unescapeName(view));
 }
 
 PdfName PdfName::FromRaw(const bufferview& rawcontent)
 {
+    string_view known;
+    if (TryGetKnownName(string_view(rawcontent.data(), rawcontent.size()), known))
+        return PdfName(*known.data(), known.size());
+
     return PdfName((charbuff)rawcontent);
 }
 
@@ -333,12 +339,19 @@ string_view PdfName::GetRawData() const
 
 bool PdfName::operator==(const PdfName& rhs) const
 {
-    return this->GetRawData() == rhs.GetRawData();
+    auto lhsData = this->GetRawData();
+    auto rhsData = rhs.GetRawData();
+    // Names sharing the same storage, such as
+    // well known names, compare by identity
+    if (lhsData.data() == rhsData.data())
+        return lhsData.size() == rhsData.size();
+
+    return lhsData == rhsData;
 }
 
 bool PdfName::operator!=(const PdfName& rhs) const
 {
-    return this->GetRawData() != rhs.GetRawData();
+    return !operator==(rhs);
 }
 
 bool PdfName::operator==(const char* str) const
@@ -18,6 +18,9 @@ namespace PoDoFo {
  *
  *  PdfName may have a maximum length of 127 characters.
  *
+ *  Well known names, such as the ones in PdfNames, share a static storage
+ *  without allocating memory, and they compare equal by identity.
+ *
  *  \see PdfObject \see PdfVariant
  */
 class PODOFO_API PdfName final : private PdfDataMember, public PdfDataProvider<PdfName>
@@ -237,6 +237,44 @@ void PdfObject::WriteFinal(OutputStream& stream, PdfWriteFlags writeMode, const
     ResetDirty();
 }
 
+void PdfObject::WriteFinalFlateEncoded(OutputStream& stream, PdfWriteFlags writeMode,
+    const PdfStatefulEncrypt* encrypt, const bufferview& encoded, charbuff& buffer)
+{
+    // Write a copy of the dictionary with the keys of the encoded data
+    PdfDictionary dict(m_Variant.GetDictionaryUnsafe());
+    dict.AddKey("Filter"_n, "FlateDecode"_n);
+    dict.RemoveKey("DecodeParms");
+    size_t length = encoded.size();
+    if (encrypt != nullptr)
+        length = encrypt->CalculateStreamLength(length);
+
+    dict.AddKey("Length"_n, static_cast<int64_t>(length));
+
+    if (m_IndirectReference.IsIndirect())
+        WriteHeader(stream, writeMode, buffer);
+
+    dict.Write(stream, writeMode, encrypt, buffer);
+    stream.Write('\n');
+    stream.Write("stream\n");
+    if (encrypt == nullptr)
+    {
+        stream.Write(encoded.data(), encoded.size());
+    }
+    else
+    {
+        charbuff encrypted;
+        encrypt->EncryptTo(encrypted, encoded);
+        stream.Write(encrypted);
+    }
+    stream.Write("\nendstream\n");
+
+    if (m_IndirectReference.IsIndirect())
+        stream.Write("endobj\n");
+
+    // After writing we can reset the dirty flag
+    ResetDirty();
+}
+
 void PdfObject::write(OutputStream& stream, bool skipLengthFix,
     PdfWriteFlags writeMode, const PdfStatefulEncrypt* encrypt, charbuff& buffer) const
 {
@@ -245,15 +283,7 @@ void PdfObject::write(OutputStream& stream, bool skipLengthFix,
 
     if (m_Stream != nullptr)
     {
-        // Try to compress the flate compress the stream if it has no filters,
-        // the compression is not disabled and it's not the /MetaData object,
-        // which must be unfiltered as per PDF/A
-        const PdfObject* metadataObj;
-        if ((writeMode & PdfWriteFlags::NoFlateCompress) == PdfWriteFlags::None
-            && m_Stream->GetFilters().size() == 0
-            && (m_Document == nullptr 
-                || (metadataObj = m_Document->GetCatalog().GetMetadataObject()) == nullptr
-                || m_IndirectReference != metadataObj->GetIndirectReference()))
+        if (canFlateCompressStream(writeMode))
         {
             PdfObject object;
             auto& objStream = object.GetOrCreateStream();
@@ -289,6 +319,20 @@ void PdfObject::write(OutputStream& stream, bool skipLengthFix,
         stream.Write("endobj\n");
 }
 
+bool PdfObject::canFlateCompressStream(PdfWriteFlags writeMode) const
+{
+    // Try to compress the flate compress the stream if it has no filters,
+    // the compression is not disabled and it's not the /MetaData object,
+    // which must be unfiltered as per PDF/A
+    const PdfObject* metadataObj;
+    return m_Stream != nullptr
+        && (writeMode & PdfWriteFlags::NoFlateCompress) == PdfWriteFlags::None
+        && m_Stream->GetFilters().size() == 0
+        && (m_Document == nullptr
+            || (metadataObj = m_Document->GetCatalog().GetMetadataObject()) == nullptr
+            || m_IndirectReference != metadataObj->GetIndirectReference());
+}
+
 void PdfObject::WriteHeader(OutputStream& stream, PdfWriteFlags writeMode, charbuff& buffer) const
 {
     if ((writeMode & PdfWriteFlags::Clean) != PdfWriteFlags::None
@@ -579,6 +623,13 @@ void PdfObject::SetDirty()
 
 void PdfObject::setDirty()
 {
+    if (!m_IsDirty && m_Document != nullptr && IsIndirect())
+        m_Document->GetObjects().addDirtyObject(m_IndirectReference.ObjectNumber());
+
+    // Changes to the dictionary may change the decoded data
+    if (m_Stream != nullptr)
+        m_Stream->removeCachedCopy();
+
     m_IsDirty = true;
     SetRevised();
 }
@@ -47,6 +47,7 @@ class PODOFO_API PdfObject
     PODOFO_PRIVATE_FRIEND(class PdfObjectStreamParser);
     PODOFO_PRIVATE_FRIEND(class PdfParser);
     PODOFO_PRIVATE_FRIEND(class PdfParserObject);
+    PODOFO_PRIVATE_FRIEND(class PdfCompressedObject);
     PODOFO_PRIVATE_FRIEND(class PdfWriter);
     PODOFO_PRIVATE_FRIEND(class PdfImmediateWriter);
     PODOFO_PRIVATE_FRIEND(class PdfXRef);
@@ -544,6 +545,11 @@ private:
     void WriteFinal(OutputStream& stream, PdfWriteFlags writeMode,
         const PdfStatefulEncrypt* encrypt, charbuff& buffer);
 
+    // To be called by PdfWriter. Write the object with the given flate
+    // encoded data in place of the data of the stream, without modifying it
+    void WriteFinalFlateEncoded(OutputStream& stream, PdfWriteFlags writeMode,
+        const PdfStatefulEncrypt* encrypt, const bufferview& encoded, charbuff& buffer);
+
     // To be called by PdfStreamedObjectStream
     void SetNumberNoDirtySet(int64_t l);
 
@@ -551,6 +557,9 @@ private:
     void SetImmutable();
     void WriteHeader(OutputStream& stream, PdfWriteFlags writeMode, charbuff& buffer) const;
 
+    // To be called by PdfWriter. The stream must be already loaded
+    bool canFlateCompressStream(PdfWriteFlags writeMode) const;
+
     // To be called by PdfDataContainer
     bool IsImmutable() const { return m_IsImmutable; }
 
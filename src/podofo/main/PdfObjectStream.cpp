@@ -12,17 +12,62 @@
 #include <podofo/auxiliary/StreamDevice.h>
 
 #include <podofo/private/PdfFilterFactory.h>
+#include "PdfMemoryObjectStream.h"
+#include <podofo/private/PdfDecodedStreamCache.h>
+
+#include <atomic>
 
 using namespace std;
 using namespace PoDoFo;
 
 constexpr PdfFilterType DefaultFilter = PdfFilterType::FlateDecode;
 
+// Source of the keys of the streams in the decoded stream caches
+static atomic<uint64_t> s_CacheKey;
+
 static bool isMediaFilter(PdfFilterType filterType);
 static PdfFilterList stripMediaFilters(const PdfFilterList& filters, PdfFilterList& mediaFilters);
 
+namespace
+{
+    // Write to the given stream, keeping a copy of the data
+    // written as long as it doesn't exceed the given size
+    class CachingOutputStream final : public OutputStream
+    {
+    public:
+        CachingOutputStream(OutputStream& stream, size_t maxSize)
+            : m_stream(&stream), m_maxSize(maxSize), m_data(std::make_shared<charbuff>()) { }
+
+        // Returns the copy of the data, or nullptr if it exceeded the size
+        shared_ptr<charbuff> TakeData() { return std::move(m_data); }
+
+    protected:
+        void writeBuffer(const char* buffer, size_t size) override
+        {
+            m_stream->Write(buffer, size);
+            if (m_data == nullptr)
+                return;
+
+            if (m_data->size() + size > m_maxSize)
+                m_data.reset();
+            else
+                m_data->append(buffer, size);
+        }
+
+        void flush() override
+        {
+            m_stream->Flush();
+        }
+
+    private:
+        OutputStream* m_stream;
+        size_t m_maxSize;
+        shared_ptr<charbuff> m_data;
+    };
+}
+
 PdfObjectStream::PdfObjectStream(PdfObject& parent, std::unique_ptr<PdfObjectStreamProvider>&& provider)
-    : m_Parent(&parent), m_Provider(std::move(provider)), m_locked(false)
+    : m_Parent(&parent), m_Provider(std::move(provider)), m_CacheKey(s_CacheKey++), m_locked(false)
 {
     m_Provider->Init(parent);
 }
@@ -62,54 +107,190 @@ PdfObjectInputStream PdfObjectStream::GetInputStream(bool raw) const
 void PdfObjectStream::CopyTo(charbuff& buffer, bool raw) const
 {
     buffer.clear();
+    if (!raw)
+    {
+        auto cached = getCachedCopy();
+        if (cached != nullptr)
+        {
+            buffer = *cached;
+            return;
+        }
+
+        if (tryDecodeTo(buffer))
+            return;
+    }
+
     BufferStreamDevice stream(buffer);
-    CopyTo(stream, raw);
+    copyTo(stream, raw, false);
 }
 
 void PdfObjectStream::CopyToSafe(charbuff& buffer) const
 {
     buffer.clear();
+    auto cached = getCachedCopy();
+    if (cached != nullptr)
+    {
+        buffer = *cached;
+        return;
+    }
+
+    if (tryDecodeTo(buffer))
+        return;
+
     BufferStreamDevice stream(buffer);
-    CopyToSafe(stream);
+    copyTo(stream, false, true);
 }
 
 void PdfObjectStream::CopyTo(OutputStream& stream, bool raw) const
+{
+    if (!raw)
+    {
+        auto cache = getDecodedStreamCache();
+        if (cache != nullptr)
+        {
+            copyToCached(*cache, stream);
+            return;
+        }
+    }
+
+    copyTo(stream, raw, false);
+}
+
+void PdfObjectStream::CopyToSafe(OutputStream& stream) const
+{
+    auto cache = getDecodedStreamCache();
+    if (cache != nullptr)
+    {
+        copyToCached(*cache, stream);
+        return;
+    }
+
+    copyTo(stream, false, true);
+}
+
+void PdfObjectStream::copyTo(OutputStream& stream, bool raw, bool safe) const
 {
     PdfFilterList mediaFilters;
     vector<const PdfDictionary*> decodeParms;
     auto inputStream = const_cast<PdfObjectStream&>(*this).getInputStream(raw, mediaFilters, decodeParms);
-    if (mediaFilters.size() != 0)
+    if (!safe && mediaFilters.size() != 0)
         PODOFO_RAISE_ERROR_INFO(PdfErrorCode::UnsupportedFilter, "Unsupported expansion with media filters. Use GetInputStream(true) instead");
-        
+
     inputStream->CopyTo(stream);
     stream.Flush();
 }
 
-void PdfObjectStream::CopyToSafe(OutputStream& stream) const
+PdfDecodedStreamCache* PdfObjectStream::getDecodedStreamCache() const
 {
-    PdfFilterList mediaFilters;
-    vector<const PdfDictionary*> decodeParms;
-    auto inputStream = const_cast<PdfObjectStream&>(*this).getInputStream(false, mediaFilters, decodeParms);
-    inputStream->CopyTo(stream);
-    stream.Flush();
+    auto document = m_Parent->GetDocument();
+    if (document == nullptr || document->m_DecodedStreams == nullptr)
+        return nullptr;
+
+    // Streams with media filters can't be fully decoded
+    for (auto filter : m_Filters)
+    {
+        if (isMediaFilter(filter))
+            return nullptr;
+    }
+
+    return document->m_DecodedStreams.get();
+}
+
+shared_ptr<const charbuff> PdfObjectStream::getCachedCopy() const
+{
+    auto cache = getDecodedStreamCache();
+    if (cache == nullptr)
+        return nullptr;
+
+    auto ret = cache->Find(m_CacheKey);
+    if (ret != nullptr)
+        return ret;
+
+    auto decoded = std::make_shared<charbuff>();
+    if (!tryDecodeTo(*decoded))
+    {
+        BufferStreamDevice stream(*decoded);
+        copyTo(stream, false, false);
+    }
+
+    cache->Add(m_CacheKey, decoded);
+    return decoded;
+}
+
+void PdfObjectStream::copyToCached(PdfDecodedStreamCache& cache, OutputStream& stream) const
+{
+    auto cached = cache.Find(m_CacheKey);
+    if (cached != nullptr)
+    {
+        stream.Write(*cached);
+        stream.Flush();
+        return;
+    }
+
+    // The data is not decoded fully in memory ahead, as it
+    // may exceed the budget and not be cached anyway
+    CachingOutputStream cachingStream(stream, cache.GetBudget());
+    copyTo(cachingStream, false, false);
+    auto data = cachingStream.TakeData();
+    if (data != nullptr)
+        cache.Add(m_CacheKey, data);
+}
+
+void PdfObjectStream::removeCachedCopy()
+{
+    auto document = m_Parent->GetDocument();
+    if (document != nullptr && document->m_DecodedStreams != nullptr)
+        document->m_DecodedStreams->Remove(m_CacheKey);
 }
 
 charbuff PdfObjectStream::GetCopy(bool raw) const
 {
     charbuff ret;
-    StringStreamDevice stream(ret);
-    CopyTo(stream, raw);
+    CopyTo(ret, raw);
     return ret;
 }
 
 charbuff PdfObjectStream::GetCopySafe() const
 {
     charbuff ret;
-    StringStreamDevice stream(ret);
-    CopyToSafe(stream);
+    CopyToSafe(ret);
     return ret;
 }
 
+bool PdfObjectStream::tryDecodeTo(charbuff& buffer) const
+{
+    // Streams held in memory with a single FlateDecode filter are decoded
+    // at once, which is faster than decoding them through an input stream
+    if (m_Filters.size() != 1 || m_Filters.front() != PdfFilterType::FlateDecode)
+        return false;
+
+    auto memoryStream = dynamic_cast<const PdfMemoryObjectStream*>(m_Provider.get());
+    if (memoryStream == nullptr)
+        return false;
+
+    const PdfDictionary* decodeParms = nullptr;
+    auto decodeParmsObj = m_Parent->GetDictionaryUnsafe().FindKey("DecodeParms");
+    if (decodeParmsObj != nullptr)
+    {
+        const PdfDictionary* decodeParmsDict;
+        const PdfArray* decodeParmsArr;
+        if (decodeParmsObj->TryGetDictionary(decodeParmsDict))
+        {
+            decodeParms = decodeParmsDict;
+        }
+        else if (decodeParmsObj->TryGetArray(decodeParmsArr) && decodeParmsArr->GetSize() != 0)
+        {
+            auto decodeParmsEntry = decodeParmsArr->FindAt(0);
+            if (decodeParmsEntry != nullptr && decodeParmsEntry->TryGetDictionary(decodeParmsDict))
+                decodeParms = decodeParmsDict;
+        }
+    }
+
+    ensureClosed();
+    PdfFilterFactory::Create(PdfFilterType::FlateDecode)->DecodeTo(buffer, memoryStream->GetBuffer(), decodeParms);
+    return true;
+}
+
 void PdfObjectStream::Unwrap()
 {
     if (m_Filters.size() == 0)
@@ -184,6 +365,7 @@ void PdfObjectStream::Unwrap()
 void PdfObjectStream::Clear()
 {
     ensureClosed();
+    removeCachedCopy();
     m_Provider->Clear();
     m_Filters.clear();
     GetParent().SetDirty();
@@ -218,6 +400,8 @@ void PdfObjectStream::MoveFrom(PdfObjectStream& rhs)
 {
     rhs.ensureClosed();
     ensureClosed();
+    removeCachedCopy();
+    rhs.removeCachedCopy();
     if (!m_Provider->TryMoveFrom(std::move(*rhs.m_Provider)))
         PODOFO_RAISE_ERROR_INFO(PdfErrorCode::InternalLogic, "Unsupported move operation");
 
@@ -253,6 +437,7 @@ void PdfObjectStream::MoveFrom(PdfObjectStream& rhs)
 void PdfObjectStream::CopyFrom(const PdfObjectStream& rhs)
 {
     ensureClosed();
+    removeCachedCopy();
     if (m_Provider->TryCopyFrom(*rhs.m_Provider))
     {
         m_Filters = rhs.m_Filters;
@@ -478,6 +663,7 @@ PdfObjectOutputStream::PdfObjectOutputStream(PdfObjectStream& stream,
     if (append)
         stream.CopyTo(buffer);
 
+    m_stream->removeCachedCopy();
     m_stream->m_locked = true;
 
     if (filters_.has_value())
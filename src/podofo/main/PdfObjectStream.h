@@ -18,6 +18,7 @@ namespace PoDoFo {
 
 class PdfObject;
 class PdfObjectStream;
+class PdfDecodedStreamCache;
 
 class PODOFO_API PdfObjectInputStream final : public InputStream
 {
@@ -238,6 +239,29 @@ private:
 private:
     void ensureClosed() const;
 
+    bool tryDecodeTo(charbuff& buffer) const;
+
+    void copyTo(OutputStream& stream, bool raw, bool safe) const;
+
+    /** \returns the decoded streams cache of the document, or
+     *  nullptr if it's disabled or the data can't be cached
+     */
+    PdfDecodedStreamCache* getDecodedStreamCache() const;
+
+    /** Get the decoded data from the cache of the document, decoding
+     *  and adding it if it's missing
+     *  \returns nullptr if the cache is disabled or the data can't be cached
+     */
+    std::shared_ptr<const charbuff> getCachedCopy() const;
+
+    /** Write the decoded data from the given cache, or decode it directly
+     *  to the stream, adding it to the cache only if it fits the budget
+     */
+    void copyToCached(PdfDecodedStreamCache& cache, OutputStream& stream) const;
+
+    // To be called before the data or the filters are modified
+    void removeCachedCopy();
+
     std::unique_ptr<InputStream> getInputStream(bool raw, PdfFilterList& mediaFilters,
         std::vector<const PdfDictionary*>& decodeParms);
 
@@ -251,6 +275,7 @@ private:
     PdfObject* m_Parent;
     std::unique_ptr<PdfObjectStreamProvider> m_Provider;
     PdfFilterList m_Filters;
+    uint64_t m_CacheKey;
     bool m_locked;
 };
 
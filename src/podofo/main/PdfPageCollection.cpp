@@ -31,6 +31,7 @@ namespace
 
 static PdfPageTreeNodeType getPageTreeNodeType(const PdfObject& nodeObj);
 static unsigned getChildCount(const PdfObject& nodeObj);
+static bool tryGetChildCount(const PdfObject& nodeObj, unsigned& count);
 
 PdfPageCollection::PdfPageCollection(PdfDocument& doc)
     : PdfDictionaryElement(doc, "Pages"_n), m_initialized(true)
@@ -48,6 +49,9 @@ PdfPageCollection::~PdfPageCollection()
 {
     for (unsigned i = 0; i < m_Pages.size(); i++)
         delete m_Pages[i];
+
+    for (auto& pair : m_demandPages)
+        delete pair.second;
 }
 
 unsigned PdfPageCollection::GetCount() const
@@ -58,7 +62,15 @@ unsigned PdfPageCollection::GetCount() const
 
 PdfPage& PdfPageCollection::GetPageAt(unsigned index)
 {
-    const_cast<PdfPageCollection&>(*this).initPages();
+    if (!m_initialized)
+    {
+        auto page = tryGetPageOnDemand(index);
+        if (page != nullptr)
+            return *page;
+
+        initPages();
+    }
+
     if (index >= m_Pages.size())
         PODOFO_RAISE_ERROR_INFO(PdfErrorCode::ValueOutOfRange, "Page with index {} not found", index);
 
@@ -67,11 +79,7 @@ PdfPage& PdfPageCollection::GetPageAt(unsigned index)
 
 const PdfPage& PdfPageCollection::GetPageAt(unsigned index) const
 {
-    const_cast<PdfPageCollection&>(*this).initPages();
-    if (index >= m_Pages.size())
-        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::ValueOutOfRange, "Page with index {} not found", index);
-
-    return *m_Pages[index];
+    return const_cast<PdfPageCollection&>(*this).GetPageAt(index);
 }
 
 PdfPage& PdfPageCollection::GetPage(const PdfReference& ref)
@@ -118,21 +126,25 @@ PdfPage& PdfPageCollection::getPage(const PdfReference& ref) const
 
 PdfPageCollection::iterator PdfPageCollection::begin()
 {
+    initPages();
     return m_Pages.begin();
 }
 
 PdfPageCollection::iterator PdfPageCollection::end()
 {
+    initPages();
     return m_Pages.end();
 }
 
 PdfPageCollection::const_iterator PdfPageCollection::begin() const
 {
+    const_cast<PdfPageCollection&>(*this).initPages();
     return m_Pages.begin();
 }
 
 PdfPageCollection::const_iterator PdfPageCollection::end() const
 {
+    const_cast<PdfPageCollection&>(*this).initPages();
     return m_Pages.end();
 }
 
@@ -157,6 +169,7 @@ void PdfPageCollection::InsertPagesAt(unsigned atIndex, cspan<PdfPage*> pages)
 
 bool PdfPageCollection::TryMovePageTo(unsigned atIndex, unsigned toIndex)
 {
+    initPages();
     PODOFO_ASSERT(atIndex < m_Pages.size() && atIndex != toIndex);
     if (toIndex >= m_Pages.size())
         return false;
@@ -314,6 +327,7 @@ void PdfPageCollection::initPages()
         (void)traversePageTreeNode(GetObject(), count, parents, visitedNodes);
     }
 
+    m_demandLeafCounts.clear();
     m_initialized = true;
 }
 
@@ -361,7 +375,19 @@ unsigned PdfPageCollection::traversePageTreeNode(PdfObject& obj, unsigned count,
         case PdfPageTreeNodeType::Page:
         {
             unsigned index = (unsigned)m_Pages.size();
-            unique_ptr<PdfPage> page(new PdfPage(obj, vector<PdfObject*>(parents)));
+            unique_ptr<PdfPage> page;
+            auto found = m_demandPages.find(&obj);
+            if (found == m_demandPages.end())
+            {
+                page.reset(new PdfPage(obj, vector<PdfObject*>(parents)));
+            }
+            else
+            {
+                // Reuse the page already returned to the user
+                page.reset(found->second);
+                m_demandPages.erase(found);
+            }
+
             m_Pages.push_back(page.get());
             (*page.release()).SetIndex(index);
             return count - 1;
@@ -375,6 +401,159 @@ unsigned PdfPageCollection::traversePageTreeNode(PdfObject& obj, unsigned count,
     }
 }
 
+PdfPage* PdfPageCollection::tryGetPageOnDemand(unsigned index)
+{
+    // Descend the tree to the requested page, skipping the
+    // subtrees that precede it by using their /Count. The
+    // /Count of the skipped subtrees is checked against their
+    // actual leaves: if the tree is not well formed return
+    // nullptr, so that the whole tree is traversed instead
+    auto node = &GetObject();
+    unsigned count;
+    if (getPageTreeNodeType(*node) != PdfPageTreeNodeType::Node
+        || !tryGetChildCount(*node, count) || index >= count)
+    {
+        return nullptr;
+    }
+
+    unsigned pageIndex = index;
+    vector<PdfObject*> parents;
+    unordered_set<PdfObject*> visitedNodes;
+    PdfReference ref;
+    while (true)
+    {
+        if (!visitedNodes.insert(node).second)
+            return nullptr;
+
+        auto kidsObj = node->GetDictionary().FindKey("Kids");
+        PdfArray* kidsArr;
+        if (kidsObj == nullptr || !kidsObj->TryGetArray(kidsArr))
+            return nullptr;
+
+        parents.push_back(node);
+        PdfObject* next = nullptr;
+        for (unsigned i = 0; i < kidsArr->GetSize(); i++)
+        {
+            auto child = &(*kidsArr)[i];
+            if (child->TryGetReference(ref))
+                child = node->MustGetDocument().GetObjects().GetObject(ref);
+
+            if (child == nullptr)
+                continue;
+
+            switch (getPageTreeNodeType(*child))
+            {
+                case PdfPageTreeNodeType::Node:
+                {
+                    if (!tryGetChildCount(*child, count))
+                        return nullptr;
+
+                    if (index < count)
+                    {
+                        next = child;
+                        break;
+                    }
+
+                    unsigned leafCount;
+                    unordered_set<PdfObject*> visitedLeafNodes;
+                    if (!tryCountPageTreeLeaves(*child, leafCount, visitedLeafNodes)
+                        || leafCount != count)
+                    {
+                        return nullptr;
+                    }
+
+                    index -= count;
+                    continue;
+                }
+                case PdfPageTreeNodeType::Page:
+                {
+                    if (index != 0)
+                    {
+                        index--;
+                        continue;
+                    }
+
+                    auto found = m_demandPages.find(child);
+                    if (found != m_demandPages.end())
+                        return found->second;
+
+                    unique_ptr<PdfPage> page(new PdfPage(*child, std::move(parents)));
+                    page->SetIndex(pageIndex);
+                    m_demandPages[child] = page.get();
+                    return page.release();
+                }
+                case PdfPageTreeNodeType::Unknown:
+                default:
+                    return nullptr;
+            }
+
+            break;
+        }
+
+        if (next == nullptr)
+            return nullptr;
+
+        node = next;
+    }
+}
+
+bool PdfPageCollection::tryCountPageTreeLeaves(PdfObject& obj, unsigned& count,
+    unordered_set<PdfObject*>& visitedNodes)
+{
+    utls::RecursionGuard guard;
+    switch (getPageTreeNodeType(obj))
+    {
+        case PdfPageTreeNodeType::Node:
+        {
+            auto found = m_demandLeafCounts.find(&obj);
+            if (found != m_demandLeafCounts.end())
+            {
+                count = found->second;
+                return true;
+            }
+
+            if (!visitedNodes.insert(&obj).second)
+                return false;
+
+            auto kidsObj = obj.GetDictionary().FindKey("Kids");
+            PdfArray* kidsArr;
+            if (kidsObj == nullptr || !kidsObj->TryGetArray(kidsArr))
+                return false;
+
+            count = 0;
+            PdfReference ref;
+            unsigned childCount;
+            for (unsigned i = 0; i < kidsArr->GetSize(); i++)
+            {
+                auto child = &(*kidsArr)[i];
+                if (child->TryGetReference(ref))
+                    child = obj.MustGetDocument().GetObjects().GetObject(ref);
+
+                if (child == nullptr)
+                    continue;
+
+                if (!tryCountPageTreeLeaves(*child, childCount, visitedNodes))
+                    return false;
+
+                count += childCount;
+            }
+
+            m_demandLeafCounts[&obj] = count;
+            return true;
+        }
+        case PdfPageTreeNodeType::Page:
+        {
+            count = 1;
+            return true;
+        }
+        case PdfPageTreeNodeType::Unknown:
+        default:
+        {
+            return false;
+        }
+    }
+}
+
 void PdfPageCollection::FlattenStructure()
 {
     if (m_kidsArray != nullptr)
@@ -417,11 +596,21 @@ PdfPageTreeNodeType getPageTreeNodeType(const PdfObject& obj)
 }
 
 unsigned getChildCount(const PdfObject& nodeObj)
+{
+    unsigned count;
+    if (!tryGetChildCount(nodeObj, count))
+        return 1;
+
+    return count;
+}
+
+bool tryGetChildCount(const PdfObject& nodeObj, unsigned& count)
 {
     auto countObj = nodeObj.GetDictionary().FindKey("Count");
     int64_t num;
     if (countObj == nullptr || !countObj->TryGetNumber(num) || num < 0)
-        return 1;
+        return false;
 
-    return (unsigned)num;
+    count = (unsigned)num;
+    return true;
 }
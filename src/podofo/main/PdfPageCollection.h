@@ -48,6 +48,11 @@ public:
      *  The returned page is owned by the pages tree and
      *  deleted along with it.
      *
+     *  If the whole tree was not traversed yet, the page is found
+     *  by descending the tree and using the /Count of the intermediate
+     *  nodes to skip the subtrees that precede it, without loading
+     *  the other pages
+     *
      *  \param index page index, 0-based
      *  \returns a pointer to the requested page
      */
@@ -218,6 +223,11 @@ private:
 
     void initPages();
 
+    PdfPage* tryGetPageOnDemand(unsigned index);
+
+    bool tryCountPageTreeLeaves(PdfObject& obj, unsigned& count,
+        std::unordered_set<PdfObject*>& visitedNodes);
+
     unsigned traversePageTreeNode(PdfObject& obj, unsigned count,
         std::vector<PdfObject*>& parents, std::unordered_set<PdfObject*>& visitedNodes);
 
@@ -227,6 +237,12 @@ private:
 private:
     bool m_initialized;
     PageList m_Pages;
+    // Pages found on demand before the tree is traversed,
+    // which the traversal will reuse
+    std::unordered_map<PdfObject*, PdfPage*> m_demandPages;
+    // Actual leaf counts of the page tree nodes skipped
+    // while finding pages on demand
+    std::unordered_map<PdfObject*, unsigned> m_demandLeafCounts;
     PdfArray* m_kidsArray;
 };
 
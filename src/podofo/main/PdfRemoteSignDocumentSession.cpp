@@ -10,6 +10,9 @@
 
 #include "PdfRemoteSignDocumentSession.h"
 #include <podofo/private/OpenSSLInternal.h>
+#include <podofo/private/BinaryToText.h>
+#include <podofo/private/DerCache.h>
+#include <podofo/private/TimestampSizeCache.h>
 #include <openssl/bio.h>
 #include <iterator>
 #include <openssl/ts.h>
@@ -21,6 +24,16 @@
 #include <openssl/err.h>
 #include <iomanip>
 #include <cstring>
+#include <unordered_set>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#elif defined(__APPLE__)
+#include <sys/clonefile.h>
+#endif
 
 namespace fs = std::filesystem;
 
@@ -45,6 +58,63 @@ static std::vector<unsigned char> ReadBinary(const std::string& path) {
              std::istreambuf_iterator<char>() };
 }
 
+/**
+ * @brief Decodes base64 data into a buffer sized upfront
+ * @param base64 The base64 text, whitespace is skipped
+ * @param errorMessage Message of the exception thrown on invalid input
+ * @return The decoded bytes
+ */
+template <typename TBuffer>
+static TBuffer DecodeBase64(const std::string_view& base64, const char* errorMessage) {
+    TBuffer decoded;
+    decoded.resize(utls::GetBase64DecodedMaxSize(base64.size()));
+    size_t decodedSize;
+    if (!utls::TryDecodeBase64To(PoDoFo::bufferspan(reinterpret_cast<char*>(decoded.data()), decoded.size()), base64, decodedSize))
+        throw std::runtime_error(errorMessage);
+    decoded.resize(decodedSize);
+    return decoded;
+}
+
+/**
+ * @brief Encodes a hash as URL-encoded base64, as expected by the remote signing service
+ * @param data The raw hash
+ * @return URL-encoded base64 string
+ */
+static std::string ToUrlEncodedBase64(const PoDoFo::bufferview& data) {
+    std::string base64(utls::GetBase64EncodedSize(data.size()), '\0');
+    utls::EncodeBase64To(base64, data);
+    std::string encoded(utls::GetUrlEncodedSize(base64), '\0');
+    utls::UrlEncodeTo(encoded, base64);
+    return encoded;
+}
+
+/**
+ * @brief Clones a file sharing the underlying extents when the filesystem supports it
+ * (FICLONE on Linux btrfs/XFS, clonefile() on APFS), otherwise falls back to a full copy
+ * @param src Source file path
+ * @param dst Destination file path, overwritten if existing
+ */
+static void CloneFile(const std::string& src, const std::string& dst) {
+#if defined(__linux__)
+    int srcFd = ::open(src.c_str(), O_RDONLY | O_CLOEXEC);
+    if (srcFd >= 0) {
+        int dstFd = ::open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        bool cloned = dstFd >= 0 && ::ioctl(dstFd, FICLONE, srcFd) == 0;
+        if (dstFd >= 0)
+            ::close(dstFd);
+        ::close(srcFd);
+        if (cloned)
+            return;
+    }
+#elif defined(__APPLE__)
+    std::error_code ec;
+    fs::remove(dst, ec);
+    if (::clonefile(src.c_str(), dst.c_str(), 0) == 0)
+        return;
+#endif
+    fs::copy_file(src, dst, fs::copy_options::overwrite_existing);
+}
+
 /**
  * @brief Deleter implementation; frees a BIO chain with BIO_free_all
  * @param b Pointer to the BIO chain to free
@@ -53,6 +123,11 @@ void PoDoFo::BioFreeAll::operator()(BIO* b) const noexcept {
     if (b) BIO_free_all(b);
 }
 
+PoDoFo::TimestampReserveExceededError::TimestampReserveExceededError(std::string hash)
+    : std::runtime_error("The timestamp token exceeds the room reserved in the signature, the document must be signed again")
+    , _hash(std::move(hash)) {
+}
+
 /**
  * @brief Constructor for PdfRemoteSignDocumentSession
  * @param conformanceLevel The conformance level for the signing operation
@@ -76,13 +151,15 @@ PoDoFo::PdfRemoteSignDocumentSession::PdfRemoteSignDocumentSession(
 )
     : _conformanceLevel(conformanceLevel)
     , _hashAlgorithm(hashAlgorithmFromOid(hashAlgorithmOid))
+    , _outputMode(SigningOutputMode::Copy)
     , _documentInputPath(documentInputPath)
     , _documentOutputPath(documentOutputPath)
     , _endCertificateBase64(endCertificateBase64)
     , _certificateChainBase64(certificateChainBase64)
     , _rootCertificateBase64(rootEntityCertificateBase64)
     , _label(label)
-
+    , _timestampReserve(0)
+    , _inputLength(0)
 {
 
     _endCertificateDer = ConvertBase64PEMtoDER(endCertificateBase64, "input/endCertificate.der");
@@ -103,20 +180,115 @@ PoDoFo::PdfRemoteSignDocumentSession::PdfRemoteSignDocumentSession(
  */
 PoDoFo::PdfRemoteSignDocumentSession::~PdfRemoteSignDocumentSession() = default;
 
+void PoDoFo::PdfRemoteSignDocumentSession::setOutputMode(SigningOutputMode mode) {
+    if (_stream) {
+        throw std::runtime_error("The output mode can't be changed after signing has started");
+    }
+    _outputMode = mode;
+}
+
+void PoDoFo::PdfRemoteSignDocumentSession::setTimestampAuthorityUrl(const std::string& url) {
+    if (_stream) {
+        throw std::runtime_error("The timestamp authority can't be changed after signing has started");
+    }
+    _timestampAuthorityUrl = url;
+}
+
+void PoDoFo::PdfRemoteSignDocumentSession::setMetricsHandler(PdfSigningMetricsHandler handler) {
+    if (_ctx) {
+        _ctx->SetMetricsHandler(handler);
+    }
+    _metricsHandler = std::move(handler);
+}
+
+void PoDoFo::PdfRemoteSignDocumentSession::reportMetrics(PdfSigningPhase phase,
+    std::chrono::steady_clock::time_point start, size_t byteCount) {
+    if (_metricsHandler == nullptr) {
+        return;
+    }
+
+    PdfSigningPhaseMetrics metrics;
+    metrics.Phase = phase;
+    metrics.Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    metrics.ByteCount = byteCount;
+    _metricsHandler(metrics);
+}
+
+/**
+ * @brief Opens the device the incremental updates will be appended to
+ *
+ * Copy mode appends to a clone of the input, unless input and output are the same file.
+ * InPlace mode appends to the input itself. Delta mode reads the unmodified input and
+ * stores only the appended section to the output file.
+ */
+void PoDoFo::PdfRemoteSignDocumentSession::openOutputStream() {
+    switch (_outputMode) {
+    case SigningOutputMode::Copy: {
+        std::error_code ec;
+        if (!fs::equivalent(_documentInputPath, _documentOutputPath, ec)) {
+            CloneFile(_documentInputPath, _documentOutputPath);
+        }
+        _stream = std::make_shared<PoDoFo::FileStreamDevice>(_documentOutputPath, PoDoFo::FileMode::Open);
+        break;
+    }
+    case SigningOutputMode::InPlace:
+        _stream = std::make_shared<PoDoFo::FileStreamDevice>(_documentInputPath, PoDoFo::FileMode::Open);
+        break;
+    case SigningOutputMode::Delta: {
+        // The input is never written in this mode, so it can be mapped
+        // and parsed directly from memory
+        auto input = std::make_shared<PoDoFo::MappedFileStreamDevice>(_documentInputPath);
+        auto delta = std::make_shared<PoDoFo::FileStreamDevice>(_documentOutputPath, PoDoFo::FileMode::Create);
+        _stream = std::make_shared<PoDoFo::DeltaStreamDevice>(input, delta);
+        break;
+    }
+    default:
+        throw std::runtime_error("Invalid output mode");
+    }
+}
+
 /**
  * @brief Begins the signing process for the document
  * @return Base64-encoded hash that needs to be signed remotely
  * @throws std::runtime_error if signing process cannot be initiated
  */
+/**
+ * @brief Discards the prepared revision, so the document can be prepared again
+ *
+ * Copy and InPlace modes truncate the file the revision was appended to, Delta
+ * mode will create the output file again.
+ */
+void PoDoFo::PdfRemoteSignDocumentSession::discardSigning() {
+    // Release the devices opened on the files before truncating them
+    _doc.Reset();
+    _stream.reset();
+    _ctx.reset();
+    _signer.reset();
+    _results = PdfSigningResults();
+
+    switch (_outputMode) {
+    case SigningOutputMode::Copy:
+        fs::resize_file(_documentOutputPath, _inputLength);
+        break;
+    case SigningOutputMode::InPlace:
+        fs::resize_file(_documentInputPath, _inputLength);
+        break;
+    default:
+        break;
+    }
+}
+
 std::string PoDoFo::PdfRemoteSignDocumentSession::beginSigning() {
     try {
-        fs::copy_file(_documentInputPath, _documentOutputPath, fs::copy_options::overwrite_existing);
-        _stream = std::make_shared<PoDoFo::FileStreamDevice>(_documentOutputPath, PoDoFo::FileMode::Open);
+        openOutputStream();
+        _inputLength = _stream->GetLength();
 
         std::string cert;
         cert.assign(_endCertificateDer.begin(), _endCertificateDer.end());
 
+        auto loadStart = std::chrono::steady_clock::now();
         _doc.Load(_stream);
+        reportMetrics(PdfSigningPhase::Load, loadStart, _stream->GetLength());
 
         auto& acroForm = _doc.GetOrCreateAcroForm();
         acroForm.GetDictionary().AddKey("SigFlags"_n, (int64_t)3);
@@ -160,24 +332,27 @@ std::string PoDoFo::PdfRemoteSignDocumentSession::beginSigning() {
         for (const auto& cert : _certificateChainDer)
             chain.emplace_back(reinterpret_cast<const char*>(cert.data()), cert.size());
 
-        _signer = std::make_shared<PoDoFo::PdfSignerCms>(cert, chain, _cmsParams);
-        _signer->ReserveAttributeSize(20000);
-        _signerId = _ctx.AddSigner(signature, _signer);
-
-        _ctx.StartSigning(_doc, _stream, _results, PoDoFo::PdfSaveOptions::NoMetadataUpdate);
+        charbuff chainData(cert);
+        for (const auto& chainCert : chain)
+            chainData.append(chainCert);
+        _sizeCacheKey = ssl::ComputeHashStr(chainData, PoDoFo::PdfHashingAlgorithm::SHA256) + ":" + _conformanceLevel
+            + ":" + _timestampAuthorityUrl;
 
-        auto& INITIAL_hash = _results.Intermediate[_signerId];
-        auto rawCmsHash = ToHexString(INITIAL_hash);
-
-        auto binaryHash = HexToBytes(rawCmsHash);
-        PoDoFo::charbuff binaryCharbuff;
-        binaryCharbuff.assign(reinterpret_cast<const char*>(binaryHash.data()), binaryHash.size());
-
-        auto base64Hash = ToBase64(binaryCharbuff);
+        // The CMS is sized on the actual certificate key, B-B signatures have no
+        // unsigned attributes while the others need room for the timestamp token
+        _signer = std::make_shared<PoDoFo::PdfSignerCms>(cert, chain, _cmsParams);
+        _timestampReserve = 0;
+        if (_cmsParams.SignatureType != PoDoFo::PdfSignatureType::PAdES_B) {
+            _timestampReserve = TimestampSizeCache::instance().estimate(_sizeCacheKey, _timestampAuthorityUrl.empty());
+            _signer->ReserveAttributeSize(static_cast<unsigned>(_timestampReserve));
+        }
 
-        auto urlEncodedHash = UrlEncode(base64Hash);
+        _ctx = std::make_unique<PoDoFo::PdfSigningContext>();
+        _ctx->SetMetricsHandler(_metricsHandler);
+        _signerId = _ctx->AddSigner(signature, _signer);
+        _ctx->StartSigning(_doc, _stream, _results, PoDoFo::PdfSaveOptions::NoMetadataUpdate);
 
-        return urlEncodedHash;
+        return ToUrlEncodedBase64(_results.Intermediate[_signerId]);
     }
     catch (const std::exception& e) {
         std::cout << "\n=== Error in Signing Process ===" << std::endl;
@@ -207,33 +382,37 @@ void PoDoFo::PdfRemoteSignDocumentSession::finishSigning(const std::string& sign
 
         if (_conformanceLevel != "ADES_B_B") {
             tsr = DecodeBase64Tsr(base64Tsr);
+            // Record the size before embedding, so the following
+            // reservations will have enough room for the token
+            TimestampSizeCache::instance().update(_sizeCacheKey, tsr.size());
+            if (tsr.size() > _timestampReserve) {
+                // The token doesn't fit: the signed revision is prepared again
+                // with more room, and its hash must be signed remotely again
+                discardSigning();
+                throw TimestampReserveExceededError(beginSigning());
+            }
             _signer->SetTimestampToken({ tsr.data(), tsr.size() });
 
         }
-        _ctx.FinishSigning(_results);
-
-
-        if (_conformanceLevel == "ADES_B_LT" && validationData.has_value()) {
-            PoDoFo::PdfMemDocument dss_doc;
-            _stream->Seek(0, PoDoFo::SeekDirection::Begin);
-            dss_doc.Load(_stream);
-
-            createOrUpdateDSSCatalog(dss_doc, *validationData);
-
-            dss_doc.SaveUpdate(*_stream, PoDoFo::PdfSaveOptions::NoMetadataUpdate | PoDoFo::PdfSaveOptions::NoFlateCompress);
-        }
+        _ctx->FinishSigning(_results);
 
-        if (_conformanceLevel == "ADES_B_LTA" && validationData.has_value()) {
-            PoDoFo::PdfMemDocument dss_doc;
-            _stream->Seek(0, PoDoFo::SeekDirection::Begin);
-            dss_doc.Load(_stream);
 
-            createOrUpdateDSSCatalog(dss_doc, *validationData);
+        // The signed revision is already in memory, so the DSS is
+        // appended as a further incremental update without reparsing
+        if ((_conformanceLevel == "ADES_B_LT" || _conformanceLevel == "ADES_B_LTA") && validationData.has_value()) {
+            auto dssStart = std::chrono::steady_clock::now();
+            size_t initialLength = _stream->GetLength();
+            createOrUpdateDSSCatalog(_doc, *validationData);
 
-            dss_doc.SaveUpdate(*_stream, PoDoFo::PdfSaveOptions::NoMetadataUpdate | PoDoFo::PdfSaveOptions::NoFlateCompress);
+            _doc.SaveUpdate(*_stream, PoDoFo::PdfSaveOptions::NoMetadataUpdate | PoDoFo::PdfSaveOptions::NoFlateCompress);
+            reportMetrics(PdfSigningPhase::DssUpdate, dssStart, _stream->GetLength() - initialLength);
         }
 
     }
+    catch (const TimestampReserveExceededError&) {
+        // The session has been prepared again
+        throw;
+    }
     catch (const std::exception& e) {
         std::cout << "\n=== Error in Finish Signing ===" << std::endl;
         std::cout << "Error: " << e.what() << std::endl;
@@ -249,88 +428,29 @@ std::vector<unsigned char> PoDoFo::PdfRemoteSignDocumentSession::ConvertBase64PE
     if (!base64PEM || base64PEM->empty())
         return {};
 
-    BIO* raw_b64 = BIO_new(BIO_f_base64());
-    if (!raw_b64) throw std::runtime_error("Failed to create BIO for Base64");
-    BIO_set_flags(raw_b64, BIO_FLAGS_BASE64_NO_NL);
-
-    BIO* raw_mem = BIO_new_mem_buf(base64PEM->data(), static_cast<int>(base64PEM->size()));
-    if (!raw_mem) {
-        BIO_free_all(raw_b64);
-        throw std::runtime_error("Failed to create memory BIO");
-    }
-
-    BIO* raw_chain = BIO_push(raw_b64, raw_mem);
-    PoDoFo::BioPtr bio(raw_chain);
-
-    std::vector<unsigned char> der((base64PEM->size() * 3) / 4);
-    int len = BIO_read(bio.get(), der.data(), static_cast<int>(der.size()));
-    if (len <= 0) throw std::runtime_error("Base64 decode failed");
-    der.resize(len);
+    auto der = DecodeBase64<std::vector<unsigned char>>(*base64PEM, "Base64 decode failed");
+    if (der.empty()) throw std::runtime_error("Base64 decode failed");
 
     return der;
 }
 
 std::string PoDoFo::PdfRemoteSignDocumentSession::ToBase64(const PoDoFo::charbuff& data) {
-    BIO* raw_b64 = BIO_new(BIO_f_base64()); BIO_set_flags(raw_b64, BIO_FLAGS_BASE64_NO_NL);
-    BIO* raw_mem = BIO_new(BIO_s_mem());
-    BIO* raw_chain = BIO_push(raw_b64, raw_mem);
-    PoDoFo::BioPtr bio(raw_chain);
-
-    if (BIO_write(bio.get(), data.data(), static_cast<int>(data.size())) <= 0 ||
-        BIO_flush(bio.get()) <= 0)
-        throw std::runtime_error("BIO_write/flush failed");
-
-    BUF_MEM* ptr;
-    BIO_get_mem_ptr(bio.get(), &ptr);
-    return std::string(ptr->data, ptr->length);
+    std::string encoded(utls::GetBase64EncodedSize(data.size()), '\0');
+    utls::EncodeBase64To(encoded, data);
+    return encoded;
 }
 
 PoDoFo::charbuff PoDoFo::PdfRemoteSignDocumentSession::ConvertDSSHashToSignedHash(const std::string& DSSHash) {
-    BIO* raw_b64 = BIO_new(BIO_f_base64()); BIO_set_flags(raw_b64, BIO_FLAGS_BASE64_NO_NL);
-    BIO* raw_mem = BIO_new_mem_buf(DSSHash.data(), static_cast<int>(DSSHash.size()));
-    BIO* raw_chain = BIO_push(raw_b64, raw_mem);
-    PoDoFo::BioPtr bio(raw_chain);
-
-    std::vector<unsigned char> decoded(128);
-    int len = BIO_read(bio.get(), decoded.data(), static_cast<int>(decoded.size()));
-    if (len <= 0) throw std::runtime_error("Base64 decode failed");
-    decoded.resize(len);
-
-    PoDoFo::charbuff result;
-    result.assign(decoded.begin(), decoded.end());
-    return result;
-}
+    auto signedHash = DecodeBase64<PoDoFo::charbuff>(DSSHash, "Base64 decode failed");
+    if (signedHash.empty()) throw std::runtime_error("Base64 decode failed");
 
-std::vector<unsigned char> PoDoFo::PdfRemoteSignDocumentSession::HexToBytes(const std::string& hex) {
-    std::vector<unsigned char> bytes;
-    for (size_t i = 0; i < hex.length(); i += 2) {
-        std::string byteString = hex.substr(i, 2);
-        unsigned char byte = static_cast<unsigned char>(strtol(byteString.c_str(), nullptr, 16));
-        bytes.push_back(byte);
-    }
-    return bytes;
-}
-
-std::string PoDoFo::PdfRemoteSignDocumentSession::ToHexString(const PoDoFo::charbuff& data) {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
-    for (unsigned char c : data) {
-        ss << std::setw(2) << static_cast<int>(c);
-    }
-    return ss.str();
+    return signedHash;
 }
 
 std::string PoDoFo::PdfRemoteSignDocumentSession::UrlEncode(const std::string& value) {
-    std::ostringstream escaped; escaped.fill('0'); escaped << std::hex;
-    for (unsigned char c : value) {
-        if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
-            escaped << c;
-        }
-        else {
-            escaped << '%' << std::setw(2) << std::uppercase << static_cast<int>(c);
-        }
-    }
-    return escaped.str();
+    std::string escaped(utls::GetUrlEncodedSize(value), '\0');
+    utls::UrlEncodeTo(escaped, value);
+    return escaped;
 }
 
 void PoDoFo::PdfRemoteSignDocumentSession::printState() const {
@@ -351,18 +471,7 @@ void PoDoFo::PdfRemoteSignDocumentSession::printState() const {
 
 std::string PoDoFo::PdfRemoteSignDocumentSession::getCrlFromCertificate(const std::string& base64Cert) {
     auto base64_decode = [](const std::string& base64_string) -> std::vector<unsigned char> {
-        std::unique_ptr<BIO, decltype(&BIO_free)> b64(BIO_new(BIO_f_base64()), BIO_free);
-        if (!b64) throw std::runtime_error("Failed to create BIO for base64 decoding.");
-        BIO_set_flags(b64.get(), BIO_FLAGS_BASE64_NO_NL);
-        std::unique_ptr<BIO, decltype(&BIO_free)> bmem(BIO_new_mem_buf(base64_string.data(), static_cast<int>(base64_string.length())), BIO_free);
-        if (!bmem) throw std::runtime_error("Failed to create BIO_mem_buf for base64 decoding.");
-        BIO* bio = BIO_push(b64.get(), bmem.get());
-
-        std::vector<unsigned char> decoded_data(base64_string.length());
-        int decoded_length = BIO_read(bio, decoded_data.data(), static_cast<int>(decoded_data.size()));
-        if (decoded_length <= 0) throw std::runtime_error("Failed to decode base64 input.");
-        decoded_data.resize(decoded_length);
-        return decoded_data;
+        return DecodeBase64<std::vector<unsigned char>>(base64_string, "Failed to decode base64 input.");
         };
 
     std::vector<unsigned char> decoded = base64_decode(base64Cert);
@@ -436,34 +545,11 @@ std::string PoDoFo::PdfRemoteSignDocumentSession::getCrlFromCertificate(const st
 }
 
 std::string PoDoFo::PdfRemoteSignDocumentSession::DecodeBase64Tsr(const std::string& base64Tsr) {
-    BIO* b64 = BIO_new(BIO_f_base64());
-    if (!b64) {
-        throw std::runtime_error("Failed to create BIO for base64 decoding");
-    }
-    BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
-
-    BIO* mem = BIO_new_mem_buf(base64Tsr.data(), static_cast<int>(base64Tsr.size()));
-    if (!mem) {
-        BIO_free_all(b64);
-        throw std::runtime_error("Failed to create memory BIO");
-    }
-
-    BIO* bio = BIO_push(b64, mem);
-
-    size_t maxDecodedSize = (base64Tsr.size() * 3) / 4;
-    std::vector<unsigned char> decoded(maxDecodedSize);
-
-    int decodedSize = BIO_read(bio, decoded.data(), static_cast<int>(maxDecodedSize));
-    BIO_free_all(bio);
-
-    if (decodedSize <= 0) {
+    auto tsrData = DecodeBase64<std::string>(base64Tsr, "Failed to decode base64 TSR data");
+    if (tsrData.empty()) {
         throw std::runtime_error("Failed to decode base64 TSR data");
     }
 
-    decoded.resize(decodedSize);
-
-    std::string tsrData(decoded.begin(), decoded.end());
-
     const unsigned char* p = reinterpret_cast<const unsigned char*>(tsrData.data());
     TS_RESP* response = d2i_TS_RESP(nullptr, &p, static_cast<long>(tsrData.size()));
     if (!response) {
@@ -516,7 +602,7 @@ void PoDoFo::PdfRemoteSignDocumentSession::createOrUpdateDSSCatalog(PoDoFo::PdfM
     }
 
     auto addToDssArray = [&](const char* keyName, const std::vector<std::string>& data,
-        PoDoFo::PdfObject& (PoDoFo::PdfRemoteSignDocumentSession::* createStreamFunc)(PoDoFo::PdfMemDocument&, const std::string&)) {
+        PoDoFo::PdfObject& (PoDoFo::PdfRemoteSignDocumentSession::* createStreamFunc)(PoDoFo::PdfMemDocument&, const PoDoFo::charbuff&)) {
             const PoDoFo::PdfName key(keyName);
             PoDoFo::PdfArray* pArray = nullptr;
             if (pDssDict->HasKey(key)) {
@@ -535,8 +621,22 @@ void PoDoFo::PdfRemoteSignDocumentSession::createOrUpdateDSSCatalog(PoDoFo::PdfM
             }
 
             if (pArray) {
+                // Index the artifacts already embedded by previous updates by their
+                // digest, so the same chain, CRLs and OCSP responses are not written again
+                std::unordered_set<std::string> embedded;
+                for (auto& item : *pArray) {
+                    const PoDoFo::PdfObject* itemObj = item.IsReference() ? objects.GetObject(item.GetReference()) : &item;
+                    if (itemObj && itemObj->HasStream())
+                        embedded.insert(ssl::ComputeHash(itemObj->MustGetStream().GetCopy(), PoDoFo::PdfHashingAlgorithm::SHA256));
+                }
+
                 for (const auto& itemBase64 : data) {
-                    auto& stream = (this->*createStreamFunc)(doc, itemBase64);
+                    auto decoded = DerCache::Instance().Get(itemBase64,
+                        [&] { return ConvertBase64PEMtoDER(itemBase64, std::nullopt); });
+                    if (!embedded.insert(decoded->Digest).second)
+                        continue;
+
+                    auto& stream = (this->*createStreamFunc)(doc, decoded->Der);
                     pArray->Add(stream.GetIndirectReference());
                 }
             }
@@ -555,41 +655,26 @@ void PoDoFo::PdfRemoteSignDocumentSession::createOrUpdateDSSCatalog(PoDoFo::PdfM
     }
 }
 
-PoDoFo::PdfObject& PoDoFo::PdfRemoteSignDocumentSession::createCertificateStream(PoDoFo::PdfMemDocument& doc, const std::string& certBase64) {
-    std::vector<unsigned char> certDer = ConvertBase64PEMtoDER(certBase64, std::nullopt);
-
+PoDoFo::PdfObject& PoDoFo::PdfRemoteSignDocumentSession::createCertificateStream(PoDoFo::PdfMemDocument& doc, const PoDoFo::charbuff& certDer) {
     auto& streamObj = doc.GetObjects().CreateDictionaryObject();
     auto& stream = streamObj.GetOrCreateStream();
-
-    PoDoFo::charbuff certData;
-    certData.assign(reinterpret_cast<const char*>(certDer.data()), certDer.size());
-    stream.SetData(certData, {}, true);
+    stream.SetData(certDer, {}, true);
 
     return streamObj;
 }
 
-PoDoFo::PdfObject& PoDoFo::PdfRemoteSignDocumentSession::createCRLStream(PoDoFo::PdfMemDocument& doc, const std::string& crlBase64) {
-    std::vector<unsigned char> crlDer = ConvertBase64PEMtoDER(crlBase64, std::nullopt);
-
+PoDoFo::PdfObject& PoDoFo::PdfRemoteSignDocumentSession::createCRLStream(PoDoFo::PdfMemDocument& doc, const PoDoFo::charbuff& crlDer) {
     auto& streamObj = doc.GetObjects().CreateDictionaryObject();
     auto& stream = streamObj.GetOrCreateStream();
-
-    PoDoFo::charbuff crlData;
-    crlData.assign(reinterpret_cast<const char*>(crlDer.data()), crlDer.size());
-    stream.SetData(crlData, {}, true);
+    stream.SetData(crlDer, {}, true);
 
     return streamObj;
 }
 
-PoDoFo::PdfObject& PoDoFo::PdfRemoteSignDocumentSession::createOCSPStream(PoDoFo::PdfMemDocument& doc, const std::string& ocspBase64) {
-    std::vector<unsigned char> ocspDer = ConvertBase64PEMtoDER(ocspBase64, std::nullopt);
-
+PoDoFo::PdfObject& PoDoFo::PdfRemoteSignDocumentSession::createOCSPStream(PoDoFo::PdfMemDocument& doc, const PoDoFo::charbuff& ocspDer) {
     auto& streamObj = doc.GetObjects().CreateDictionaryObject();
     auto& stream = streamObj.GetOrCreateStream();
-
-    PoDoFo::charbuff ocspData;
-    ocspData.assign(reinterpret_cast<const char*>(ocspDer.data()), ocspDer.size());
-    stream.SetData(ocspData, {}, true);
+    stream.SetData(ocspDer, {}, true);
 
     return streamObj;
 }
@@ -603,40 +688,27 @@ std::string PoDoFo::PdfRemoteSignDocumentSession::beginSigningLTA() {
             throw std::runtime_error("No active stream available. Make sure finishSigning() was called successfully.");
         }
 
-        _stream->Seek(0, PoDoFo::SeekDirection::Begin);
-        _ltaDoc = std::make_unique<PoDoFo::PdfMemDocument>();
-        _ltaDoc->Load(_stream);
-
-        auto& page = _ltaDoc->GetPages().GetPageAt(0);
+        auto& page = _doc.GetPages().GetPageAt(0);
         auto& signature = static_cast<PoDoFo::PdfSignature&>(page.CreateField("Signature2", PoDoFo::PdfFieldType::Signature, PoDoFo::Rect(0, 0, 0, 0)));
 
         signature.MustGetWidget().SetFlags(static_cast<PoDoFo::PdfAnnotationFlags>(132));
 
         _ltaCtx = std::make_unique<PoDoFo::PdfSigningContext>();
+        _ltaCtx->SetMetricsHandler(_metricsHandler);
 
-        _ltaSigner = std::make_shared<PoDoFo::PdfDocTimeStampSigner>();
+        auto ltaSigner = std::make_shared<PoDoFo::PdfDocTimeStampSigner>();
+        ltaSigner->SetReservedSize(TimestampSizeCache::instance().estimate(_sizeCacheKey + ":DocTimeStamp", _timestampAuthorityUrl.empty()));
+        _ltaSigner = ltaSigner;
         _ltaSignerId = _ltaCtx->AddSigner(signature, _ltaSigner);
 
-        _ltaCtx->StartSigning(*_ltaDoc, _stream, _ltaResults, PoDoFo::PdfSaveOptions::NoMetadataUpdate);
-
-        auto& INITIAL_hash = _ltaResults.Intermediate[_ltaSignerId];
-        auto rawCmsHash = ToHexString(INITIAL_hash);
-
-        auto binaryHash = HexToBytes(rawCmsHash);
-        PoDoFo::charbuff binaryCharbuff;
-        binaryCharbuff.assign(reinterpret_cast<const char*>(binaryHash.data()), binaryHash.size());
+        _ltaCtx->StartSigning(_doc, _stream, _ltaResults, PoDoFo::PdfSaveOptions::NoMetadataUpdate);
 
-        auto base64Hash = ToBase64(binaryCharbuff);
-
-        auto urlEncodedHash = UrlEncode(base64Hash);
-
-        return base64Hash;
+        return ToBase64(_ltaResults.Intermediate[_ltaSignerId]);
     }
     catch (const std::exception& e)
     {
         std::cout << "\n=== Error in beginSigningLTA ===" << std::endl;
         std::cout << "Error: " << e.what() << std::endl;
-        _ltaDoc.reset();
         _ltaCtx.reset();
         _ltaSigner.reset();
         throw;
@@ -647,12 +719,13 @@ void PoDoFo::PdfRemoteSignDocumentSession::finishSigningLTA(const std::string& b
 {
     try
     {
-        if (!_ltaDoc || !_ltaCtx || !_ltaSigner || !_stream) {
+        if (!_ltaCtx || !_ltaSigner || !_stream) {
             throw std::runtime_error("LTA signing has not been started. Call beginSigningLTA() first.");
         }
 
         std::string tsr = DecodeBase64Tsr(base64Tsr);
         std::string timestampToken = ExtractTimestampTokenFromTSR(tsr);
+        TimestampSizeCache::instance().update(_sizeCacheKey + ":DocTimeStamp", timestampToken.size());
 
         PoDoFo::charbuff tokenContent;
         tokenContent.assign(timestampToken.data(), timestampToken.size());
@@ -661,16 +734,14 @@ void PoDoFo::PdfRemoteSignDocumentSession::finishSigningLTA(const std::string& b
         _ltaCtx->FinishSigning(_ltaResults);
 
         if (validationData.has_value() && !validationData->empty()) {
-            _stream->Seek(0, PoDoFo::SeekDirection::Begin);
-            PoDoFo::PdfMemDocument final_doc;
-            final_doc.Load(_stream);
-
-            createOrUpdateDSSCatalog(final_doc, *validationData);
+            auto dssStart = std::chrono::steady_clock::now();
+            size_t initialLength = _stream->GetLength();
+            createOrUpdateDSSCatalog(_doc, *validationData);
 
-            final_doc.SaveUpdate(*_stream, PoDoFo::PdfSaveOptions::NoMetadataUpdate | PoDoFo::PdfSaveOptions::NoFlateCompress);
+            _doc.SaveUpdate(*_stream, PoDoFo::PdfSaveOptions::NoMetadataUpdate | PoDoFo::PdfSaveOptions::NoFlateCompress);
+            reportMetrics(PdfSigningPhase::DssUpdate, dssStart, _stream->GetLength() - initialLength);
         }
 
-        _ltaDoc.reset();
         _ltaCtx.reset();
         _ltaSigner.reset();
     }
@@ -678,7 +749,6 @@ void PoDoFo::PdfRemoteSignDocumentSession::finishSigningLTA(const std::string& b
     {
         std::cout << "\n=== Error in finishSigningLTA ===" << std::endl;
         std::cout << "Error: " << e.what() << std::endl;
-        _ltaDoc.reset();
         _ltaCtx.reset();
         _ltaSigner.reset();
         throw;
@@ -796,19 +866,17 @@ std::string PoDoFo::PdfRemoteSignDocumentSession::extractIssuerCertFromTSR(const
 }
 
 std::string PoDoFo::PdfRemoteSignDocumentSession::getOCSPFromCertificate(const std::string& base64Cert, const std::string& base64IssuerCert) {
-    std::vector<unsigned char> decoded_cert = ConvertBase64PEMtoDER(std::optional<std::string>(base64Cert), std::nullopt);
-    std::vector<unsigned char> decoded_issuer = ConvertBase64PEMtoDER(std::optional<std::string>(base64IssuerCert), std::nullopt);
+    auto decoded_cert = DerCache::Instance().Get(base64Cert, [&] { return ConvertBase64PEMtoDER(base64Cert, std::nullopt); });
+    auto decoded_issuer = DerCache::Instance().Get(base64IssuerCert, [&] { return ConvertBase64PEMtoDER(base64IssuerCert, std::nullopt); });
 
-    const unsigned char* p = decoded_cert.data();
-    std::unique_ptr<X509, decltype(&X509_free)> cert(d2i_X509(nullptr, &p, decoded_cert.size()), X509_free);
-    if (!cert) throw std::runtime_error("Failed to parse DER certificate: " + std::string(ERR_reason_error_string(ERR_get_error())));
+    X509* cert = DerCache::GetCertificate(*decoded_cert);
+    if (!cert) throw std::runtime_error("Failed to parse DER certificate: " + decoded_cert->ParseError);
 
-    const unsigned char* pi = decoded_issuer.data();
-    std::unique_ptr<X509, decltype(&X509_free)> issuer(d2i_X509(nullptr, &pi, decoded_issuer.size()), X509_free);
-    if (!issuer) throw std::runtime_error("Failed to parse DER issuer certificate: " + std::string(ERR_reason_error_string(ERR_get_error())));
+    X509* issuer = DerCache::GetCertificate(*decoded_issuer);
+    if (!issuer) throw std::runtime_error("Failed to parse DER issuer certificate: " + decoded_issuer->ParseError);
 
     std::string ocsp_url;
-    AUTHORITY_INFO_ACCESS* info = (AUTHORITY_INFO_ACCESS*)X509_get_ext_d2i(cert.get(), NID_info_access, nullptr, nullptr);
+    AUTHORITY_INFO_ACCESS* info = (AUTHORITY_INFO_ACCESS*)X509_get_ext_d2i(cert, NID_info_access, nullptr, nullptr);
     if (info) {
         for (int i = 0; i < sk_ACCESS_DESCRIPTION_num(info); ++i) {
             ACCESS_DESCRIPTION* ad = sk_ACCESS_DESCRIPTION_value(info, i);
@@ -828,22 +896,20 @@ std::string PoDoFo::PdfRemoteSignDocumentSession::getOCSPFromCertificate(const s
 }
 
 std::string PoDoFo::PdfRemoteSignDocumentSession::buildOCSPRequestFromCertificates(const std::string& base64Cert, const std::string& base64IssuerCert) {
-    std::vector<unsigned char> decoded_cert = ConvertBase64PEMtoDER(std::optional<std::string>(base64Cert), std::nullopt);
-    std::vector<unsigned char> decoded_issuer = ConvertBase64PEMtoDER(std::optional<std::string>(base64IssuerCert), std::nullopt);
+    auto decoded_cert = DerCache::Instance().Get(base64Cert, [&] { return ConvertBase64PEMtoDER(base64Cert, std::nullopt); });
+    auto decoded_issuer = DerCache::Instance().Get(base64IssuerCert, [&] { return ConvertBase64PEMtoDER(base64IssuerCert, std::nullopt); });
 
-    const unsigned char* p = decoded_cert.data();
-    std::unique_ptr<X509, decltype(&X509_free)> cert(d2i_X509(nullptr, &p, decoded_cert.size()), X509_free);
-    if (!cert) throw std::runtime_error("Failed to parse DER certificate: " + std::string(ERR_reason_error_string(ERR_get_error())));
+    X509* cert = DerCache::GetCertificate(*decoded_cert);
+    if (!cert) throw std::runtime_error("Failed to parse DER certificate: " + decoded_cert->ParseError);
 
-    const unsigned char* pi = decoded_issuer.data();
-    std::unique_ptr<X509, decltype(&X509_free)> issuer(d2i_X509(nullptr, &pi, decoded_issuer.size()), X509_free);
-    if (!issuer) throw std::runtime_error("Failed to parse DER issuer certificate: " + std::string(ERR_reason_error_string(ERR_get_error())));
+    X509* issuer = DerCache::GetCertificate(*decoded_issuer);
+    if (!issuer) throw std::runtime_error("Failed to parse DER issuer certificate: " + decoded_issuer->ParseError);
 
     std::unique_ptr<OCSP_REQUEST, decltype(&OCSP_REQUEST_free)> req(OCSP_REQUEST_new(), OCSP_REQUEST_free);
     if (!req) throw std::runtime_error("Failed to allocate OCSP_REQUEST.");
 
     std::unique_ptr<OCSP_CERTID, decltype(&OCSP_CERTID_free)> id(
-        OCSP_cert_to_id(nullptr, cert.get(), issuer.get()), OCSP_CERTID_free);
+        OCSP_cert_to_id(nullptr, cert, issuer), OCSP_CERTID_free);
     if (!id) throw std::runtime_error("Failed to create OCSP_CERTID.");
 
     if (!OCSP_request_add0_id(req.get(), id.get())) throw std::runtime_error("Failed to add CertID to OCSP request.");
@@ -861,14 +927,13 @@ std::string PoDoFo::PdfRemoteSignDocumentSession::buildOCSPRequestFromCertificat
 }
 
 std::string PoDoFo::PdfRemoteSignDocumentSession::getCertificateIssuerUrlFromCertificate(const std::string& base64Cert) {
-    std::vector<unsigned char> decoded_cert = ConvertBase64PEMtoDER(std::optional<std::string>(base64Cert), std::nullopt);
+    auto decoded_cert = DerCache::Instance().Get(base64Cert, [&] { return ConvertBase64PEMtoDER(base64Cert, std::nullopt); });
 
-    const unsigned char* p = decoded_cert.data();
-    std::unique_ptr<X509, decltype(&X509_free)> cert(d2i_X509(nullptr, &p, decoded_cert.size()), X509_free);
-    if (!cert) throw std::runtime_error("Failed to parse DER certificate: " + std::string(ERR_reason_error_string(ERR_get_error())));
+    X509* cert = DerCache::GetCertificate(*decoded_cert);
+    if (!cert) throw std::runtime_error("Failed to parse DER certificate: " + decoded_cert->ParseError);
 
     std::string ca_issuer_url;
-    AUTHORITY_INFO_ACCESS* info = (AUTHORITY_INFO_ACCESS*)X509_get_ext_d2i(cert.get(), NID_info_access, nullptr, nullptr);
+    AUTHORITY_INFO_ACCESS* info = (AUTHORITY_INFO_ACCESS*)X509_get_ext_d2i(cert, NID_info_access, nullptr, nullptr);
     if (info) {
         for (int i = 0; i < sk_ACCESS_DESCRIPTION_num(info); ++i) {
             ACCESS_DESCRIPTION* ad = sk_ACCESS_DESCRIPTION_value(info, i);
@@ -947,97 +1012,174 @@ std::pair<std::string, std::string> PoDoFo::PdfRemoteSignDocumentSession::getOCS
     return { ocspUrl, base64_ocsp_request };
 }
 
-PoDoFo::PdfDocTimeStampSigner::PdfDocTimeStampSigner() : m_useManualByteRange(false) {}
-
-void PoDoFo::PdfDocTimeStampSigner::SetDevice(std::shared_ptr<PoDoFo::StreamDevice> device) {
-    m_device = device;
-    m_useManualByteRange = true;
+/**
+ * @brief Encodes DER bytes to base64 (no newlines), as expected by PdfRemoteSignDocumentSession
+ * @param der The DER bytes to encode
+ * @return Base64-encoded string
+ */
+static std::string EncodeDerBase64(const std::vector<unsigned char>& der) {
+    std::string encoded(utls::GetBase64EncodedSize(der.size()), '\0');
+    utls::EncodeBase64To(encoded, PoDoFo::bufferview(reinterpret_cast<const char*>(der.data()), der.size()));
+    return encoded;
 }
 
-void PoDoFo::PdfDocTimeStampSigner::Reset() {
-    m_hashBuffer.clear();
+PoDoFo::PdfRemoteSignBatchSession::PdfRemoteSignBatchSession(
+    const SigningRequest& request,
+    const std::optional<std::string>& rootEntityCertificateBase64,
+    const std::optional<std::string>& label
+)
+    : _started(false)
+{
+    if (request.documents.empty()) {
+        throw std::runtime_error("Signing request contains no documents");
+    }
+
+    std::string endCertificateBase64 = EncodeDerBase64(request.endEntityCertificate);
+    std::vector<std::string> certificateChainBase64;
+    certificateChainBase64.reserve(request.certificateChain.size());
+    for (const auto& cert : request.certificateChain)
+        certificateChainBase64.push_back(EncodeDerBase64(cert));
+
+    _sessions.reserve(request.documents.size());
+    for (const auto& document : request.documents) {
+        _sessions.push_back(std::make_unique<PdfRemoteSignDocumentSession>(
+            document.conformance_level,
+            request.hashAlgorithmOID,
+            document.document_input_path,
+            document.document_output_path,
+            endCertificateBase64,
+            certificateChainBase64,
+            rootEntityCertificateBase64,
+            label));
+    }
 }
 
-void PoDoFo::PdfDocTimeStampSigner::AppendData(const PoDoFo::bufferview& data) {
-    size_t oldSize = m_hashBuffer.size();
-    m_hashBuffer.append(data.data(), data.size());
+std::vector<std::string> PoDoFo::PdfRemoteSignBatchSession::beginSigning() {
+    if (_started) {
+        throw std::runtime_error("Batch signing has already been started");
+    }
 
-    static size_t lastEndPosition = 0;
-    if (oldSize > 0 && oldSize != lastEndPosition) {
-        size_t gap = oldSize - lastEndPosition;
+    std::vector<std::string> hashes;
+    hashes.reserve(_sessions.size());
+    for (size_t i = 0; i < _sessions.size(); ++i) {
+        try {
+            hashes.push_back(_sessions[i]->beginSigning());
+        }
+        catch (...) {
+            // Roll back the documents already prepared, so that
+            // no session is left started while the batch is not
+            for (size_t j = 0; j < i; ++j) {
+                try {
+                    _sessions[j]->discardSigning();
+                }
+                catch (const std::exception& e) {
+                    std::cout << "Failed to roll back document " << j << ": " << e.what() << std::endl;
+                }
+            }
+            throw;
+        }
     }
-    lastEndPosition = oldSize + data.size();
+
+    _started = true;
+    return hashes;
 }
 
-void PoDoFo::PdfDocTimeStampSigner::ComputeSignature(PoDoFo::charbuff& contents, bool dryrun) {
-    if (dryrun) {
-        contents.resize(6000); //TODO
+std::vector<std::exception_ptr> PoDoFo::PdfRemoteSignBatchSession::finishSigning(const std::vector<std::string>& signedHashes,
+    const std::vector<std::string>& base64Tsrs, const std::optional<ValidationData>& validationData) {
+    if (!_started) {
+        throw std::runtime_error("Batch signing has not been started. Call beginSigning() first.");
     }
-    else {}
-}
 
-void PoDoFo::PdfDocTimeStampSigner::FetchIntermediateResult(PoDoFo::charbuff& result) {
-    if (m_useManualByteRange && m_device) {
-        result = calculateCorrectHash();
+    if (signedHashes.size() != _sessions.size()) {
+        throw std::runtime_error("Expected " + std::to_string(_sessions.size()) + " signed hashes, got "
+            + std::to_string(signedHashes.size()));
     }
-    else {
-        PoDoFo::PdfHashingAlgorithm hashAlg = PoDoFo::PdfHashingAlgorithm::SHA256;
-        PoDoFo::bufferview dataView(m_hashBuffer.data(), m_hashBuffer.size());
-        result = ssl::ComputeHash(dataView, hashAlg);
+
+    if (!base64Tsrs.empty() && base64Tsrs.size() != _sessions.size()) {
+        throw std::runtime_error("Expected " + std::to_string(_sessions.size()) + " timestamp responses, got "
+            + std::to_string(base64Tsrs.size()));
     }
-}
 
-PoDoFo::charbuff PoDoFo::PdfDocTimeStampSigner::calculateCorrectHash() {
+    static const std::string noTsr;
+    std::vector<std::exception_ptr> errors(_sessions.size());
+    for (size_t i = 0; i < _sessions.size(); ++i) {
+        try {
+            _sessions[i]->finishSigning(signedHashes[i], base64Tsrs.empty() ? noTsr : base64Tsrs[i], validationData);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    }
 
-    m_device->Seek(0, PoDoFo::SeekDirection::End);
-    size_t fileSize = m_device->GetPosition();
+    _started = false;
+    return errors;
+}
 
-    m_device->Seek(0, PoDoFo::SeekDirection::Begin);
+PoDoFo::PdfDocTimeStampSigner::PdfDocTimeStampSigner() : m_mdCtx(nullptr), m_reservedSize(TimestampSizeCache::DefaultReserve) {}
 
-    PoDoFo::charbuff fileContent;
-    fileContent.resize(fileSize);
-    m_device->Read(fileContent.data(), fileSize);
+PoDoFo::PdfDocTimeStampSigner::~PdfDocTimeStampSigner() {
+    EVP_MD_CTX_free(m_mdCtx);
+}
 
-    std::string fileStr(fileContent.data(), fileContent.size());
+void PoDoFo::PdfDocTimeStampSigner::SetDevice(std::shared_ptr<PoDoFo::StreamDevice> device) {
+    (void)device;
+}
 
-    size_t byteRangePos = fileStr.find("/ByteRange[");
-    if (byteRangePos == std::string::npos) {
-        PoDoFo::PdfHashingAlgorithm hashAlg = PoDoFo::PdfHashingAlgorithm::SHA256;
-        PoDoFo::bufferview dataView(m_hashBuffer.data(), m_hashBuffer.size());
-        return ssl::ComputeHash(dataView, hashAlg);
-    }
+void PoDoFo::PdfDocTimeStampSigner::SetReservedSize(size_t size) {
+    m_reservedSize = size;
+}
 
-    size_t start = fileStr.find('[', byteRangePos) + 1;
-    size_t end = fileStr.find(']', start);
-    std::string byteRangeStr = fileStr.substr(start, end - start);
+void PoDoFo::PdfDocTimeStampSigner::Reset() {
+    ensureDigestInitialized(true);
+}
 
-    std::istringstream iss(byteRangeStr);
-    int64_t range1Start, range1Length, range2Start, range2Length;
-    iss >> range1Start >> range1Length >> range2Start >> range2Length;
+void PoDoFo::PdfDocTimeStampSigner::AppendData(const PoDoFo::bufferview& data) {
+    ensureDigestInitialized(false);
+    if (EVP_DigestUpdate(m_mdCtx, data.data(), data.size()) != 1)
+        throw std::runtime_error("Failed to update DocTimeStamp digest");
+}
 
+void PoDoFo::PdfDocTimeStampSigner::ComputeSignature(PoDoFo::charbuff& contents, bool dryrun) {
+    if (dryrun) {
+        contents.resize(6000); //TODO
+    }
+    else {}
+}
 
-    PoDoFo::charbuff correctData;
-    correctData.reserve(range1Length + range2Length);
+void PoDoFo::PdfDocTimeStampSigner::FetchIntermediateResult(PoDoFo::charbuff& result) {
+    // The signing context hashes the document in a single pass after
+    // writing all the /ByteRange(s), so the data appended is exactly
+    // the ByteRange of this signature
+    result = finalizeDigest();
+}
 
-    if (range1Length > 0) {
-        correctData.resize(range1Length);
-        std::memcpy(correctData.data(), fileContent.data() + range1Start, range1Length);
+void PoDoFo::PdfDocTimeStampSigner::ensureDigestInitialized(bool reinit) {
+    if (m_mdCtx == nullptr) {
+        m_mdCtx = EVP_MD_CTX_new();
+        if (m_mdCtx == nullptr)
+            throw std::runtime_error("Failed to create DocTimeStamp digest context");
+        reinit = true;
     }
 
-    if (range2Length > 0) {
-        size_t currentSize = correctData.size();
-        correctData.resize(currentSize + range2Length);
-        std::memcpy(correctData.data() + currentSize, fileContent.data() + range2Start, range2Length);
-    }
+    if (reinit && EVP_DigestInit_ex(m_mdCtx, ssl::GetEVP_MD(PoDoFo::PdfHashingAlgorithm::SHA256), nullptr) != 1)
+        throw std::runtime_error("Failed to initialize DocTimeStamp digest");
+}
+
+PoDoFo::charbuff PoDoFo::PdfDocTimeStampSigner::finalizeDigest() {
+    ensureDigestInitialized(false);
+    unsigned char md[EVP_MAX_MD_SIZE];
+    unsigned mdLen;
+    if (EVP_DigestFinal_ex(m_mdCtx, md, &mdLen) != 1)
+        throw std::runtime_error("Failed to finalize DocTimeStamp digest");
 
-    PoDoFo::PdfHashingAlgorithm hashAlg = PoDoFo::PdfHashingAlgorithm::SHA256;
-    PoDoFo::bufferview correctDataView(correctData.data(), correctData.size());
-    return ssl::ComputeHash(correctDataView, hashAlg);
+    // Leave the context ready for a new computation
+    ensureDigestInitialized(true);
+    return PoDoFo::charbuff(reinterpret_cast<const char*>(md), mdLen);
 }
 
 void PoDoFo::PdfDocTimeStampSigner::ComputeSignatureDeferred(const PoDoFo::bufferview& processedResult, PoDoFo::charbuff& contents, bool dryrun) {
     if (dryrun) {
-        contents.resize(20000);
+        contents.resize(m_reservedSize);
     }
     else {
         contents.assign(processedResult.data(), processedResult.size());
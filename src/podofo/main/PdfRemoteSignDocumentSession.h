@@ -25,11 +25,13 @@
 #include <string>
 #include <regex>
 #include <thread>
+#include <chrono>
 #include <filesystem>
 #include <map>
 #include <iostream>
 #include <iomanip>
 #include <utility>
+#include <exception>
 
 #include <podofo/podofo.h>
 #include <openssl/bio.h>
@@ -165,6 +167,15 @@ namespace PoDoFo {
         Unknown  /**< Not recognized */
     };
 
+    /**
+     * @brief How the signed document is produced from the input document.
+     */
+    enum class SigningOutputMode {
+        Copy,    /**< Clone the input to the output path (reflink when supported) and append the update there */
+        InPlace, /**< Append the incremental update directly to the input document; the output path is ignored */
+        Delta    /**< Write only the incremental update to the output path; the signed document is input + output */
+    };
+
     /**
      * @brief Simple document entry used by higher-level request structures.
      */
@@ -184,6 +195,29 @@ namespace PoDoFo {
         std::string                              hashAlgorithmOID;      /**< Digest OID string */
     };
 
+    /**
+     * @brief Thrown by finishSigning() when the timestamp token doesn't fit the room
+     * reserved in the signature.
+     *
+     * The remote signature can't be used, as the document hash depends on the size of
+     * the signature /Contents. The document has already been prepared again with room
+     * for the token: the new hash must be signed remotely, and timestamped again, before
+     * calling finishSigning() with the new values.
+     */
+    class PODOFO_API TimestampReserveExceededError : public std::runtime_error {
+    public:
+        /**
+         * @param hash URL-encoded base64 of the hash of the document prepared again.
+         */
+        explicit TimestampReserveExceededError(std::string hash);
+
+        /** @return URL-encoded base64 of the new hash to be signed remotely. */
+        const std::string& getHash() const { return _hash; }
+
+    private:
+        std::string _hash;
+    };
+
     /**
      * @brief Utility to read a file fully into a byte vector
      * @param path Path to the file to read
@@ -202,6 +236,7 @@ namespace PoDoFo {
      * Additional helpers support LTA DocTimeStamp creation and validation data embedding.
      */
     class PODOFO_API PdfRemoteSignDocumentSession final {
+        friend class PdfRemoteSignBatchSession;
     public:
         /**
          * @brief Construct a signing session with full configuration.
@@ -246,6 +281,32 @@ namespace PoDoFo {
          */
         ~PdfRemoteSignDocumentSession();
 
+        /**
+         * @brief Selects how the signed document is produced. Must be called before beginSigning().
+         * @param mode The output mode. The default is SigningOutputMode::Copy.
+         */
+        void setOutputMode(SigningOutputMode mode);
+
+        /**
+         * @brief Sets the URL of the TSA issuing the timestamp tokens. Must be called before beginSigning().
+         *
+         * The room reserved for the tokens is sized from the ones previously issued by the
+         * same TSA. If not set, the fixed 20000 bytes reservation is kept as a minimum, as
+         * the tokens may be larger than the ones seen from other TSAs.
+         * @param url The TSA URL, also used for the LTA DocTimeStamp.
+         */
+        void setTimestampAuthorityUrl(const std::string& url);
+
+        /**
+         * @brief Sets a handler receiving the duration and byte count of each signing phase.
+         *
+         * Load and DssUpdate are reported by the session, the other phases by the
+         * underlying PdfSigningContext, for both the signature and the LTA DocTimeStamp.
+         * The handler is called synchronously on the thread driving the session.
+         * @param handler The handler, or nullptr to disable reporting.
+         */
+        void setMetricsHandler(PdfSigningMetricsHandler handler);
+
         /**
          * @brief Start the signing process and compute the document hash to be signed remotely.
          * @return URL-encoded base64 of the hash that should be signed by a remote service.
@@ -256,6 +317,8 @@ namespace PoDoFo {
          * @param signedHash Base64-encoded signature/content returned by the remote signer.
          * @param base64Tsr Base64-encoded TimeStampResp (required for ADES_B_T, ADES_B_LT, ADES_B_LTA).
          * @param validationData Optional validation artifacts to embed into DSS.
+         * @throws TimestampReserveExceededError if the timestamp token is larger than the
+         *         room reserved for it. The session can be finished with the new hash.
          */
         void finishSigning(const std::string& signedHash, const std::string& base64Tsr, const std::optional<ValidationData>& validationData = std::nullopt);
 
@@ -347,31 +410,44 @@ namespace PoDoFo {
         std::string getCertificateIssuerUrlFromCertificate(const std::string& base64Cert);
 
     private:
+        /**
+         * @brief Opens the device the incremental updates will be appended to, according to the output mode.
+         */
+        void openOutputStream();
+        /**
+         * @brief Discards the prepared revision, restoring the output as it was before beginSigning().
+         */
+        void discardSigning();
+        /**
+         * @brief Reports a phase measured by the session to the metrics handler, if any.
+         */
+        void reportMetrics(PdfSigningPhase phase, std::chrono::steady_clock::time_point start, size_t byteCount);
         /**
          * @brief Create or update the DSS dictionary in the document with provided artifacts.
+         * Artifacts already present in the DSS arrays are not embedded again
          */
         void createOrUpdateDSSCatalog(PdfMemDocument& doc, const ValidationData& validationData);
         /**
          * @brief Creates a stream object for a certificate
          * @param doc The PDF document to add the stream to
-         * @param certBase64 Base64-encoded certificate data
+         * @param certDer DER-encoded certificate
          * @return Reference to the created stream object
          */
-        PdfObject& createCertificateStream(PdfMemDocument& doc, const std::string& certBase64);
+        PdfObject& createCertificateStream(PdfMemDocument& doc, const charbuff& certDer);
         /**
          * @brief Creates a stream object for a CRL
          * @param doc The PDF document to add the stream to
-         * @param crlBase64 Base64-encoded CRL data
+         * @param crlDer DER-encoded CRL
          * @return Reference to the created stream object
          */
-        PdfObject& createCRLStream(PdfMemDocument& doc, const std::string& crlBase64);
+        PdfObject& createCRLStream(PdfMemDocument& doc, const charbuff& crlDer);
         /**
          * @brief Creates a stream object for an OCSP response
          * @param doc The PDF document to add the stream to
-         * @param ocspBase64 Base64-encoded OCSP response data
+         * @param ocspDer DER-encoded OCSP response
          * @return Reference to the created stream object
          */
-        PdfObject& createOCSPStream(PdfMemDocument& doc, const std::string& ocspBase64);
+        PdfObject& createOCSPStream(PdfMemDocument& doc, const charbuff& ocspDer);
 
         /**
          * @brief Attempts to extract issuer certificate from TSR, with AIA fallback.
@@ -410,18 +486,6 @@ namespace PoDoFo {
          * @return Raw bytes of the decoded hash
          */
         charbuff ConvertDSSHashToSignedHash(const std::string& DSSHash);
-        /**
-         * @brief Converts hex string to byte vector
-         * @param hex The hex string to convert
-         * @return Vector of bytes
-         */
-        std::vector<unsigned char> HexToBytes(const std::string& hex);
-        /**
-         * @brief Converts raw buffer to lowercase hex string
-         * @param data The raw data to convert
-         * @return Lowercase hex string representation
-         */
-        std::string ToHexString(const charbuff& data);
         /**
          * @brief URL-encodes a string (RFC3986 unreserved kept)
          * @param value The string to URL-encode
@@ -443,6 +507,7 @@ namespace PoDoFo {
 
         std::string                                 _conformanceLevel;
         HashAlgorithm                               _hashAlgorithm;
+        SigningOutputMode                           _outputMode;
         std::string                                 _documentInputPath;
         std::string                                 _documentOutputPath;
         std::string                                 _endCertificateBase64;
@@ -456,16 +521,21 @@ namespace PoDoFo {
         std::vector<unsigned char>                  _rootCertificateDer;
         std::vector<unsigned char>                  _responseTsr;
 
+        // The document stays loaded across the signing, DSS and LTA updates
         PdfMemDocument                              _doc;
-        std::shared_ptr<FileStreamDevice>           _stream;
+        std::shared_ptr<StreamDevice>               _stream;
         PdfSignerCmsParams                          _cmsParams;
-        PdfSigningContext                           _ctx;
+        std::unique_ptr<PdfSigningContext>          _ctx;
         PdfSigningResults                           _results;
         PdfSignerId                                 _signerId;
         std::shared_ptr<PdfSignerCms>               _signer;
+        std::string                                 _sizeCacheKey;
+        size_t                                      _timestampReserve;  // Room reserved for the token, 0 for ADES_B_B
+        size_t                                      _inputLength;       // Length of the document before the signed revision
+        std::string                                 _timestampAuthorityUrl;
+        PdfSigningMetricsHandler                    _metricsHandler;
 
         // Members for LTA Signing Flow
-        std::unique_ptr<PdfMemDocument>             _ltaDoc;
         std::unique_ptr<PdfSigningContext>          _ltaCtx;
         std::shared_ptr<PdfSigner>                  _ltaSigner;
         PdfSignerId                                 _ltaSignerId;
@@ -485,17 +555,83 @@ namespace PoDoFo {
         static const char* hashAlgorithmToString(HashAlgorithm alg);
     };
 
+    /**
+     * @brief Remote signing session over all the documents of a `SigningRequest`.
+     *
+     * Holds one `PdfRemoteSignDocumentSession` per document, all sharing the same
+     * certificates and digest algorithm. beginSigning() prepares every document and
+     * returns all the hashes at once, so they can be sent to the remote signing
+     * service in a single round-trip. finishSigning() takes the signed values in the
+     * same order as the returned hashes.
+     *
+     * The documents are finished independently, so a failure of one document doesn't
+     * prevent the others from being signed and the outcome is reported per document.
+     */
+    class PODOFO_API PdfRemoteSignBatchSession final {
+    public:
+        /**
+         * @brief Construct a batch session from a signing request.
+         * @param request Documents, DER certificates and digest OID shared by all documents.
+         * @param rootEntityCertificateBase64 Optional root certificate, base64 DER.
+         * @param label Optional label for diagnostics.
+         * @throws std::runtime_error if the request contains no documents.
+         */
+        PdfRemoteSignBatchSession(
+            const SigningRequest& request,
+            const std::optional<std::string>& rootEntityCertificateBase64 = std::nullopt,
+            const std::optional<std::string>& label = std::nullopt
+        );
+
+        PdfRemoteSignBatchSession(const PdfRemoteSignBatchSession&) = delete;
+        PdfRemoteSignBatchSession& operator=(const PdfRemoteSignBatchSession&) = delete;
+
+        /**
+         * @brief Prepare all documents and compute the hashes to be signed remotely.
+         * @return URL-encoded base64 hashes, one per document, in request order.
+         * @throws the error of the first document that can't be prepared. The documents
+         *         prepared before it are rolled back, restoring their outputs, so beginSigning()
+         *         can be called again.
+         */
+        std::vector<std::string> beginSigning();
+        /**
+         * @brief Inject the remote signatures into all documents.
+         *
+         * Every document is finished, also after a failure of a previous one. The output
+         * of a failed document is left with an unsigned revision and must be discarded.
+         * @param signedHashes Base64-encoded signed values, in the order returned by beginSigning().
+         * @param base64Tsrs Base64-encoded TimeStampResp per document. May be empty
+         *        if all documents use ADES_B_B.
+         * @param validationData Optional validation artifacts to embed into the DSS of every document.
+         * @return The error of each document in request order, null for the signed documents.
+         * @throws std::runtime_error if the number of values doesn't match the number of documents.
+         */
+        [[nodiscard]] std::vector<std::exception_ptr> finishSigning(const std::vector<std::string>& signedHashes,
+            const std::vector<std::string>& base64Tsrs = {},
+            const std::optional<ValidationData>& validationData = std::nullopt);
+
+        /** @return Number of documents in the batch. */
+        size_t size() const { return _sessions.size(); }
+        /**
+         * @brief Access the session of a single document, e.g. for the LTA flow.
+         * @param index Document index, in request order.
+         */
+        PdfRemoteSignDocumentSession& getSession(size_t index) { return *_sessions.at(index); }
+
+    private:
+        std::vector<std::unique_ptr<PdfRemoteSignDocumentSession>> _sessions;
+        bool _started;
+    };
+
     /**
      * @brief Custom signer implementing RFC3161 DocTimeStamp behavior.
      *
-     * Computes the correct hash over the ByteRange of the PDF and accepts an external
-     * timestamp token to be embedded as the signature contents.
+     * Digests the ByteRange of the PDF, as fed by the signing context, and accepts an
+     * external timestamp token to be embedded as the signature contents.
      */
     class PODOFO_API PdfDocTimeStampSigner : public PdfSigner {
     private:
-        charbuff m_hashBuffer;
-        std::shared_ptr<StreamDevice> m_device;
-        bool m_useManualByteRange;
+        EVP_MD_CTX* m_mdCtx;
+        size_t m_reservedSize;
 
     public:
         /**
@@ -503,16 +639,26 @@ namespace PoDoFo {
          */
         PdfDocTimeStampSigner();
         /**
-         * @brief Provides the underlying stream device to allow manual ByteRange hashing
+         * @brief Releases the digest context
+         */
+        ~PdfDocTimeStampSigner();
+        /**
+         * @brief Ignored: the signing context feeds exactly the ByteRange to AppendData()
          * @param device Shared pointer to the stream device
+         * \deprecated The device is not read by the signer anymore
          */
         void SetDevice(std::shared_ptr<StreamDevice> device);
         /**
-         * @brief Resets internal buffers
+         * @brief Sets the space reserved in the signature /Contents for the timestamp token
+         * @param size Size of the token in bytes, 20000 by default
+         */
+        void SetReservedSize(size_t size);
+        /**
+         * @brief Restarts the incremental digest
          */
         void Reset() override;
         /**
-         * @brief Appends PDF bytes to internal buffer (used in non-manual mode)
+         * @brief Feeds the ByteRange bytes to the incremental digest
          * @param data The data to append
          */
         void AppendData(const bufferview& data) override;
@@ -523,17 +669,20 @@ namespace PoDoFo {
          */
         void ComputeSignature(charbuff& contents, bool dryrun) override;
         /**
-         * @brief Computes intermediate hash result (manual ByteRange if possible)
+         * @brief Finalizes the digest of the ByteRange as the intermediate result
          * @param result Reference to store the intermediate result
          */
         void FetchIntermediateResult(charbuff& result) override;
 
     private:
         /**
-         * @brief Computes hash over the exact ByteRange of the current PDF in the device
-         * @return The calculated hash
+         * @brief Lazily creates the digest context and initializes it if requested
+         */
+        void ensureDigestInitialized(bool reinit);
+        /**
+         * @brief Finalizes the incremental digest
          */
-        charbuff calculateCorrectHash();
+        charbuff finalizeDigest();
         /**
          * @brief Injects externally-computed token into signature contents
          * @param processedResult The processed result data
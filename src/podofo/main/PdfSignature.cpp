@@ -114,6 +114,7 @@ void PdfSignature::PrepareForSigning(const string_view& filter,
     // Prepare byte range data
     PdfData byteRangeData = PdfData(beacons.ByteRangeBeacon, beacons.ByteRangeOffset);
     m_ValueObj->GetDictionary().AddKey("ByteRange"_n, PdfVariant(std::move(byteRangeData)));
+    m_ByteRangeOffset = beacons.ByteRangeOffset;
 }
 
 void PdfSignature::SetSignatureLocation(nullable<const PdfString&> text)
@@ -253,6 +254,14 @@ bool PdfSignature::TryGetPreviousRevision(InputStreamDevice& input, OutputStream
     return true;
 }
 
+nullable<size_t> PdfSignature::GetByteRangeOffset() const
+{
+    if (m_ByteRangeOffset == nullptr)
+        return { };
+
+    return *m_ByteRangeOffset;
+}
+
 PdfObject* PdfSignature::getValueObject() const
 {
     return m_ValueObj;
@@ -125,6 +125,13 @@ public:
      */
     bool TryGetPreviousRevision(InputStreamDevice& input, OutputStreamDevice& output) const;
 
+    /** Get the offset of the /ByteRange array, as recorded
+     *  when the document was last written for signing
+     *
+     *  \returns the offset, or null if the signature was never prepared for signing
+     */
+    nullable<size_t> GetByteRangeOffset() const;
+
 protected:
     PdfObject* getValueObject() const override;
 
@@ -156,6 +163,7 @@ private:
 
 private:
     PdfObject* m_ValueObj;
+    std::shared_ptr<size_t> m_ByteRangeOffset;
 };
 
 }
@@ -12,8 +12,6 @@
 using namespace std;
 using namespace PoDoFo;
 
-constexpr unsigned RSASignedHashSize = 256;
-
 PdfSignerCms::PdfSignerCms(const bufferview& cert, const std::vector<charbuff>& chain, const PdfSignerCmsParams& parameters) :
     PdfSignerCms(cert, { }, chain, parameters)
 {
@@ -63,8 +61,9 @@ void PdfSignerCms::ComputeSignature(charbuff& contents, bool dryrun)
     }
     else
     {
-        // Just prepare a fake result with the size of RSA block
-        m_encryptedHash.resize(RSASignedHashSize);
+        // Just prepare a fake result with the maximum size
+        // of a signature made with the certificate key
+        m_encryptedHash.resize(m_cmsContext->GetSignedHashMaxSize());
     }
 
     if (m_parameters.SignedHashHandler != nullptr)
@@ -90,10 +89,11 @@ void PdfSignerCms::ComputeSignatureDeferred(const bufferview& processedResult, c
 
     if (dryrun)
     {
-        // Just prepare a fake result with the size of RSA block
+        // Just prepare a fake result with the maximum size
+        // of a signature made with the certificate key
         charbuff fakeresult;
         m_cmsContext->ComputeHashToSign(fakeresult);
-        fakeresult.resize(RSASignedHashSize);
+        fakeresult.resize(m_cmsContext->GetSignedHashMaxSize());
         m_cmsContext->ComputeSignature(fakeresult, contents);
         if (m_reservedSize != 0)
             contents.resize(contents.size() + m_reservedSize);
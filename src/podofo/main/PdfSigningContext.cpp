@@ -15,9 +15,8 @@ constexpr const char* ByteRangeBeacon = "[ 0 1234567890 1234567890 1234567890]";
 constexpr size_t BufferSize = 65536;
 
 static PdfSignature& getSignature(PdfDocument& doc, int pageIndex, const PdfReference& signatureRef);
-static size_t readForSignature(StreamDevice& device,
-    size_t conentsBeaconOffset, size_t conentsBeaconSize,
-    char* buffer, size_t size);
+static void appendChunkForSigning(PdfSigner& signer, const char* buffer, size_t bufferOffset,
+    size_t size, size_t conentsBeaconOffset, size_t conentsBeaconSize);
 static void adjustByteRange(StreamDevice& device, size_t byteRangeOffset,
     size_t conentsBeaconOffset, size_t conentsBeaconSize, PdfArray& byteRangeArr, charbuff& buffer);
 static void setSignature(StreamDevice& device, const string_view& sigData,
@@ -78,6 +77,11 @@ void PdfSigningContext::FinishSigning(const PdfSigningResults& processedResults)
     m_contexts.clear();
 }
 
+void PdfSigningContext::SetMetricsHandler(PdfSigningMetricsHandler handler)
+{
+    m_metricsHandler = std::move(handler);
+}
+
 void PdfSigningContext::Sign(PdfMemDocument& doc, StreamDevice& device, PdfSaveOptions saveOptions)
 {
     ensureNotStarted();
@@ -156,6 +160,8 @@ unordered_map<PdfSignerId, PdfSigningContext::SignatureCtx> PdfSigningContext::p
 
 void PdfSigningContext::saveDocForSigning(PdfMemDocument& doc, StreamDevice& device, PdfSaveOptions saveOptions)
 {
+    auto start = chrono::steady_clock::now();
+    size_t initialLength = device.GetLength();
     auto& form = doc.GetOrCreateAcroForm();
     auto sigFlags = form.GetSigFlags();
     if ((sigFlags & (PdfAcroFormSigFlags::SignaturesExist | PdfAcroFormSigFlags::AppendOnly))
@@ -180,45 +186,74 @@ void PdfSigningContext::saveDocForSigning(PdfMemDocument& doc, StreamDevice& dev
         doc.SaveUpdate(device, saveOptions);
 
     device.Flush();
+    reportMetrics(PdfSigningPhase::Save, start, device.GetLength() - initialLength);
 }
 
 void PdfSigningContext::appendDataForSigning(unordered_map<PdfSignerId, SignatureCtx>& contexts, StreamDevice& device,
     std::unordered_map<PdfSignerId, charbuff>* intermediateResults, charbuff& tmpbuff)
 {
+    auto start = chrono::steady_clock::now();
+
+    // The /ByteRange(s) are part of the signed data, so
+    // adjust all of them before reading the device
     for (auto& pair : m_signers)
     {
         auto& attrs = pair.second;
         for (unsigned i = 0; i < attrs.Signers.size(); i++)
         {
-            PdfSignerId signerId(pair.first, i);
-            auto& signer = attrs.Signers[i];
-            auto& ctx = contexts[signerId];
-
+            auto& ctx = contexts[PdfSignerId(pair.first, i)];
             adjustByteRange(device, *ctx.Beacons.ByteRangeOffset, *ctx.Beacons.ContentsOffset,
                 ctx.Beacons.ContentsBeacon.size(), ctx.ByteRangeArr, tmpbuff);
-            device.Flush();
+            attrs.Signers[i]->Reset();
+        }
+    }
+    device.Flush();
 
-            // Read data from the device to prepare the signature
-            signer->Reset();
-            device.Seek(0);
-            size_t readBytes;
-            tmpbuff.resize(BufferSize);
-            while ((readBytes = readForSignature(device, *ctx.Beacons.ContentsOffset, ctx.Beacons.ContentsBeacon.size(),
-                tmpbuff.data(), BufferSize)) != 0)
+    // Read data from the device only once to prepare the signatures,
+    // fanning out each chunk to all the signers, each one
+    // skipping its own /Contents beacon
+    device.Seek(0);
+    tmpbuff.resize(BufferSize);
+    size_t offset = 0;
+    size_t readBytes;
+    bool eof;
+    while ((readBytes = device.Read(tmpbuff.data(), BufferSize, eof)) != 0)
+    {
+        for (auto& pair : m_signers)
+        {
+            auto& attrs = pair.second;
+            for (unsigned i = 0; i < attrs.Signers.size(); i++)
             {
-                signer->AppendData({ tmpbuff.data(), readBytes });
+                auto& ctx = contexts[PdfSignerId(pair.first, i)];
+                appendChunkForSigning(*attrs.Signers[i], tmpbuff.data(), offset, readBytes,
+                    *ctx.Beacons.ContentsOffset, ctx.Beacons.ContentsBeacon.size());
             }
+        }
 
-            if (intermediateResults != nullptr)
-                signer->FetchIntermediateResult((*intermediateResults)[signerId]);
+        offset += readBytes;
+        if (eof)
+            break;
+    }
+
+    if (intermediateResults != nullptr)
+    {
+        for (auto& pair : m_signers)
+        {
+            auto& attrs = pair.second;
+            for (unsigned i = 0; i < attrs.Signers.size(); i++)
+                attrs.Signers[i]->FetchIntermediateResult((*intermediateResults)[PdfSignerId(pair.first, i)]);
         }
     }
+
+    reportMetrics(PdfSigningPhase::Hash, start, offset);
 }
 
 void PdfSigningContext::computeSignatures(unordered_map<PdfSignerId, SignatureCtx>& contexts,
     PdfDocument& doc, StreamDevice& device,
     const PdfSigningResults* processedResults, charbuff& tmpbuff)
 {
+    auto start = chrono::steady_clock::now();
+    size_t writtenBytes = 0;
     for (auto& pair : m_signers)
     {
         auto& attrs = pair.second;
@@ -246,49 +281,41 @@ void PdfSigningContext::computeSignatures(unordered_map<PdfSignerId, SignatureCt
             ctx.Contents.resize(ctx.BeaconSize);
             setSignature(device, ctx.Contents, *ctx.Beacons.ContentsOffset, tmpbuff);
             device.Flush();
+            writtenBytes += ctx.Beacons.ContentsBeacon.size();
 
             // Finally set actual /ByteRange on the signature without dirty set
             signature.SetContentsByteRangeNoDirtySet(ctx.Contents, std::move(ctx.ByteRangeArr));
         }
     }
+
+    reportMetrics(PdfSigningPhase::ComputeSignature, start, writtenBytes);
 }
 
-size_t readForSignature(StreamDevice& device, size_t conentsBeaconOffset, size_t conentsBeaconSize,
-    char* buffer, size_t bufferSize)
+void PdfSigningContext::reportMetrics(PdfSigningPhase phase, chrono::steady_clock::time_point start, size_t byteCount)
 {
-    if (device.Eof())
-        return 0;
-
-    size_t pos = device.GetPosition();
-    size_t readSize = 0;
-    // Check if we are before beacon
-    if (pos < conentsBeaconOffset)
-    {
-        readSize = std::min(bufferSize, conentsBeaconOffset - pos);
-        if (readSize > 0)
-        {
-            device.Read(buffer, readSize);
-            buffer += readSize;
-            bufferSize -= readSize;
-            if (bufferSize == 0)
-                return readSize;
-        }
-    }
+    if (m_metricsHandler == nullptr)
+        return;
+
+    PdfSigningPhaseMetrics metrics;
+    metrics.Phase = phase;
+    metrics.Duration = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+    metrics.ByteCount = byteCount;
+    m_metricsHandler(metrics);
+}
 
-    // shift at the end of beacon
-    if ((pos + readSize) >= conentsBeaconOffset
-        && pos < (conentsBeaconOffset + conentsBeaconSize))
-    {
-        device.Seek(conentsBeaconOffset + conentsBeaconSize);
-    }
+void appendChunkForSigning(PdfSigner& signer, const char* buffer, size_t bufferOffset,
+    size_t size, size_t conentsBeaconOffset, size_t conentsBeaconSize)
+{
+    size_t bufferEnd = bufferOffset + size;
 
-    // read after beacon
-    bufferSize = std::min(bufferSize, device.GetLength() - device.GetPosition());
-    if (bufferSize == 0)
-        return readSize;
+    // Append the part before the beacon
+    if (bufferOffset < conentsBeaconOffset)
+        signer.AppendData({ buffer, std::min(size, conentsBeaconOffset - bufferOffset) });
 
-    device.Read(buffer, bufferSize);
-    return readSize + bufferSize;
+    // Append the part after the beacon
+    size_t afterOffset = std::max(bufferOffset, conentsBeaconOffset + conentsBeaconSize);
+    if (afterOffset < bufferEnd)
+        signer.AppendData({ buffer + (afterOffset - bufferOffset), bufferEnd - afterOffset });
 }
 
 void adjustByteRange(StreamDevice& device, size_t byteRangeOffset,
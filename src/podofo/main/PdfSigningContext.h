@@ -7,6 +7,8 @@
 #ifndef PDF_SIGNING_CONTEXT_H
 #define PDF_SIGNING_CONTEXT_H
 
+#include <chrono>
+
 #include "PdfSigner.h"
 
 namespace PoDoFo
@@ -61,6 +63,33 @@ namespace PoDoFo
         std::unordered_map<PdfSignerId, charbuff> Intermediate;
     };
 
+    /** Phases of a signing procedure reported to a PdfSigningMetricsHandler
+     */
+    enum class PdfSigningPhase : uint8_t
+    {
+        Load = 1,           ///< Parsing of the document to sign. Reported only by higher level APIs
+        Save,               ///< Writing of the update with the signature placeholders
+        Hash,               ///< Reading back the document and feeding the signed ranges to the signers
+        ComputeSignature,   ///< Computing the signatures and writing them into the /Contents
+        DssUpdate,          ///< Appending the validation material. Reported only by higher level APIs
+    };
+
+    /** Timing and size of a completed signing phase
+     */
+    struct PODOFO_API PdfSigningPhaseMetrics final
+    {
+        PdfSigningPhase Phase = PdfSigningPhase::Load;
+        std::chrono::nanoseconds Duration{ };
+        /** Bytes processed by the phase: the document size for Load, the
+         * bytes read back for Hash and the bytes written for the others
+         */
+        size_t ByteCount = 0;
+    };
+
+    /** Called synchronously on the signing thread when a phase completes
+     */
+    using PdfSigningMetricsHandler = std::function<void(const PdfSigningPhaseMetrics& metrics)>;
+
     /**
      * A context that can be used to customize the signing process.
      * It also enables the deferred (aka "async") signing, which is a mean to separately process
@@ -72,6 +101,7 @@ namespace PoDoFo
     {
         friend PODOFO_API void SignDocument(PdfMemDocument& doc, StreamDevice& device, PdfSigner& signer,
             PdfSignature& signature, PdfSaveOptions saveOptions);
+        PODOFO_PRIVATE_FRIEND(class PdfSigningContextTest);
     public:
         PdfSigningContext();
 
@@ -94,6 +124,12 @@ namespace PoDoFo
          */
         void FinishSigning(const PdfSigningResults& processedResults);
 
+        /** Set a handler that receives the timings and byte counts
+         * of the Save, Hash and ComputeSignature phases
+         * \param handler the handler, or nullptr to disable reporting
+         */
+        void SetMetricsHandler(PdfSigningMetricsHandler handler);
+
     private:
         struct SignatureAttrs
         {
@@ -125,6 +161,7 @@ namespace PoDoFo
         void computeSignatures(std::unordered_map<PdfSignerId, SignatureCtx>& contexts,
             PdfDocument& doc, StreamDevice& device,
             const PdfSigningResults* processedResults, charbuff& tmpbuff);
+        void reportMetrics(PdfSigningPhase phase, std::chrono::steady_clock::time_point start, size_t byteCount);
 
     private:
         PdfSigningContext(const PdfSigningContext&) = delete;
@@ -136,6 +173,7 @@ namespace PoDoFo
         PdfMemDocument* m_doc;
         std::shared_ptr<StreamDevice> m_device;
         std::unordered_map<PdfSignerId, SignatureCtx> m_contexts;
+        PdfSigningMetricsHandler m_metricsHandler;
     };
 }
 
@@ -0,0 +1,148 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#include <podofo/private/PdfDeclarationsPrivate.h>
+#include "PdfSigningPipeline.h"
+#include <podofo/auxiliary/StreamDevice.h>
+#include <podofo/private/FileSystem.h>
+
+using namespace std;
+using namespace PoDoFo;
+
+PdfSigningPipeline::PdfSigningPipeline(unsigned workerCount, unsigned maxResidentDocuments)
+    : m_resident(0), m_enqueuedCount(0), m_stopping(false)
+{
+    if (workerCount == 0)
+        workerCount = std::max(1u, thread::hardware_concurrency());
+
+    m_maxResident = maxResidentDocuments == 0 ? workerCount : maxResidentDocuments;
+    m_workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; i++)
+        m_workers.emplace_back(&PdfSigningPipeline::workerLoop, this);
+}
+
+PdfSigningPipeline::~PdfSigningPipeline()
+{
+    {
+        unique_lock<mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_resident == 0; });
+        m_stopping = true;
+    }
+    m_jobAvailable.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+size_t PdfSigningPipeline::Enqueue(PdfSigningJob job)
+{
+    if (job.Prepare == nullptr)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::InvalidHandle, "The signing job must have a preparation function");
+
+    size_t jobIndex;
+    {
+        unique_lock<mutex> lock(m_mutex);
+        // Back-pressure: don't allow more than the configured
+        // number of documents to be queued or processed at once
+        m_slotAvailable.wait(lock, [this] { return m_resident < m_maxResident; });
+        jobIndex = m_enqueuedCount++;
+        m_resident++;
+        m_queue.emplace_back(jobIndex, std::move(job));
+    }
+    m_jobAvailable.notify_one();
+    return jobIndex;
+}
+
+void PdfSigningPipeline::Wait()
+{
+    exception_ptr error;
+    {
+        unique_lock<mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_resident == 0; });
+        error = std::move(m_firstError);
+        m_firstError = nullptr;
+    }
+
+    if (error != nullptr)
+        rethrow_exception(error);
+}
+
+void PdfSigningPipeline::SetCompletedHandler(PdfSigningJobCompletedHandler handler)
+{
+    unique_lock<mutex> lock(m_mutex);
+    m_completedHandler = std::move(handler);
+}
+
+void PdfSigningPipeline::workerLoop()
+{
+    while (true)
+    {
+        pair<size_t, PdfSigningJob> job;
+        PdfSigningJobCompletedHandler handler;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_jobAvailable.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty())
+                return;
+
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+            handler = m_completedHandler;
+        }
+
+        exception_ptr error;
+        try
+        {
+            processJob(job.second);
+        }
+        catch (...)
+        {
+            error = current_exception();
+        }
+
+        if (handler != nullptr)
+        {
+            try
+            {
+                handler(job.first, error);
+            }
+            catch (...)
+            {
+                // Don't let the handler kill the worker
+            }
+        }
+
+        {
+            unique_lock<mutex> lock(m_mutex);
+            if (error != nullptr && handler == nullptr && m_firstError == nullptr)
+                m_firstError = error;
+
+            m_resident--;
+            if (m_resident == 0)
+                m_idle.notify_all();
+        }
+        m_slotAvailable.notify_one();
+    }
+}
+
+void PdfSigningPipeline::processJob(PdfSigningJob& job)
+{
+    string_view path = job.InputPath;
+    if (!job.OutputPath.empty())
+    {
+        fs::copy_file(fs::u8path(job.InputPath), fs::u8path(job.OutputPath), fs::copy_options::overwrite_existing);
+        path = job.OutputPath;
+    }
+
+    // Each job owns its document and device, so no
+    // state is shared with the other workers
+    auto device = std::make_shared<FileStreamDevice>(path, FileMode::Open);
+    PdfMemDocument doc;
+    doc.Load(device);
+
+    PdfSigningContext ctx;
+    job.Prepare(doc, ctx);
+    ctx.Sign(doc, *device, job.SaveOptions);
+}
@@ -0,0 +1,105 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#ifndef PDF_SIGNING_PIPELINE_H
+#define PDF_SIGNING_PIPELINE_H
+
+#include "PdfSigningContext.h"
+
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace PoDoFo
+{
+    /** A single document to be signed by a PdfSigningPipeline
+     */
+    struct PODOFO_API PdfSigningJob final
+    {
+        std::string InputPath;
+        /** The path where the signed document will be written. The input
+         * is copied there before signing. If empty, the input is signed in place
+         */
+        std::string OutputPath;
+        /** Called on the worker thread with the loaded document. It must
+         * create/retrieve the signature field(s) and configure the signers on the context
+         */
+        std::function<void(PdfMemDocument& doc, PdfSigningContext& ctx)> Prepare;
+        PdfSaveOptions SaveOptions = PdfSaveOptions::None;
+    };
+
+    /** Called on the worker thread when a job has been completed
+     * \param jobIndex the index of the job, in enqueuing order
+     * \param error the exception thrown while processing the job, or null on success
+     */
+    using PdfSigningJobCompletedHandler = std::function<void(size_t jobIndex, std::exception_ptr error)>;
+
+    /**
+     * Signs a queue of documents on a fixed size pool of worker threads.
+     * Each worker owns the PdfMemDocument and the StreamDevice of the
+     * job it's processing and runs load, preparation for signing,
+     * hashing and signature injection with a PdfSigningContext
+     * \remarks Enqueue() blocks when the number of queued and in-flight
+     *      documents reaches the maximum number of resident documents
+     */
+    class PODOFO_API PdfSigningPipeline final
+    {
+    public:
+        /**
+         * \param workerCount number of worker threads. If 0, std::thread::hardware_concurrency() is used
+         * \param maxResidentDocuments maximum number of queued or in-flight documents.
+         *      If 0, it's the same as the number of workers
+         */
+        PdfSigningPipeline(unsigned workerCount = 0, unsigned maxResidentDocuments = 0);
+
+        /** Waits for all the enqueued jobs to complete and stops the workers
+         */
+        ~PdfSigningPipeline();
+
+    public:
+        /** Enqueue a document to be signed, blocking until there's room for it
+         * \returns the index of the job
+         */
+        size_t Enqueue(PdfSigningJob job);
+
+        /** Wait for all the enqueued jobs to complete
+         * \remarks it rethrows the error of the first failed job, if any
+         * and if no completed handler was set
+         */
+        void Wait();
+
+        /** Set a handler to be notified of job completion, also for failed jobs
+         */
+        void SetCompletedHandler(PdfSigningJobCompletedHandler handler);
+
+        unsigned GetWorkerCount() const { return (unsigned)m_workers.size(); }
+
+    private:
+        void workerLoop();
+        static void processJob(PdfSigningJob& job);
+
+    private:
+        PdfSigningPipeline(const PdfSigningPipeline&) = delete;
+        PdfSigningPipeline& operator=(const PdfSigningPipeline&) = delete;
+
+    private:
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_jobAvailable;
+        std::condition_variable m_slotAvailable;
+        std::condition_variable m_idle;
+        std::deque<std::pair<size_t, PdfSigningJob>> m_queue;
+        PdfSigningJobCompletedHandler m_completedHandler;
+        std::exception_ptr m_firstError;
+        unsigned m_maxResident;
+        unsigned m_resident;
+        size_t m_enqueuedCount;
+        bool m_stopping;
+    };
+}
+
+#endif // PDF_SIGNING_PIPELINE_H
@@ -19,7 +19,55 @@
 using namespace std;
 using namespace PoDoFo;
 
+namespace
+{
+    // Reads the characters through the device interface
+    class DeviceCharReader final
+    {
+    public:
+        DeviceCharReader(InputStreamDevice& device)
+            : m_device(&device) { }
+
+        bool Read(char& ch) { return m_device->Read(ch); }
+
+    private:
+        InputStreamDevice* m_device;
+    };
+
+    // Reads the characters directly from the contiguous
+    // contents of a device, starting from its current position
+    class ViewCharReader final
+    {
+    public:
+        ViewCharReader(const string_view& view, size_t position)
+            : m_view(view), m_Position(position) { }
+
+        bool Read(char& ch)
+        {
+            if (m_Position == m_view.size())
+            {
+                ch = '\0';
+                return false;
+            }
+
+            ch = m_view[m_Position];
+            m_Position++;
+            return true;
+        }
+
+        size_t GetPosition() const { return m_Position; }
+
+    private:
+        string_view m_view;
+        size_t m_Position;
+    };
+}
+
 static bool tryGetEscapedCharacter(char ch, char& escapedChar);
+template <typename TReader>
+static void readString(TReader& reader, charbuff& buffer);
+template <typename TReader>
+static void readHexString(TReader& reader, charbuff& buffer);
 static void readHexString(InputStreamDevice& device, charbuff& buffer);
 static bool isOctalChar(char ch);
 
@@ -68,6 +116,10 @@ bool PdfTokenizer::TryReadNextToken(InputStreamDevice& device, string_view& toke
         return true;
     }
 
+    string_view view;
+    if (device.TryGetView(view))
+        return tryReadNextToken(device, view, token, tokenType);
+
     tokenType = PdfTokenType::Literal;
 
     char ch1;
@@ -180,6 +232,104 @@ Eof:
     goto Exit;
 }
 
+// Same as the device based tokenization above, but scanning the contents
+// in memory. The token points directly into the contents, with no copy
+bool PdfTokenizer::tryReadNextToken(InputStreamDevice& device, const string_view& view,
+    string_view& token, PdfTokenType& tokenType)
+{
+    const char* data = view.data();
+    size_t length = view.size();
+    size_t maxTokenSize = m_buffer->size() - 1;
+    size_t pos = device.GetPosition();
+    tokenType = PdfTokenType::Literal;
+
+    // Skip leading whitespaces and comments
+    while (true)
+    {
+        if (pos >= length)
+        {
+            device.Seek(length);
+            token = { };
+            return false;
+        }
+
+        char ch = data[pos];
+        if (IsCharWhitespace(ch))
+        {
+            pos++;
+        }
+        else if (ch == '%')
+        {
+            do
+            {
+                pos++;
+            } while (pos < length && data[pos] != '\n' && data[pos] != '\r');
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    size_t start = pos;
+    size_t end;
+    char ch1 = data[pos];
+    if (ch1 == '<' || ch1 == '>')
+    {
+        pos++;
+        if (pos == length)
+            goto Exit;
+
+        if (data[pos] != ch1)
+        {
+            tokenType = ch1 == '<' ? PdfTokenType::AngleBracketLeft : PdfTokenType::AngleBracketRight;
+            goto Exit;
+        }
+
+        pos++;
+        if ((int)m_options.LanguageLevel >= 2)
+        {
+            tokenType = ch1 == '<' ? PdfTokenType::DoubleAngleBracketsLeft : PdfTokenType::DoubleAngleBracketsRight;
+            goto Exit;
+        }
+    }
+
+    while (pos < length && pos - start < maxTokenSize)
+    {
+        ch1 = data[pos];
+        if (pos != start && ch1 == '%')
+        {
+            // Comments are token-delimiting whitespace: skip
+            // the comment and return the token read so far
+            end = pos;
+            do
+            {
+                pos++;
+            } while (pos < length && data[pos] != '\n' && data[pos] != '\r');
+            goto ExitWithEnd;
+        }
+        else if (pos != start && (IsCharWhitespace(ch1) || IsCharDelimiter(ch1)))
+        {
+            break;
+        }
+
+        pos++;
+        PdfTokenType tokenDelimiterType;
+        if (IsCharTokenDelimiter(ch1, tokenDelimiterType))
+        {
+            tokenType = tokenDelimiterType;
+            break;
+        }
+    }
+
+Exit:
+    end = pos;
+ExitWithEnd:
+    device.Seek(pos);
+    token = string_view(data + start, end - start);
+    return true;
+}
+
 bool PdfTokenizer::TryPeekNextToken(InputStreamDevice& device, string_view& token)
 {
     PdfTokenType tokenType;
@@ -280,20 +430,17 @@ PdfTokenizer::PdfLiteralDataType PdfTokenizer::DetermineDataType(InputStreamDevi
             }
 
             PdfLiteralDataType dataType = PdfLiteralDataType::Number;
-            const char* start = token.data();
-            while (*start)
+            for (char ch : token)
             {
-                if (*start == '.')
+                if (ch == '.')
                 {
                     dataType = PdfLiteralDataType::Real;
                 }
-                else if (!(isdigit(*start) || *start == '-' || *start == '+'))
+                else if (!(isdigit(ch) || ch == '-' || ch == '+'))
                 {
                     dataType = PdfLiteralDataType::Unknown;
                     break;
                 }
-
-                start++;
             }
 
             if (dataType == PdfLiteralDataType::Real)
@@ -447,7 +594,8 @@ void PdfTokenizer::ReadDictionary(InputStreamDevice& device, PdfVariant& variant
     string_view token;
     unique_ptr<charbuff> contentsHexBuffer;
 
-    new(&variant.m_Dictionary)PdfVariant::PrimitiveMember(new PdfDictionary());
+    new(&variant.m_Dictionary)PdfVariant::PrimitiveMember(m_options.MemoryResource == nullptr
+        ? new PdfDictionary() : new PdfDictionary(*m_options.MemoryResource));
     auto& dict = variant.GetDictionaryUnsafe();
 
     while (true)
@@ -508,7 +656,8 @@ void PdfTokenizer::ReadArray(InputStreamDevice& device, PdfVariant& variant, con
 
     string_view token;
     PdfTokenType tokenType;
-    new(&variant.m_Array)PdfVariant::PrimitiveMember(new PdfArray());
+    new(&variant.m_Array)PdfVariant::PrimitiveMember(m_options.MemoryResource == nullptr
+        ? new PdfArray() : new PdfArray(*m_options.MemoryResource));
     auto& arr = variant.GetArrayUnsafe();
 
     while (true)
@@ -530,100 +679,18 @@ void PdfTokenizer::ReadString(InputStreamDevice& device, PdfVariant& variant, co
 {
     PODOFO_ASSERT(variant.GetDataType() == PdfDataType::Null);
 
-    char ch;
-    bool escape = false;
-    bool octEscape = false;
-    int octCharCount = 0;
-    char octValue = 0;
-    int balanceCount = 0; // Balanced parenthesis do not have to be escaped in strings
-
-    m_charBuffer.clear();
-    while (device.Read(ch))
+    string_view view;
+    if (device.TryGetView(view))
     {
-        if (escape)
-        {
-            // Handle escape sequences
-            if (octEscape)
-            {
-                // Handle octal escape sequences
-                octCharCount++;
-
-                if (!isOctalChar(ch))
-                {
-                    if (ch == ')')
-                    {
-                        // Handle end of string while reading octal code
-                        // NOTE: The octal value is added outside of the loop
-                        break;
-                    }
-
-                    // No octal character anymore,
-                    // so the octal sequence must be ended
-                    // and the character has to be treated as normal character!
-                    m_charBuffer.push_back(octValue);
-
-                    if (ch != '\\')
-                    {
-                        m_charBuffer.push_back(ch);
-                        escape = false;
-                    }
-
-                    octEscape = false;
-                    octCharCount = 0;
-                    octValue = 0;
-                    continue;
-                }
-
-                octValue <<= 3;
-                octValue |= ((ch - '0') & 0x07);
-
-                if (octCharCount == 3)
-                {
-                    m_charBuffer.push_back(octValue);
-                    escape = false;
-                    octEscape = false;
-                    octCharCount = 0;
-                    octValue = 0;
-                }
-            }
-            else if (isOctalChar(ch))
-            {
-                // The last character we have read was a '\\',
-                // so we check now for a digit to find stuff like \005
-                octValue = (ch - '0') & 0x07;
-                octEscape = true;
-                octCharCount = 1;
-            }
-            else
-            {
-                // Handle plain escape sequences
-                char escapedCh;
-                if (tryGetEscapedCharacter(ch, escapedCh))
-                    m_charBuffer.push_back(escapedCh);
-
-                escape = false;
-            }
-        }
-        else
-        {
-            // Handle raw characters
-            if (balanceCount == 0 && ch == ')')
-                break;
-
-            if (ch == '(')
-                balanceCount++;
-            else if (ch == ')')
-                balanceCount--;
-
-            escape = ch == '\\';
-            if (!escape)
-                m_charBuffer.push_back(static_cast<char>(ch));
-        }
+        ViewCharReader reader(view, device.GetPosition());
+        readString(reader, m_charBuffer);
+        device.Seek(reader.GetPosition());
+    }
+    else
+    {
+        DeviceCharReader reader(device);
+        readString(reader, m_charBuffer);
     }
-
-    // In case the string ends with a octal escape sequence
-    if (octEscape)
-        m_charBuffer.push_back(octValue);
 
     if (m_charBuffer.size() != 0)
     {
@@ -726,11 +793,111 @@ bool tryGetEscapedCharacter(char ch, char& escapedChar)
     }
 }
 
-void readHexString(InputStreamDevice& device, charbuff& buffer)
+template <typename TReader>
+void readString(TReader& reader, charbuff& buffer)
+{
+    char ch;
+    bool escape = false;
+    bool octEscape = false;
+    int octCharCount = 0;
+    char octValue = 0;
+    int balanceCount = 0; // Balanced parenthesis do not have to be escaped in strings
+
+    buffer.clear();
+    while (reader.Read(ch))
+    {
+        if (escape)
+        {
+            // Handle escape sequences
+            if (octEscape)
+            {
+                // Handle octal escape sequences
+                octCharCount++;
+
+                if (!isOctalChar(ch))
+                {
+                    if (ch == ')')
+                    {
+                        // Handle end of string while reading octal code
+                        // NOTE: The octal value is added outside of the loop
+                        break;
+                    }
+
+                    // No octal character anymore,
+                    // so the octal sequence must be ended
+                    // and the character has to be treated as normal character!
+                    buffer.push_back(octValue);
+
+                    if (ch != '\\')
+                    {
+                        buffer.push_back(ch);
+                        escape = false;
+                    }
+
+                    octEscape = false;
+                    octCharCount = 0;
+                    octValue = 0;
+                    continue;
+                }
+
+                octValue <<= 3;
+                octValue |= ((ch - '0') & 0x07);
+
+                if (octCharCount == 3)
+                {
+                    buffer.push_back(octValue);
+                    escape = false;
+                    octEscape = false;
+                    octCharCount = 0;
+                    octValue = 0;
+                }
+            }
+            else if (isOctalChar(ch))
+            {
+                // The last character we have read was a '\\',
+                // so we check now for a digit to find stuff like \005
+                octValue = (ch - '0') & 0x07;
+                octEscape = true;
+                octCharCount = 1;
+            }
+            else
+            {
+                // Handle plain escape sequences
+                char escapedCh;
+                if (tryGetEscapedCharacter(ch, escapedCh))
+                    buffer.push_back(escapedCh);
+
+                escape = false;
+            }
+        }
+        else
+        {
+            // Handle raw characters
+            if (balanceCount == 0 && ch == ')')
+                break;
+
+            if (ch == '(')
+                balanceCount++;
+            else if (ch == ')')
+                balanceCount--;
+
+            escape = ch == '\\';
+            if (!escape)
+                buffer.push_back(static_cast<char>(ch));
+        }
+    }
+
+    // In case the string ends with a octal escape sequence
+    if (octEscape)
+        buffer.push_back(octValue);
+}
+
+template <typename TReader>
+void readHexString(TReader& reader, charbuff& buffer)
 {
     buffer.clear();
     char ch;
-    while (device.Read(ch))
+    while (reader.Read(ch))
     {
         // end of stream reached
         if (ch == '>')
@@ -748,6 +915,22 @@ void readHexString(InputStreamDevice& device, charbuff& buffer)
         buffer.push_back('0');
 }
 
+void readHexString(InputStreamDevice& device, charbuff& buffer)
+{
+    string_view view;
+    if (device.TryGetView(view))
+    {
+        ViewCharReader reader(view, device.GetPosition());
+        readHexString(reader, buffer);
+        device.Seek(reader.GetPosition());
+    }
+    else
+    {
+        DeviceCharReader reader(device);
+        readHexString(reader, buffer);
+    }
+}
+
 bool isOctalChar(char ch)
 {
     switch (ch)
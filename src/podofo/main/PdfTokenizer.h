@@ -27,6 +27,11 @@ struct PODOFO_API PdfTokenizerOptions final
 {
     PdfPostScriptLanguageLevel LanguageLevel = PdfPostScriptLanguageLevel::L2;
     bool ReadReferences = true;
+    /** Memory resource the entries of the read dictionaries and arrays
+     * are allocated from, or nullptr to use the default heap
+     * \remarks The resource must outlive the read objects
+     */
+    std::pmr::memory_resource* MemoryResource = nullptr;
 };
 
 /**
@@ -47,10 +52,11 @@ public:
     /** Reads the next token from the current file position
      *  ignoring all comments.
      *
-     *  \param[out] token On true return, set to a pointer to the read
-     *                     token (a nullptr-terminated C string). The pointer is
-     *                     to memory owned by PdfTokenizer and must NOT be
-     *                     freed.  The contents are invalidated on the next
+     *  \param[out] token On true return, set to a view of the read token.
+     *                     It points to memory owned by PdfTokenizer or, if the
+     *                     device supports InputStreamDevice::TryGetView(), to
+     *                     the device contents, and it's not null terminated.
+     *                     The contents are invalidated on the next
      *                     call to tryReadNextToken(..) and by the destruction of
      *                     the PdfTokenizer. Undefined on false return.
      *
@@ -193,6 +199,8 @@ protected:
 private:
     PdfTokenizer(std::in_place_t, std::shared_ptr<charbuff>&& buffer, const PdfTokenizerOptions& options);
     bool tryReadDataType(InputStreamDevice& device, PdfLiteralDataType dataType, PdfVariant& variant, const PdfStatefulEncrypt* encrypt);
+    bool tryReadNextToken(InputStreamDevice& device, const std::string_view& view,
+        std::string_view& token, PdfTokenType& tokenType);
 
 private:
     using TokenizerPair = std::pair<std::string, PdfTokenType>;
@@ -59,6 +59,7 @@
 #include "main/PdfSigner.h"
 #include "main/PdfSignerCms.h"
 #include "main/PdfSigningContext.h"
+#include "main/PdfSigningPipeline.h"
 #include "main/PdfObjectStream.h"
 #include "main/PdfString.h"
 #include "main/PdfTokenizer.h"
@@ -72,6 +73,7 @@
 #include "main/PdfContents.h"
 #include "main/PdfDestination.h"
 #include "main/PdfDocument.h"
+#include "main/PdfDocumentProbe.h"
 #include "main/PdfElement.h"
 #include "main/PdfExtGState.h"
 #include "main/PdfField.h"
@@ -0,0 +1,249 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#include "PdfDeclarationsPrivate.h"
+#include "BinaryToText.h"
+
+#include <array>
+
+using namespace std;
+using namespace PoDoFo;
+
+namespace
+{
+    constexpr unsigned char Base64Invalid = 0xFF;
+    constexpr unsigned char Base64Whitespace = 0xFE;
+    constexpr unsigned char Base64Padding = 0xFD;
+
+    constexpr char Base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    constexpr char HexDigitsUpper[] = "0123456789ABCDEF";
+    constexpr char HexDigitsLower[] = "0123456789abcdef";
+
+    constexpr array<unsigned char, 256> createBase64DecodeTable()
+    {
+        array<unsigned char, 256> ret{ };
+        for (unsigned i = 0; i < 256; i++)
+            ret[i] = Base64Invalid;
+
+        for (unsigned i = 0; i < 64; i++)
+            ret[(unsigned char)Base64Alphabet[i]] = (unsigned char)i;
+
+        ret[(unsigned char)' '] = Base64Whitespace;
+        ret[(unsigned char)'\t'] = Base64Whitespace;
+        ret[(unsigned char)'\r'] = Base64Whitespace;
+        ret[(unsigned char)'\n'] = Base64Whitespace;
+        ret[(unsigned char)'\f'] = Base64Whitespace;
+        ret[(unsigned char)'\v'] = Base64Whitespace;
+        ret[(unsigned char)'='] = Base64Padding;
+        return ret;
+    }
+
+    constexpr array<bool, 256> createUrlUnreservedTable()
+    {
+        array<bool, 256> ret{ };
+        for (unsigned ch = 'A'; ch <= 'Z'; ch++)
+            ret[ch] = true;
+        for (unsigned ch = 'a'; ch <= 'z'; ch++)
+            ret[ch] = true;
+        for (unsigned ch = '0'; ch <= '9'; ch++)
+            ret[ch] = true;
+
+        ret[(unsigned char)'-'] = true;
+        ret[(unsigned char)'_'] = true;
+        ret[(unsigned char)'.'] = true;
+        ret[(unsigned char)'~'] = true;
+        return ret;
+    }
+
+    constexpr array<unsigned char, 256> Base64DecodeTable = createBase64DecodeTable();
+    constexpr array<bool, 256> UrlUnreservedTable = createUrlUnreservedTable();
+}
+
+size_t utls::EncodeBase64To(const bufferspan& dst, const bufferview& data)
+{
+    PODOFO_ASSERT(dst.size() >= GetBase64EncodedSize(data.size()));
+    auto src = (const unsigned char*)data.data();
+    char* out = dst.data();
+    size_t len = data.size();
+    size_t i = 0;
+
+    // Process complete 3 bytes groups
+    for (; i + 3 <= len; i += 3)
+    {
+        unsigned triple = ((unsigned)src[i] << 16) | ((unsigned)src[i + 1] << 8) | src[i + 2];
+        out[0] = Base64Alphabet[(triple >> 18) & 0x3F];
+        out[1] = Base64Alphabet[(triple >> 12) & 0x3F];
+        out[2] = Base64Alphabet[(triple >> 6) & 0x3F];
+        out[3] = Base64Alphabet[triple & 0x3F];
+        out += 4;
+    }
+
+    switch (len - i)
+    {
+        case 1:
+        {
+            unsigned triple = (unsigned)src[i] << 16;
+            out[0] = Base64Alphabet[(triple >> 18) & 0x3F];
+            out[1] = Base64Alphabet[(triple >> 12) & 0x3F];
+            out[2] = '=';
+            out[3] = '=';
+            out += 4;
+            break;
+        }
+        case 2:
+        {
+            unsigned triple = ((unsigned)src[i] << 16) | ((unsigned)src[i + 1] << 8);
+            out[0] = Base64Alphabet[(triple >> 18) & 0x3F];
+            out[1] = Base64Alphabet[(triple >> 12) & 0x3F];
+            out[2] = Base64Alphabet[(triple >> 6) & 0x3F];
+            out[3] = '=';
+            out += 4;
+            break;
+        }
+        default:
+            break;
+    }
+
+    return (size_t)(out - dst.data());
+}
+
+bool utls::TryDecodeBase64To(const bufferspan& dst, const string_view& str, size_t& decodedSize)
+{
+    PODOFO_ASSERT(dst.size() >= GetBase64DecodedMaxSize(str.size()));
+    auto src = (const unsigned char*)str.data();
+    auto out = (unsigned char*)dst.data();
+    size_t len = str.size();
+    size_t i = 0;
+    unsigned quantum = 0;
+    unsigned count = 0;
+    unsigned padding = 0;
+    decodedSize = 0;
+
+    while (i < len)
+    {
+        // Fast path: 4 valid characters in a row, no whitespace or padding
+        if (count == 0 && i + 4 <= len)
+        {
+            unsigned char a = Base64DecodeTable[src[i]];
+            unsigned char b = Base64DecodeTable[src[i + 1]];
+            unsigned char c = Base64DecodeTable[src[i + 2]];
+            unsigned char d = Base64DecodeTable[src[i + 3]];
+            if ((a | b | c | d) < 64)
+            {
+                unsigned triple = ((unsigned)a << 18) | ((unsigned)b << 12) | ((unsigned)c << 6) | d;
+                out[0] = (unsigned char)(triple >> 16);
+                out[1] = (unsigned char)(triple >> 8);
+                out[2] = (unsigned char)triple;
+                out += 3;
+                i += 4;
+                continue;
+            }
+        }
+
+        unsigned char value = Base64DecodeTable[src[i]];
+        i++;
+        if (value == Base64Whitespace)
+            continue;
+
+        if (value == Base64Invalid)
+            return false;
+
+        if (value == Base64Padding)
+        {
+            // Padding can only complete a 2 or 3 characters quantum
+            if (count < 2)
+                return false;
+
+            padding++;
+            continue;
+        }
+
+        if (padding != 0)
+        {
+            // No data is allowed after the padding
+            return false;
+        }
+
+        quantum = (quantum << 6) | value;
+        count++;
+        if (count == 4)
+        {
+            out[0] = (unsigned char)(quantum >> 16);
+            out[1] = (unsigned char)(quantum >> 8);
+            out[2] = (unsigned char)quantum;
+            out += 3;
+            quantum = 0;
+            count = 0;
+        }
+    }
+
+    switch (count)
+    {
+        case 0:
+            break;
+        case 2:
+            out[0] = (unsigned char)(quantum >> 4);
+            out += 1;
+            break;
+        case 3:
+            out[0] = (unsigned char)(quantum >> 10);
+            out[1] = (unsigned char)(quantum >> 2);
+            out += 2;
+            break;
+        default:
+            return false;
+    }
+
+    decodedSize = (size_t)(out - (unsigned char*)dst.data());
+    return true;
+}
+
+void utls::EncodeHexTo(const bufferspan& dst, const bufferview& data, bool lowercase)
+{
+    PODOFO_ASSERT(dst.size() >= data.size() * 2);
+    const char* digits = lowercase ? HexDigitsLower : HexDigitsUpper;
+    auto src = (const unsigned char*)data.data();
+    char* out = dst.data();
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        out[i * 2] = digits[src[i] >> 4];
+        out[i * 2 + 1] = digits[src[i] & 0x0F];
+    }
+}
+
+size_t utls::GetUrlEncodedSize(const string_view& str)
+{
+    size_t ret = str.size();
+    for (unsigned char ch : str)
+    {
+        if (!UrlUnreservedTable[ch])
+            ret += 2;
+    }
+
+    return ret;
+}
+
+size_t utls::UrlEncodeTo(const bufferspan& dst, const string_view& str)
+{
+    PODOFO_ASSERT(dst.size() >= GetUrlEncodedSize(str));
+    char* out = dst.data();
+    for (unsigned char ch : str)
+    {
+        if (UrlUnreservedTable[ch])
+        {
+            *out++ = (char)ch;
+        }
+        else
+        {
+            out[0] = '%';
+            out[1] = HexDigitsUpper[ch >> 4];
+            out[2] = HexDigitsUpper[ch & 0x0F];
+            out += 3;
+        }
+    }
+
+    return (size_t)(out - dst.data());
+}
@@ -0,0 +1,56 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#ifndef BINARY_TO_TEXT_H
+#define BINARY_TO_TEXT_H
+
+#include <podofo/main/PdfDeclarations.h>
+
+// Table driven base64 (RFC 4648), hex and URL (RFC 3986) codecs.
+// They write into caller supplied buffers, so the sizes of the
+// output can be computed upfront and no intermediate allocation
+// is needed
+namespace utls
+{
+    /** Size of the padded base64 encoding of the given number of bytes
+     */
+    constexpr size_t GetBase64EncodedSize(size_t size) { return (size + 2) / 3 * 4; }
+
+    /** Upper bound of the size of the data decoded from
+     * the given number of base64 characters
+     */
+    constexpr size_t GetBase64DecodedMaxSize(size_t size) { return (size + 3) / 4 * 3; }
+
+    /** Encode the data as padded base64, without line breaks
+     * \param dst buffer of at least GetBase64EncodedSize(data.size()) characters
+     * \returns the number of written characters
+     */
+    size_t EncodeBase64To(const PoDoFo::bufferspan& dst, const PoDoFo::bufferview& data);
+
+    /** Decode base64 data, skipping whitespace. Padding is optional
+     * \param dst buffer of at least GetBase64DecodedMaxSize(str.size()) bytes
+     * \param decodedSize the number of written bytes
+     * \returns false if the input is not valid base64
+     */
+    bool TryDecodeBase64To(const PoDoFo::bufferspan& dst, const std::string_view& str, size_t& decodedSize);
+
+    /** Encode the data as hex
+     * \param dst buffer of at least data.size() * 2 characters
+     */
+    void EncodeHexTo(const PoDoFo::bufferspan& dst, const PoDoFo::bufferview& data, bool lowercase = false);
+
+    /** Size of the URL encoding of the given string
+     */
+    size_t GetUrlEncodedSize(const std::string_view& str);
+
+    /** URL encode the string, keeping only the RFC 3986 unreserved characters
+     * \param dst buffer of at least GetUrlEncodedSize(str) characters
+     * \returns the number of written characters
+     */
+    size_t UrlEncodeTo(const PoDoFo::bufferspan& dst, const std::string_view& str);
+}
+
+#endif // BINARY_TO_TEXT_H
@@ -134,6 +134,18 @@ void CmsContext::ComputeSignature(const bufferview& signedHash, charbuff& signat
     m_status = CmsContextStatus::ComputedSignature;
 }
 
+unsigned CmsContext::GetSignedHashMaxSize() const
+{
+    if (m_cert == nullptr)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::InternalLogic, "The certificate is not loaded");
+
+    auto pkey = X509_get0_pubkey(m_cert);
+    int size;
+    if (pkey == nullptr || (size = EVP_PKEY_get_size(pkey)) <= 0)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::OpenSSLError, "Unable to determine the certificate key size");
+
+    return (unsigned)size;
+}
 
 void CmsContext::AddAttribute(const string_view& nid, const bufferview& attr, bool signedAttr, bool asOctetString)
 {
@@ -50,6 +50,11 @@ namespace PoDoFo
         void ComputeHashToSign(charbuff& hashToSign);
         void ComputeSignature(const bufferview& signedHash, charbuff& signature);
         void AddAttribute(const std::string_view& nid, const bufferview& attr, bool signedAttr, bool octetString);
+
+        /** Get the maximum size of a signed hash produced
+         * with the key of the loaded certificate
+         */
+        unsigned GetSignedHashMaxSize() const;
     private:
         void loadX509Certificate(const bufferview& cert);
         void loadX509Chain(const std::vector<charbuff>& chain);
@@ -0,0 +1,95 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#include "PdfDeclarationsPrivate.h"
+#include "DerCache.h"
+
+using namespace std;
+using namespace PoDoFo;
+
+static string normalizeBase64(const string_view& base64);
+
+DerCache::DerCache()
+    : m_bytes(0) { }
+
+DerCache& DerCache::Instance()
+{
+    static DerCache cache;
+    return cache;
+}
+
+shared_ptr<DecodedDer> DerCache::Get(const string_view& base64, const DecodeFunc& decode)
+{
+    string key = normalizeBase64(base64);
+    {
+        lock_guard<mutex> lock(m_mutex);
+        auto found = m_index.find(key);
+        if (found != m_index.end())
+        {
+            m_lru.splice(m_lru.begin(), m_lru, found->second);
+            return found->second->second;
+        }
+    }
+
+    // Decode outside of the lock, concurrent misses on the
+    // same artifact will just produce equivalent entries
+    auto decoded = decode();
+    auto entry = std::make_shared<DecodedDer>();
+    entry->Der.assign(reinterpret_cast<const char*>(decoded.data()), decoded.size());
+    entry->Digest = ssl::ComputeHash(entry->Der, PdfHashingAlgorithm::SHA256);
+
+    // The key is accounted as well, as it's about as big as the data
+    size_t size = key.size() + entry->Der.size();
+    if (size > MaxBytes / 4)
+        return entry;
+
+    lock_guard<mutex> lock(m_mutex);
+    if (m_index.find(key) != m_index.end())
+        return entry;
+
+    m_lru.emplace_front(std::move(key), entry);
+    m_index[m_lru.front().first] = m_lru.begin();
+    m_bytes += size;
+    while (m_lru.size() > MaxEntries || m_bytes > MaxBytes)
+    {
+        auto& last = m_lru.back();
+        m_bytes -= last.first.size() + last.second->Der.size();
+        m_index.erase(last.first);
+        m_lru.pop_back();
+    }
+    return entry;
+}
+
+X509* DerCache::GetCertificate(DecodedDer& entry)
+{
+    std::call_once(entry.ParseOnce, [&entry] {
+        auto p = reinterpret_cast<const unsigned char*>(entry.Der.data());
+        X509* cert = d2i_X509(nullptr, &p, static_cast<long>(entry.Der.size()));
+        if (cert == nullptr)
+        {
+            auto reason = ERR_reason_error_string(ERR_get_error());
+            entry.ParseError = reason == nullptr ? "Unknown error" : reason;
+            ERR_clear_error();
+        }
+        else
+        {
+            entry.Cert.reset(cert, X509_free);
+        }
+    });
+    return entry.Cert.get();
+}
+
+string normalizeBase64(const string_view& base64)
+{
+    string ret;
+    ret.reserve(base64.size());
+    for (char ch : base64)
+    {
+        if (!std::isspace((unsigned char)ch))
+            ret.push_back(ch);
+    }
+    return ret;
+}
@@ -0,0 +1,73 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#ifndef PDF_DER_CACHE_H
+#define PDF_DER_CACHE_H
+
+#include "OpenSSLInternal.h"
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace PoDoFo {
+
+/**
+ * A decoded DER artifact (certificate, CRL or OCSP response) shared across sessions
+ */
+struct DecodedDer final
+{
+    std::string Digest;             ///< SHA-256 of the DER bytes
+    charbuff Der;
+    std::once_flag ParseOnce;
+    std::shared_ptr<X509> Cert;     ///< Parsed on first request, null if not a certificate
+    std::string ParseError;         ///< The OpenSSL error of a failed parse
+};
+
+/**
+ * Process-wide LRU cache of decoded DER artifacts, keyed by their base64
+ * text with the whitespace stripped, so the same artifact wrapped
+ * differently is found as well. The same CA chain, CRLs and OCSP responses
+ * are usually passed to every remote signing session, so they are decoded
+ * and parsed once. The cache is bounded both in entries and in total bytes
+ */
+class DerCache final
+{
+public:
+    using DecodeFunc = std::function<std::vector<unsigned char>()>;
+
+    static DerCache& Instance();
+
+    /** Get the artifact with the given base64 text, decoding it
+     *  with the given function if it's not in the cache
+     */
+    std::shared_ptr<DecodedDer> Get(const std::string_view& base64, const DecodeFunc& decode);
+
+    /** \returns the certificate parsed from the entry, or nullptr if it's not a
+     *  certificate. Then the error is in the ParseError of the entry, as the OpenSSL
+     *  error queue is per thread and is emptied by the first request
+     */
+    static X509* GetCertificate(DecodedDer& entry);
+
+    static constexpr size_t MaxEntries = 256;
+    static constexpr size_t MaxBytes = 64 * 1024 * 1024;
+
+private:
+    DerCache();
+
+private:
+    using LruList = std::list<std::pair<std::string, std::shared_ptr<DecodedDer>>>;
+    std::mutex m_mutex;
+    LruList m_lru;
+    std::unordered_map<std::string_view, LruList::iterator> m_index;
+    size_t m_bytes;
+};
+
+}
+
+#endif // PDF_DER_CACHE_H
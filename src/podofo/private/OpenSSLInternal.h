@@ -32,6 +32,7 @@
 #define EVP_MD_CTX_get0_md EVP_MD_CTX_md
 #define EVP_MD_get_type EVP_MD_type
 #define EVP_PKEY_get_id EVP_PKEY_id
+#define EVP_PKEY_get_size EVP_PKEY_size
 #endif // OPENSSL_VERSION_MAJOR < 3
 
 // This is a recreation of ESS_CERT_ID_V2 structure
@@ -0,0 +1,81 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#include "PdfDeclarationsPrivate.h"
+#include "PdfCompressedObject.h"
+
+#include <podofo/main/PdfDocument.h>
+
+using namespace std;
+using namespace PoDoFo;
+
+PdfCompressedObject::PdfCompressedObject(PdfDocument& doc, const PdfReference& reference,
+    uint32_t streamObjectNum, unsigned index, const shared_ptr<PdfObjectStreamCache>& cache) :
+    PdfObject(PdfVariant(), reference, false),
+    m_cache(cache),
+    m_StreamObjectNum(streamObjectNum),
+    m_Index(index),
+    m_IsRevised(false)
+{
+    SetDocument(&doc);
+    EnableDelayedLoading();
+}
+
+// Only called via the demand loading mechanism
+// Be very careful to avoid recursive demand loads via PdfVariant
+// or PdfObject method calls here.
+void PdfCompressedObject::delayedLoad()
+{
+    auto stream = m_cache->GetStream(m_StreamObjectNum);
+    auto& objects = stream->Objects;
+    uint32_t objNo = GetIndirectReference().ObjectNumber();
+    size_t offset;
+    if (m_Index < objects.size() && objects[m_Index].first == objNo)
+    {
+        offset = objects[m_Index].second;
+    }
+    else
+    {
+        // The index in the XRef entry is wrong: fallback
+        // searching the object in the stream table
+        auto found = std::find_if(objects.begin(), objects.end(),
+            [objNo](const pair<uint32_t, size_t>& pair) { return pair.first == objNo; });
+        if (found == objects.end())
+        {
+            PODOFO_RAISE_ERROR_INFO(PdfErrorCode::ObjectNotFound, "Object {} 0 R not found in object stream {} 0 R",
+                objNo, m_StreamObjectNum);
+        }
+
+        offset = found->second;
+    }
+
+    try
+    {
+        PdfObjectStreamParser::ReadObject(*stream, offset, m_Variant, m_cache->GetBuffer(),
+            MustGetDocument().GetMemoryResource());
+    }
+    catch (PdfError& e)
+    {
+        PODOFO_PUSH_FRAME_INFO(e, "Unable to read object {} 0 R from object stream {} 0 R",
+            objNo, m_StreamObjectNum);
+        throw;
+    }
+}
+
+void PdfCompressedObject::SetRevised()
+{
+    m_IsRevised = true;
+}
+
+bool PdfCompressedObject::TryUnload()
+{
+    if (!IsDelayedLoadDone() || m_IsRevised)
+        return false;
+
+    m_Variant = PdfVariant();
+    EnableDelayedLoading();
+    return true;
+}
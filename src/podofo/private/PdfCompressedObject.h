@@ -0,0 +1,60 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#ifndef PDF_COMPRESSED_OBJECT_H
+#define PDF_COMPRESSED_OBJECT_H
+
+#include "PdfObjectStreamParser.h"
+
+namespace PoDoFo {
+
+/**
+ * A PdfCompressedObject is an object stored in an object stream
+ * (PDF Reference 1.7 3.4.6 Object Streams) that is loaded on demand.
+ * The containing stream is decoded only on first access, through a
+ * cache shared by all the compressed objects of the document
+ */
+class PdfCompressedObject final : public PdfObject
+{
+    friend class PdfParser;
+
+private:
+    /**
+     * \param reference the reference of the object. The generation
+     *      number of compressed objects is implicitly zero
+     * \param streamObjectNum the object number of the containing object stream
+     * \param index the index of the object in the containing stream
+     * \param cache the cache of the decoded object streams
+     */
+    PdfCompressedObject(PdfDocument& doc, const PdfReference& reference,
+        uint32_t streamObjectNum, unsigned index, const std::shared_ptr<PdfObjectStreamCache>& cache);
+
+public:
+    bool TryUnload() override;
+
+    inline uint32_t GetObjectStreamNumber() const { return m_StreamObjectNum; }
+
+    inline unsigned GetIndex() const { return m_Index; }
+
+protected:
+    void delayedLoad() override;
+
+    void SetRevised() override;
+
+private:
+    PdfCompressedObject(const PdfCompressedObject&) = delete;
+    PdfCompressedObject& operator=(const PdfCompressedObject&) = delete;
+
+private:
+    std::shared_ptr<PdfObjectStreamCache> m_cache;
+    uint32_t m_StreamObjectNum;
+    unsigned m_Index;
+    bool m_IsRevised;         ///< True if the object was irreversibly modified since first read
+};
+
+};
+
+#endif // PDF_COMPRESSED_OBJECT_H
@@ -6,12 +6,16 @@
 #include "PdfDeclarationsPrivate.h"
 
 #include <regex>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <podofo/private/utfcpp_extensions.h>
 
 #include <podofo/auxiliary/InputStream.h>
 #include <podofo/auxiliary/OutputStream.h>
 
 #include <podofo/private/istringviewstream.h>
+#include "BinaryToText.h"
 
 #include <podofo/private/utfcpp_extensions.h>
 
@@ -1168,9 +1172,7 @@ void utls::WriteCharHexTo(char buf[2], char ch)
 string utls::GetCharHexString(const bufferview& buff)
 {
     string ret(buff.size() * 2, '\0');
-    for (unsigned i = 0; i < buff.size(); i++)
-        utls::WriteCharHexTo(ret.data() + i * 2, buff[i]);
-
+    utls::EncodeHexTo(ret, buff);
     return ret;
 }
 
@@ -1383,14 +1385,16 @@ void utls::SerializeEncodedString(OutputStream& stream, const string_view& encod
 
         if (wantHex)
         {
-            char ch;
-            char data[2];
-            while (len-- != 0)
+            // Encode in chunks, to not write the stream one char at time
+            constexpr size_t ChunkSize = 256;
+            char data[ChunkSize * 2];
+            while (len != 0)
             {
-                ch = *cursor;
-                utls::WriteCharHexTo(data, ch);
-                stream.Write(string_view(data, 2));
-                cursor++;
+                size_t chunkLen = std::min(len, ChunkSize);
+                utls::EncodeHexTo(bufferspan(data, chunkLen * 2), bufferview(cursor, chunkLen));
+                stream.Write(string_view(data, chunkLen * 2));
+                cursor += chunkLen;
+                len -= chunkLen;
             }
         }
         else
@@ -1705,6 +1709,60 @@ utls::RecursionGuard::~RecursionGuard()
     Exit();
 }
 
+void utls::RunParallel(unsigned threadCount, size_t count, const function<void(size_t index)>& task)
+{
+    if (count == 0)
+        return;
+
+    if (threadCount == 0)
+        threadCount = std::max(1u, thread::hardware_concurrency());
+
+    // Dispatch the items in chunks of contiguous indices,
+    // enough of them to balance the load between the workers
+    size_t chunkSize = std::max((size_t)1, count / ((size_t)threadCount * 8));
+    atomic<size_t> next(0);
+    atomic<bool> failed(false);
+    mutex errorMutex;
+    exception_ptr firstError;
+    auto work = [&]() {
+        while (!failed)
+        {
+            size_t begin = next.fetch_add(chunkSize);
+            if (begin >= count)
+                break;
+
+            size_t end = std::min(begin + chunkSize, count);
+            try
+            {
+                for (size_t i = begin; i < end; i++)
+                    task(i);
+            }
+            catch (...)
+            {
+                unique_lock<mutex> lock(errorMutex);
+                if (firstError == nullptr)
+                    firstError = current_exception();
+
+                failed = true;
+            }
+        }
+    };
+
+    vector<thread> workers;
+    unsigned workerCount = (unsigned)std::min((size_t)threadCount, (count + chunkSize - 1) / chunkSize);
+    workers.reserve(workerCount - 1);
+    for (unsigned i = 1; i < workerCount; i++)
+        workers.emplace_back(work);
+
+    // The calling thread is a worker as well
+    work();
+    for (auto& worker : workers)
+        worker.join();
+
+    if (firstError != nullptr)
+        rethrow_exception(firstError);
+}
+
 void removeTrailingZeroes(string& str, size_t len)
 {
     // Remove trailing zeroes
@@ -22,6 +22,7 @@
 #include <limits>
 #include <algorithm>
 #include <iostream>
+#include <functional>
 
 #include "Format.h"
 #include "numbers_compat.h"
@@ -262,6 +263,15 @@ namespace utls
      */
     bool DoesMultiplicationOverflow(size_t op1, size_t op2);
 
+    /** Run the task for all the indices from 0 to count on the given
+     *  number of threads, including the calling one. The indices are
+     *  dispatched in chunks of contiguous ones. The first exception
+     *  thrown by a task stops the dispatch and it's rethrown
+     *  \param threadCount the number of threads, or 0 to
+     *      use std::thread::hardware_concurrency()
+     */
+    void RunParallel(unsigned threadCount, size_t count, const std::function<void(size_t index)>& task);
+
     const std::locale& GetInvariantLocale();
 
     std::string_view GetEnvironmentVariable(const std::string_view& name);
@@ -0,0 +1,94 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#include "PdfDeclarationsPrivate.h"
+#include "PdfDecodedStreamCache.h"
+
+using namespace std;
+using namespace PoDoFo;
+
+PdfDecodedStreamCache::PdfDecodedStreamCache(size_t budget)
+    : m_budget(budget), m_size(0) { }
+
+shared_ptr<const charbuff> PdfDecodedStreamCache::Find(uint64_t key)
+{
+    lock_guard<mutex> lock(m_mutex);
+    auto found = m_index.find(key);
+    if (found == m_index.end())
+        return nullptr;
+
+    // Move the entry to the front, as the most recently used
+    m_entries.splice(m_entries.begin(), m_entries, found->second);
+    return found->second->second;
+}
+
+void PdfDecodedStreamCache::Add(uint64_t key, const shared_ptr<const charbuff>& data)
+{
+    lock_guard<mutex> lock(m_mutex);
+    remove(key);
+    if (data->size() > m_budget)
+        return;
+
+    evict(m_budget - data->size());
+    m_entries.emplace_front(key, data);
+    m_index[key] = m_entries.begin();
+    m_size += data->size();
+}
+
+void PdfDecodedStreamCache::Remove(uint64_t key)
+{
+    lock_guard<mutex> lock(m_mutex);
+    remove(key);
+}
+
+void PdfDecodedStreamCache::Clear()
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_size = 0;
+}
+
+void PdfDecodedStreamCache::SetBudget(size_t budget)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_budget = budget;
+    evict(budget);
+}
+
+size_t PdfDecodedStreamCache::GetBudget() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_budget;
+}
+
+size_t PdfDecodedStreamCache::GetSize() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_size;
+}
+
+void PdfDecodedStreamCache::remove(uint64_t key)
+{
+    auto found = m_index.find(key);
+    if (found == m_index.end())
+        return;
+
+    m_size -= found->second->second->size();
+    m_entries.erase(found->second);
+    m_index.erase(found);
+}
+
+void PdfDecodedStreamCache::evict(size_t budget)
+{
+    while (m_size > budget)
+    {
+        auto& entry = m_entries.back();
+        m_size -= entry.second->size();
+        m_index.erase(entry.first);
+        m_entries.pop_back();
+    }
+}
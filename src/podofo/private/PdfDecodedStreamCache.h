@@ -0,0 +1,75 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#ifndef PDF_DECODED_STREAM_CACHE_H
+#define PDF_DECODED_STREAM_CACHE_H
+
+#include <podofo/main/PdfDeclarations.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace PoDoFo {
+
+/**
+ * A cache of the data decoded from the streams of a document, with
+ * a byte budget and least recently used eviction. The entries are
+ * identified by the cache key of the streams, which is never reused,
+ * so entries of deleted streams are just left to be evicted.
+ * All the methods are synchronized, as the streams of a document may
+ * be read concurrently
+ */
+class PdfDecodedStreamCache final
+{
+public:
+    PdfDecodedStreamCache(size_t budget);
+
+    /** Get the data of the stream with the given key, marking
+     *  it as the most recently used
+     *  \returns the data, or nullptr if it's not in the cache
+     */
+    std::shared_ptr<const charbuff> Find(uint64_t key);
+
+    /** Add the data of the stream with the given key, evicting the least
+     *  recently used entries to stay within the budget. Data larger than
+     *  the whole budget is not added
+     */
+    void Add(uint64_t key, const std::shared_ptr<const charbuff>& data);
+
+    void Remove(uint64_t key);
+
+    void Clear();
+
+    /** Set the byte budget, evicting the least recently
+     *  used entries that exceed it
+     */
+    void SetBudget(size_t budget);
+
+    size_t GetBudget() const;
+
+    /** \returns the total size of the data in the cache
+     */
+    size_t GetSize() const;
+
+private:
+    using EntryList = std::list<std::pair<uint64_t, std::shared_ptr<const charbuff>>>;
+
+    void remove(uint64_t key);
+    void evict(size_t budget);
+
+private:
+    mutable std::mutex m_mutex;
+    size_t m_budget;
+    size_t m_size;
+    EntryList m_entries;    ///< Most recently used entries first
+    std::unordered_map<uint64_t, EntryList::iterator> m_index;
+};
+
+}
+
+#endif // PDF_DECODED_STREAM_CACHE_H
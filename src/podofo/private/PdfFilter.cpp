@@ -30,6 +30,9 @@ void PdfFilter::EncodeTo(charbuff& outBuffer, const bufferview& inBuffer) const
     if (!this->CanEncode())
         PODOFO_RAISE_ERROR(PdfErrorCode::UnsupportedFilter);
 
+    if (const_cast<PdfFilter&>(*this).TryEncodeBufferImpl(outBuffer, inBuffer))
+        return;
+
     BufferStreamDevice stream(outBuffer);
     const_cast<PdfFilter&>(*this).encodeTo(stream, inBuffer);
 }
@@ -55,6 +58,9 @@ void PdfFilter::DecodeTo(charbuff& outBuffer, const bufferview& inBuffer,
     if (!this->CanDecode())
         PODOFO_RAISE_ERROR(PdfErrorCode::UnsupportedFilter);
 
+    if (const_cast<PdfFilter&>(*this).TryDecodeBufferImpl(outBuffer, inBuffer, decodeParms))
+        return;
+
     BufferStreamDevice stream(outBuffer);
     const_cast<PdfFilter&>(*this).decodeTo(stream, inBuffer, decodeParms);
 }
@@ -218,3 +224,15 @@ void PdfFilter::EndEncodeImpl()
 {
     // Do nothing by default
 }
+
+bool PdfFilter::TryEncodeBufferImpl(charbuff&, const bufferview&)
+{
+    // Encode by blocks by default
+    return false;
+}
+
+bool PdfFilter::TryDecodeBufferImpl(charbuff&, const bufferview&, const PdfDictionary*)
+{
+    // Decode by blocks by default
+    return false;
+}
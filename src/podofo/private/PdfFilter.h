@@ -265,6 +265,33 @@ protected:
      */
     virtual void EndDecodeImpl();
 
+    /** Encode a whole buffer at once, appending the encoded data to
+     *  outBuffer. NEVER call this method directly.
+     *
+     *  By default this function does nothing and returns false. Filters that
+     *  can encode faster when the input size is known up front should
+     *  override this method. It's called by EncodeTo(charbuff&, const bufferview&)
+     *  before falling back to BeginEncode()/EncodeBlock()/EndEncode().
+     *
+     *  \returns false if the buffer must be encoded by blocks instead. In such
+     *      case outBuffer must be left unmodified
+     */
+    virtual bool TryEncodeBufferImpl(charbuff& outBuffer, const bufferview& inBuffer);
+
+    /** Decode a whole buffer at once, appending the decoded data to
+     *  outBuffer. NEVER call this method directly.
+     *
+     *  By default this function does nothing and returns false. Filters that
+     *  can decode faster when the input size is known up front should
+     *  override this method. It's called by DecodeTo(charbuff&, const bufferview&, const PdfDictionary*)
+     *  before falling back to BeginDecode()/DecodeBlock()/EndDecode().
+     *
+     *  \returns false if the buffer must be decoded by blocks instead. In such
+     *      case outBuffer must be left unmodified
+     */
+    virtual bool TryDecodeBufferImpl(charbuff& outBuffer, const bufferview& inBuffer,
+        const PdfDictionary* decodeParms);
+
 protected:
     inline OutputStream& GetStream() const { return *m_OutputStream; }
 private:
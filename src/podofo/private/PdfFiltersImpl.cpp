@@ -9,6 +9,11 @@
 #include <podofo/main/PdfDictionary.h>
 #include <podofo/main/PdfTokenizer.h>
 #include <podofo/auxiliary/StreamDevice.h>
+#include <podofo/main/PdfCommon.h>
+
+#ifdef PODOFO_HAVE_LIBDEFLATE
+#include <libdeflate.h>
+#endif // PODOFO_HAVE_LIBDEFLATE
 
 using namespace std;
 using namespace PoDoFo;
@@ -471,7 +476,7 @@ void PdfFlateFilter::BeginEncodeImpl()
     m_stream.zfree = Z_NULL;
     m_stream.opaque = Z_NULL;
 
-    if (deflateInit(&m_stream, Z_DEFAULT_COMPRESSION))
+    if (deflateInit(&m_stream, PdfCommon::GetFlateCompressionLevel()))
         PODOFO_RAISE_ERROR(PdfErrorCode::FlateError);
 }
 
@@ -603,6 +608,148 @@ void PdfFlateFilter::EndDecodeImpl()
     m_Predictor.reset();
 }
 
+bool PdfFlateFilter::TryEncodeBufferImpl(charbuff& outBuffer, const bufferview& inBuffer)
+{
+    int level = PdfCommon::GetFlateCompressionLevel();
+    size_t offset = outBuffer.size();
+#ifdef PODOFO_HAVE_LIBDEFLATE
+    // libdeflate levels go up to 12, but the zlib ones have the same meaning
+    unique_ptr<libdeflate_compressor, decltype(&libdeflate_free_compressor)> compressor(
+        libdeflate_alloc_compressor(level < 0 ? 6 : level), libdeflate_free_compressor);
+    if (compressor == nullptr)
+        PODOFO_RAISE_ERROR(PdfErrorCode::OutOfMemory);
+
+    outBuffer.resize(offset + libdeflate_zlib_compress_bound(compressor.get(), inBuffer.size()));
+    size_t written = libdeflate_zlib_compress(compressor.get(), inBuffer.data(), inBuffer.size(),
+        outBuffer.data() + offset, outBuffer.size() - offset);
+    if (written == 0)
+    {
+        outBuffer.resize(offset);
+        return false;
+    }
+
+    outBuffer.resize(offset + written);
+    return true;
+#else
+    if (inBuffer.size() > numeric_limits<uInt>::max())
+        return false;
+
+    z_stream stream{ };
+    if (deflateInit(&stream, level) != Z_OK)
+        PODOFO_RAISE_ERROR(PdfErrorCode::FlateError);
+
+    // Deflate directly in the output buffer, which is
+    // large enough to hold the whole compressed data
+    size_t bound = deflateBound(&stream, (uLong)inBuffer.size());
+    outBuffer.resize(offset + bound);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(inBuffer.data()));
+    stream.avail_in = (uInt)inBuffer.size();
+    stream.next_out = reinterpret_cast<Bytef*>(outBuffer.data() + offset);
+    stream.avail_out = (uInt)std::min(bound, (size_t)numeric_limits<uInt>::max());
+    int ret = deflate(&stream, Z_FINISH);
+    size_t written = stream.total_out;
+    (void)deflateEnd(&stream);
+    if (ret != Z_STREAM_END)
+    {
+        outBuffer.resize(offset);
+        return false;
+    }
+
+    outBuffer.resize(offset + written);
+    return true;
+#endif // PODOFO_HAVE_LIBDEFLATE
+}
+
+bool PdfFlateFilter::TryDecodeBufferImpl(charbuff& outBuffer, const bufferview& inBuffer,
+    const PdfDictionary* decodeParms)
+{
+    if (decodeParms == nullptr)
+        return tryInflateBuffer(outBuffer, inBuffer);
+
+    charbuff decoded;
+    if (!tryInflateBuffer(decoded, inBuffer))
+        return false;
+
+    PdfPredictorDecoder predictor(*decodeParms);
+    BufferStreamDevice stream(outBuffer);
+    predictor.Decode(decoded.data(), decoded.size(), stream);
+    return true;
+}
+
+// Inflate the whole buffer, growing the output buffer as needed. Malformed
+// streams are left to the block decoding, which handles their quirks
+bool PdfFlateFilter::tryInflateBuffer(charbuff& outBuffer, const bufferview& inBuffer)
+{
+    size_t offset = outBuffer.size();
+    size_t capacity = std::max(inBuffer.size() * 4, (size_t)BUFFER_SIZE);
+#ifdef PODOFO_HAVE_LIBDEFLATE
+    unique_ptr<libdeflate_decompressor, decltype(&libdeflate_free_decompressor)> decompressor(
+        libdeflate_alloc_decompressor(), libdeflate_free_decompressor);
+    if (decompressor == nullptr)
+        PODOFO_RAISE_ERROR(PdfErrorCode::OutOfMemory);
+
+    while (true)
+    {
+        outBuffer.resize(offset + capacity);
+        size_t written;
+        auto result = libdeflate_zlib_decompress(decompressor.get(), inBuffer.data(), inBuffer.size(),
+            outBuffer.data() + offset, capacity, &written);
+        switch (result)
+        {
+            case LIBDEFLATE_SUCCESS:
+                outBuffer.resize(offset + written);
+                return true;
+            case LIBDEFLATE_INSUFFICIENT_SPACE:
+                capacity *= 2;
+                break;
+            default:
+                outBuffer.resize(offset);
+                return false;
+        }
+    }
+#else
+    if (inBuffer.size() > numeric_limits<uInt>::max())
+        return false;
+
+    z_stream stream{ };
+    if (inflateInit(&stream) != Z_OK)
+        PODOFO_RAISE_ERROR(PdfErrorCode::FlateError);
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(inBuffer.data()));
+    stream.avail_in = (uInt)inBuffer.size();
+    size_t written = 0;
+    while (true)
+    {
+        outBuffer.resize(offset + capacity);
+        size_t available = std::min(capacity - written, (size_t)numeric_limits<uInt>::max());
+        stream.next_out = reinterpret_cast<Bytef*>(outBuffer.data() + offset + written);
+        stream.avail_out = (uInt)available;
+        int ret = inflate(&stream, Z_NO_FLUSH);
+        written += available - stream.avail_out;
+        if (ret == Z_STREAM_END)
+            break;
+
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+        {
+            (void)inflateEnd(&stream);
+            outBuffer.resize(offset);
+            return false;
+        }
+
+        // Truncated streams are accepted, like when decoding by blocks
+        if (stream.avail_out != 0)
+            break;
+
+        if (written == capacity)
+            capacity *= 2;
+    }
+
+    (void)inflateEnd(&stream);
+    outBuffer.resize(offset + written);
+    return true;
+#endif // PODOFO_HAVE_LIBDEFLATE
+}
+
 #pragma endregion // PdfFlateFilter
 
 #pragma region PdfRLEFilter
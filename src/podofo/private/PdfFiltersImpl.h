@@ -112,8 +112,15 @@ public:
 
     inline PdfFilterType GetType() const override { return PdfFilterType::FlateDecode; }
 
+protected:
+    bool TryEncodeBufferImpl(charbuff& outBuffer, const bufferview& inBuffer) override;
+
+    bool TryDecodeBufferImpl(charbuff& outBuffer, const bufferview& inBuffer,
+        const PdfDictionary* decodeParms) override;
+
 private:
     void EncodeBlockInternal(const char* buffer, size_t len, int nMode);
+    bool tryInflateBuffer(charbuff& outBuffer, const bufferview& inBuffer);
 
 private:
     unsigned char m_buffer[BUFFER_SIZE];
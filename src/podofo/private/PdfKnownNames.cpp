@@ -0,0 +1,78 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#include "PdfDeclarationsPrivate.h"
+#include "PdfKnownNames.h"
+
+using namespace std;
+using namespace PoDoFo;
+
+// The names of PdfNames, plus other names common in
+// documents structure. NOTE: Keep them sorted
+static constexpr string_view s_knownNames[] = {
+    "A"sv, "AA"sv, "AC"sv, "AP"sv, "AS"sv, "AcroForm"sv, "Action"sv, "Alternate"sv,
+    "AlternatePresentations"sv, "Angle"sv, "Annot"sv, "Annots"sv, "App"sv, "ArtBox"sv, "Ascent"sv,
+    "AuthEvent"sv, "Author"sv, "AvgWidth"sv, "BBox"sv, "BC"sv, "BG"sv, "BI"sv, "BM"sv, "Base"sv,
+    "BaseEncoding"sv, "BaseFont"sv, "BaseVersion"sv, "BitsPerComponent"sv, "BitsPerSample"sv,
+    "BlackPoint"sv, "BleedBox"sv, "Border"sv, "Btn"sv, "ByteRange"sv, "C"sv, "CA"sv, "CF"sv,
+    "CFM"sv, "CIDFontType0"sv, "CIDFontType2"sv, "CIDSet"sv, "CIDSystemInfo"sv, "CIDToGIDMap"sv,
+    "CMap"sv, "CMapName"sv, "CS"sv, "CapHeight"sv, "Catalog"sv, "ColorSpace"sv, "Columns"sv,
+    "Contents"sv, "Count"sv, "CreationDate"sv, "Creator"sv, "CropBox"sv, "D"sv, "DA"sv,
+    "DCTDecode"sv, "DR"sv, "DS"sv, "DSS"sv, "DW"sv, "Decode"sv, "DecodeParms"sv,
+    "DescendantFonts"sv, "Descent"sv, "Dest"sv, "Dests"sv, "DeviceCMYK"sv, "DeviceGray"sv,
+    "DeviceRGB"sv, "Differences"sv, "DocMDP"sv, "Domain"sv, "E"sv, "EF"sv, "EmbeddedFile"sv,
+    "EmbeddedFiles"sv, "Encode"sv, "Encoding"sv, "Encrypt"sv, "EncryptMetadata"sv, "ExtGState"sv,
+    "ExtensionLevel"sv, "Extensions"sv, "F"sv, "FS"sv, "FT"sv, "Ff"sv, "Fields"sv, "Filespec"sv,
+    "Filter"sv, "First"sv, "FirstChar"sv, "Flags"sv, "FlateDecode"sv, "Fo"sv, "Font"sv,
+    "FontBBox"sv, "FontDescriptor"sv, "FontFamily"sv, "FontFile"sv, "FontFile2"sv, "FontFile3"sv,
+    "FontMatrix"sv, "FontName"sv, "FontStretch"sv, "FontWeight"sv, "Form"sv, "FormType"sv,
+    "Frequency"sv, "FunctionType"sv, "Group"sv, "H"sv, "HT"sv, "HalftoneType"sv, "Height"sv, "I"sv,
+    "ICCBased"sv, "ID"sv, "IDS"sv, "Identity"sv, "Identity-H"sv, "Identity-V"sv, "Image"sv,
+    "ImageB"sv, "ImageC"sv, "ImageI"sv, "Index"sv, "Indexed"sv, "Info"sv, "Interpolate"sv,
+    "ItalicAngle"sv, "JS"sv, "JavaScript"sv, "K"sv, "Keywords"sv, "Kids"sv, "L"sv, "Lab"sv,
+    "Lang"sv, "Last"sv, "LastChar"sv, "Leading"sv, "Length"sv, "Length1"sv, "Length2"sv,
+    "Length3"sv, "Limits"sv, "Linearized"sv, "Link"sv, "Location"sv, "M"sv, "MK"sv,
+    "MacExpertEncoding"sv, "MacRomanEncoding"sv, "MarkInfo"sv, "Marked"sv, "Mask"sv, "Matrix"sv,
+    "MaxLen"sv, "MaxWidth"sv, "MediaBox"sv, "Metadata"sv, "MissingWidth"sv, "ModDate"sv, "N"sv,
+    "Name"sv, "Names"sv, "NeedAppearances"sv, "Next"sv, "O"sv, "OE"sv, "OP"sv, "OPM"sv, "ObjStm"sv,
+    "Off"sv, "Open"sv, "OpenAction"sv, "Opt"sv, "Ordering"sv, "Outlines"sv, "P"sv, "PC"sv, "PDF"sv,
+    "PI"sv, "PO"sv, "PV"sv, "Page"sv, "PageLayout"sv, "PageMode"sv, "Pages"sv, "Params"sv,
+    "Parent"sv, "Pattern"sv, "Perms"sv, "Predictor"sv, "Prev"sv, "ProcSet"sv, "Producer"sv,
+    "Prop_Build"sv, "Properties"sv, "QuadPoints"sv, "R"sv, "RC"sv, "RG"sv, "RI"sv, "RV"sv,
+    "Range"sv, "Reason"sv, "Rect"sv, "Reference"sv, "Registry"sv, "Renditions"sv, "Resources"sv,
+    "Root"sv, "Rotate"sv, "S"sv, "SMask"sv, "Separation"sv, "Shading"sv, "Sig"sv, "SigFlags"sv,
+    "SigRef"sv, "Size"sv, "SpotFunction"sv, "StdCF"sv, "StemH"sv, "StemV"sv, "StmF"sv, "StrF"sv,
+    "StructParent"sv, "StructParents"sv, "StructTreeRoot"sv, "SubFilter"sv, "Subject"sv,
+    "Subtype"sv, "Supplement"sv, "T"sv, "TM"sv, "TU"sv, "Tabs"sv, "Templates"sv, "Text"sv,
+    "Title"sv, "ToUnicode"sv, "TransformMethod"sv, "TransformParams"sv, "Trapped"sv, "TrimBox"sv,
+    "TrueType"sv, "Type"sv, "Type0"sv, "Type1"sv, "Type3"sv, "U"sv, "UE"sv, "UF"sv, "URI"sv,
+    "URLS"sv, "V"sv, "Version"sv, "ViewerPreferences"sv, "W"sv, "W2"sv, "WhitePoint"sv, "Widget"sv,
+    "Width"sv, "Widths"sv, "WinAnsiEncoding"sv, "X"sv, "XHeight"sv, "XML"sv, "XObject"sv, "XRef"sv,
+    "Yes"sv, "ca"sv, "op"sv
+};
+
+static constexpr bool isSorted()
+{
+    for (size_t i = 1; i < std::size(s_knownNames); i++)
+    {
+        if (!(s_knownNames[i - 1] < s_knownNames[i]))
+            return false;
+    }
+
+    return true;
+}
+
+static_assert(isSorted(), "The known names must be sorted");
+
+bool PoDoFo::TryGetKnownName(const string_view& name, string_view& known)
+{
+    auto found = std::lower_bound(std::begin(s_knownNames), std::end(s_knownNames), name);
+    if (found == std::end(s_knownNames) || *found != name)
+        return false;
+
+    known = *found;
+    return true;
+}
@@ -0,0 +1,21 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#ifndef PDF_KNOWN_NAMES_H
+#define PDF_KNOWN_NAMES_H
+
+namespace PoDoFo
+{
+    /** Find the given raw name data in the static table of well known names
+     *
+     * \param known on true return, a view of the name in the table, which
+     *      has static storage duration and it's the same for all the lookups
+     *      of the same name
+     */
+    bool TryGetKnownName(const std::string_view& name, std::string_view& known);
+}
+
+#endif // PDF_KNOWN_NAMES_H
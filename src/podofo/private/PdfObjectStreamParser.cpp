@@ -10,6 +10,7 @@
 #include <algorithm>
 
 #include <podofo/main/PdfDictionary.h>
+#include <podofo/main/PdfDocument.h>
 #include <podofo/main/PdfIndirectObjectList.h>
 #include <podofo/auxiliary/StreamDevice.h>
 
@@ -26,29 +27,63 @@ PdfObjectStreamParser::PdfObjectStreamParser(PdfParserObject& parser,
 
 void PdfObjectStreamParser::Parse(const cspan<int64_t>& objectList)
 {
-    int64_t num = m_Parser->GetDictionary().FindKeyAsSafe<int64_t>("N", 0);
-    int64_t first = m_Parser->GetDictionary().FindKeyAsSafe<int64_t>("First", 0);
+    vector<unique_ptr<PdfObject>> objects;
+    Read(objectList, objects);
+    for (auto& obj : objects)
+        m_Objects->PushObject(obj.release());
 
-    charbuff buffer;
-    m_Parser->GetOrCreateStream().CopyTo(buffer);
-
-    this->readObjectsFromStream(buffer.data(), buffer.size(), num, first, objectList);
     m_Parser = nullptr;
 }
 
-void PdfObjectStreamParser::readObjectsFromStream(char* buffer, size_t bufferLen,
-    int64_t num, int64_t first, const cspan<int64_t>& objectList)
+void PdfObjectStreamParser::Read(const cspan<int64_t>& objectList, vector<unique_ptr<PdfObject>>& objects)
 {
-    SpanStreamDevice device(buffer, bufferLen);
-    PdfTokenizer tokenizer(m_buffer);
+    PdfDecodedObjectStream decoded;
+    Decode(*m_Parser, decoded, m_buffer);
+
+    // The objects may be parsed in a list with no document
+    auto doc = m_Parser->GetDocument();
+    auto resource = doc == nullptr ? nullptr : doc->GetMemoryResource();
     PdfVariant var;
-    int i = 0;
+    for (auto& pair : decoded.Objects)
+    {
+        bool shouldRead = std::find(objectList.begin(), objectList.end(), (int64_t)pair.first) != objectList.end();
+#ifndef VERBOSE_DEBUG_DISABLED
+        std::cerr << "ReadObjectsFromStream STREAM=" << m_Parser->GetIndirectReference().ToString() <<
+            ", OBJ=" << pair.first <<
+            ", " << (shouldRead ? "read" : "skipped") << std::endl;
+#endif
+        if (!shouldRead)
+            continue;
+
+        ReadObject(decoded, pair.second, var, m_buffer, resource);
 
-    while (i < num)
+        // The generation number of an object stream and of any
+        // compressed object is implicitly zero
+        PdfReference reference(pair.first, 0);
+        unique_ptr<PdfObject> obj(new PdfObject(std::move(var)));
+        obj->SetIndirectReference(reference);
+        objects.push_back(std::move(obj));
+    }
+}
+
+void PdfObjectStreamParser::Decode(const PdfObject& streamObj, PdfDecodedObjectStream& decoded,
+    const shared_ptr<charbuff>& buffer)
+{
+    int64_t num = streamObj.GetDictionary().FindKeyAsSafe<int64_t>("N", 0);
+    int64_t first = streamObj.GetDictionary().FindKeyAsSafe<int64_t>("First", 0);
+
+    decoded.Data.clear();
+    decoded.Objects.clear();
+    streamObj.MustGetStream().CopyTo(decoded.Data);
+
+    SpanStreamDevice device(decoded.Data.data(), decoded.Data.size());
+    PdfTokenizer tokenizer(buffer);
+    for (int64_t i = 0; i < num; i++)
     {
         int64_t objNo = tokenizer.ReadNextNumber(device);
         int64_t offset = tokenizer.ReadNextNumber(device);
-        size_t pos = device.GetPosition();
+        if (objNo < 0 || objNo > std::numeric_limits<uint32_t>::max() || offset < 0)
+            PODOFO_RAISE_ERROR_INFO(PdfErrorCode::BrokenFile, "Invalid object stream entry");
 
         if (first >= std::numeric_limits<int64_t>::max() - offset)
         {
@@ -56,32 +91,55 @@ void PdfObjectStreamParser::readObjectsFromStream(char* buffer, size_t bufferLen
                 "Object position out of max limit");
         }
 
-        // move to the position of the object in the stream
-        device.Seek(static_cast<size_t>(first + offset));
+        decoded.Objects.push_back({ (uint32_t)objNo, (size_t)(first + offset) });
+    }
+}
+
+void PdfObjectStreamParser::ReadObject(const PdfDecodedObjectStream& decoded, size_t offset,
+    PdfVariant& var, const shared_ptr<charbuff>& buffer, pmr::memory_resource* resource)
+{
+    SpanStreamDevice device(decoded.Data.data(), decoded.Data.size());
+    device.Seek(offset);
+
+    // Use a new tokenizer for each object, so that no token
+    // read ahead while parsing a previous object is reused
+    PdfTokenizerOptions options;
+    options.MemoryResource = resource;
+    PdfTokenizer tokenizer(buffer, options);
+    tokenizer.ReadNextVariant(device, var); // NOTE: The stream is already decrypted
+}
 
-        // use a second tokenizer here so that anything that gets dequeued isn't left in the tokenizer that reads the offsets and lengths
-        PdfTokenizer variantTokenizer(m_buffer);
-        variantTokenizer.ReadNextVariant(device, var); // NOTE: The stream is already decrypted
+PdfObjectStreamCache::PdfObjectStreamCache(PdfIndirectObjectList& objects,
+        const shared_ptr<charbuff>& buffer, unsigned capacity)
+    : m_Objects(&objects), m_buffer(buffer), m_capacity(capacity)
+{
+    if (buffer == nullptr || capacity == 0)
+        PODOFO_RAISE_ERROR(PdfErrorCode::InvalidHandle);
+}
 
-        bool shouldRead = std::find(objectList.begin(), objectList.end(), objNo) != objectList.end();
-#ifndef VERBOSE_DEBUG_DISABLED
-        std::cerr << "ReadObjectsFromStream STREAM=" << m_Parser->GetIndirectReference().ToString() <<
-            ", OBJ=" << objNo <<
-            ", " << (shouldRead ? "read" : "skipped") << std::endl;
-#endif
-        if (shouldRead)
+shared_ptr<const PdfDecodedObjectStream> PdfObjectStreamCache::GetStream(uint32_t objectNum)
+{
+    for (auto it = m_streams.begin(); it != m_streams.end(); it++)
+    {
+        if (it->first == objectNum)
         {
-            // The generation number of an object stream and of any
-            // compressed object is implicitly zero
-            PdfReference reference(static_cast<uint32_t>(objNo), 0);
-            auto obj = new PdfObject(std::move(var));
-            obj->SetIndirectReference(reference);
-            m_Objects->PushObject(obj);
+            // Move the stream to the front, as the most recently used
+            std::rotate(m_streams.begin(), it, it + 1);
+            return m_streams.front().second;
         }
+    }
 
-        // move back to the position inside of the table of contents
-        device.Seek(pos);
+    // The generation number of object streams is always 0
+    auto streamObj = m_Objects->GetObject(PdfReference(objectNum, 0));
+    if (streamObj == nullptr)
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::ObjectNotFound, "Object stream {} 0 R not found", objectNum);
 
-        i++;
-    }
+    auto decoded = std::make_shared<PdfDecodedObjectStream>();
+    PdfObjectStreamParser::Decode(*streamObj, *decoded, m_buffer);
+
+    if (m_streams.size() == m_capacity)
+        m_streams.pop_back();
+
+    m_streams.insert(m_streams.begin(), { objectNum, decoded });
+    return decoded;
 }
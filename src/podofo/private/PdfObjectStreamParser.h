@@ -14,6 +14,16 @@ namespace PoDoFo {
 class PdfEncrypt;
 class PdfIndirectObjectList;
 
+/**
+ * An object stream decoded in memory, with the
+ * table of the objects it contains
+ */
+struct PdfDecodedObjectStream final
+{
+    charbuff Data;
+    std::vector<std::pair<uint32_t, size_t>> Objects;   ///< Object number and offset in Data of each contained object
+};
+
 /**
  * A utility class for PdfParser that can parse
  * an object stream object (PDF Reference 1.7 3.4.6 Object Streams)
@@ -36,8 +46,28 @@ public:
 
     void Parse(const cspan<int64_t>& objectList);
 
-private:
-    void readObjectsFromStream(char* buffer, size_t lBufferLen, int64_t lNum, int64_t lFirst, const cspan<int64_t>& list);
+    /** Read the objects in the list from the stream, without
+     * adding them to the objects vector
+     * \param objectList numbers of the objects which should be read
+     * \param objects the objects read, in the order of the stream table
+     */
+    void Read(const cspan<int64_t>& objectList, std::vector<std::unique_ptr<PdfObject>>& objects);
+
+    /** Decode the given object stream and read the table of the objects it contains
+     * \param streamObj an object stream object
+     * \param decoded the decoded stream
+     * \param buffer buffer to use for tokenizing
+     */
+    static void Decode(const PdfObject& streamObj, PdfDecodedObjectStream& decoded,
+        const std::shared_ptr<charbuff>& buffer);
+
+    /** Read the object at the given offset of the decoded stream
+     * \param resource memory resource to allocate the read containers
+     *      from, or nullptr to use the default heap
+     */
+    static void ReadObject(const PdfDecodedObjectStream& decoded, size_t offset,
+        PdfVariant& var, const std::shared_ptr<charbuff>& buffer,
+        std::pmr::memory_resource* resource = nullptr);
 
 private:
     PdfParserObject* m_Parser;
@@ -45,6 +75,35 @@ private:
     std::shared_ptr<charbuff> m_buffer;
 };
 
+/**
+ * A small LRU cache of decoded object streams, used by
+ * compressed objects loaded on demand so that accessing
+ * several objects of the same stream decodes it only once
+ */
+class PdfObjectStreamCache final
+{
+public:
+    static constexpr unsigned DefaultCapacity = 4;
+
+public:
+    PdfObjectStreamCache(PdfIndirectObjectList& objects, const std::shared_ptr<charbuff>& buffer,
+        unsigned capacity = DefaultCapacity);
+
+    /** Get the decoded object stream with the given object number,
+     * decoding it if it's not in the cache
+     */
+    std::shared_ptr<const PdfDecodedObjectStream> GetStream(uint32_t objectNum);
+
+    inline const std::shared_ptr<charbuff>& GetBuffer() const { return m_buffer; }
+
+private:
+    PdfIndirectObjectList* m_Objects;
+    std::shared_ptr<charbuff> m_buffer;
+    unsigned m_capacity;
+    // Most recently used streams first
+    std::vector<std::pair<uint32_t, std::shared_ptr<const PdfDecodedObjectStream>>> m_streams;
+};
+
 };
 
 #endif // PDF_OBJECT_STREAM_PARSER_OBJECT_H
@@ -12,13 +12,16 @@
 
 #include <podofo/auxiliary/OutputDevice.h>
 #include <podofo/auxiliary/InputDevice.h>
+#include <podofo/auxiliary/StreamDevice.h>
 
 #include <podofo/main/PdfArray.h>
+#include <podofo/main/PdfCommon.h>
 #include <podofo/main/PdfDictionary.h>
 #include <podofo/main/PdfEncrypt.h>
 #include <podofo/main/PdfMemoryObjectStream.h>
 #include "PdfXRefStreamParserObject.h"
 #include "PdfObjectStreamParser.h"
+#include "PdfCompressedObject.h"
 
 constexpr unsigned PDF_VERSION_LENGHT = 3;
 constexpr unsigned PDF_MAGIC_LENGHT = 8;
@@ -33,12 +36,49 @@ using namespace chromium::base;
 static bool CheckEOL(char e1, char e2);
 static bool CheckXRefEntryType(char c);
 static bool ReadMagicWord(char ch, unsigned& cursoridx);
+static void RunParallel(unsigned threadCount, const string_view& view, size_t count,
+    const function<void(InputStreamDevice& device, size_t index)>& task);
+static size_t FindToken(const string_view& view, const string_view& token, size_t pos);
+static bool TryReadObjectHeader(const string_view& view, size_t objPos,
+    uint32_t& objNum, uint16_t& generation, size_t& offset);
+static bool IsXRefStreamDictionary(const string_view& dict);
+
+namespace
+{
+    // Finds the occurrences of a token at non decreasing positions,
+    // remembering the last one found, so that scanning the input
+    // for a token never searches the same bytes twice
+    class TokenFinder final
+    {
+    public:
+        TokenFinder(const string_view& view, const string_view& token)
+            : m_view(view), m_token(token), m_next(0), m_searched(false) { }
+
+        size_t Find(size_t pos)
+        {
+            if (!m_searched || (m_next != string_view::npos && m_next < pos))
+            {
+                m_next = FindToken(m_view, m_token, pos);
+                m_searched = true;
+            }
+
+            return m_next;
+        }
+
+    private:
+        string_view m_view;
+        string_view m_token;
+        size_t m_next;
+        bool m_searched;
+    };
+}
 
 PdfParser::PdfParser(PdfIndirectObjectList& objects) :
     m_buffer(std::make_shared<charbuff>(PdfTokenizer::BufferSize)),
     m_tokenizer(m_buffer),
     m_Objects(&objects),
-    m_StrictParsing(false)
+    m_StrictParsing(false),
+    m_LoadThreadCount(1)
 {
     this->reset();
 }
@@ -73,7 +113,34 @@ void PdfParser::Parse(InputStreamDevice& device, bool loadOnDemand)
         if (!IsPdfFile(device))
             PODOFO_RAISE_ERROR(PdfErrorCode::InvalidPDF);
 
-        ReadDocumentStructure(device);
+        try
+        {
+            ReadDocumentStructure(device);
+        }
+        catch (PdfError& e)
+        {
+            // Don't try to recover when parsing strictly or
+            // when a safety limit was reached
+            if (m_StrictParsing || e == PdfErrorCode::MaxRecursionReached)
+                throw;
+
+            PoDoFo::LogMessage(PdfLogSeverity::Warning,
+                "Unable to read the xref structure, reconstructing it");
+            bool reconstructed = false;
+            try
+            {
+                reconstructXRef(device);
+                reconstructed = true;
+            }
+            catch (PdfError&)
+            {
+                // Report the original error instead
+            }
+
+            if (!reconstructed)
+                throw;
+        }
+
         ReadObjects(device);
     }
     catch (PdfError& e)
@@ -212,6 +279,137 @@ void PdfParser::mergeTrailer(const PdfObject& trailer)
         m_Trailer->GetDictionary().AddKey("ID"_n, *obj);
 }
 
+void PdfParser::reconstructXRef(InputStreamDevice& device)
+{
+    string_view view;
+    charbuff buffer;
+    if (!device.TryGetView(view))
+    {
+        device.Seek(0, SeekDirection::End);
+        buffer.resize(device.GetPosition());
+        device.Seek(0, SeekDirection::Begin);
+        device.Read(buffer.data(), buffer.size());
+        view = string_view(buffer.data(), buffer.size());
+    }
+
+    m_entries.Clear();
+    m_Trailer = nullptr;
+    m_visitedXRefOffsets.clear();
+    m_HasXRefStream = false;
+    m_XRefOffset = 0;
+    m_FileSize = view.size();
+
+    // Scan the input once for object headers and trailers. Stream
+    // data is skipped, as it may contain anything. Later objects
+    // replace earlier ones with the same number, as they do
+    // in incremental updates
+    TokenFinder objs(view, "obj");
+    TokenFinder endObjs(view, "endobj");
+    TokenFinder streams(view, "stream");
+    TokenFinder endStreams(view, "endstream");
+    TokenFinder trailers(view, "trailer");
+    vector<size_t> trailerOffsets;
+    vector<size_t> xrefStreamOffsets;
+    size_t pos = 0;
+    while (true)
+    {
+        size_t objPos = objs.Find(pos);
+        size_t trailerPos = trailers.Find(pos);
+        if (trailerPos < objPos)
+        {
+            trailerOffsets.push_back(trailerPos);
+            pos = trailerPos + 7;
+            continue;
+        }
+
+        if (objPos == string_view::npos)
+            break;
+
+        pos = objPos + 3;
+        uint32_t objNum;
+        uint16_t generation;
+        size_t offset;
+        if (!TryReadObjectHeader(view, objPos, objNum, generation, offset)
+            || objNum == 0 || objNum >= PdfCommon::GetMaxObjectCount())
+        {
+            continue;
+        }
+
+        m_entries.Enlarge(objNum + 1);
+        auto& entry = m_entries[objNum];
+        entry = PdfXRefEntry::CreateInUse(offset, generation);
+        entry.Parsed = true;
+
+        // The stream keyword must precede the end of the object
+        size_t streamPos = streams.Find(pos);
+        if (streamPos >= std::min(endObjs.Find(pos), objs.Find(pos))
+            || (streamPos >= 3 && view.substr(streamPos - 3, 3) == "end"))
+        {
+            continue;
+        }
+
+        if (IsXRefStreamDictionary(view.substr(pos, streamPos - pos)))
+            xrefStreamOffsets.push_back(offset);
+
+        size_t endStreamPos = endStreams.Find(streamPos + 6);
+        if (endStreamPos == string_view::npos)
+            break;
+
+        pos = endStreamPos + 9;
+    }
+
+    // Read the most recent trailers first, as keys already
+    // read take precedence when merging the other ones. Don't
+    // follow /Prev, as the offsets are likely broken
+    for (auto it = trailerOffsets.rbegin(); it != trailerOffsets.rend(); it++)
+    {
+        try
+        {
+            device.Seek(*it);
+            readNextTrailer(device, true);
+        }
+        catch (PdfError& e)
+        {
+            if (e == PdfErrorCode::MaxRecursionReached)
+                throw;
+
+            // Discard the trailer if it couldn't be parsed at all
+            if (m_Trailer != nullptr && !m_Trailer->IsDelayedLoadDone())
+                m_Trailer = nullptr;
+
+            PoDoFo::LogMessage(PdfLogSeverity::Warning,
+                "Skipping invalid trailer at offset {}", *it);
+        }
+    }
+
+    // Xref streams may supply the trailer and the entries
+    // of the compressed objects, which are not found by the scan
+    for (auto it = xrefStreamOffsets.rbegin(); it != xrefStreamOffsets.rend(); it++)
+    {
+        try
+        {
+            ReadXRefStreamContents(device, *it, true);
+        }
+        catch (PdfError& e)
+        {
+            if (e == PdfErrorCode::MaxRecursionReached)
+                throw;
+
+            PoDoFo::LogMessage(PdfLogSeverity::Warning,
+                "Skipping invalid xref stream at offset {}", *it);
+        }
+    }
+
+    if (m_Trailer == nullptr || !m_Trailer->IsDictionary()
+        || m_Trailer->GetDictionary().GetKey("Root") == nullptr)
+    {
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::InvalidTrailer, "No valid trailer found while reconstructing the xref");
+    }
+
+    // The revisions can't be recovered
+    m_IncrementalUpdateCount = 0;
+}
+
 void PdfParser::readNextTrailer(InputStreamDevice& device, bool skipFollowPrevious)
 {
     utls::RecursionGuard guard;
@@ -757,19 +955,29 @@ void PdfParser::readObjectsInternal(InputStreamDevice& device)
         // robustly from all places which are either free or unparsed
     }
 
+    string_view view;
+    if (!m_LoadOnDemand && m_LoadThreadCount != 1 && m_Encrypt == nullptr
+        && device.TryGetView(view))
+    {
+        readObjectsParallel(view, compressedObjects);
+        updateDocumentVersion();
+        return;
+    }
+
     // all normal objects including object streams are available now,
     // we can parse the object streams safely now.
     //
-    // Note that even if demand loading is enabled we still currently read all
-    // objects from the stream into memory then free the stream.
-    //
+    // If demand loading is enabled the compressed objects are created
+    // as placeholders: their object stream is decoded only when one
+    // of them is first accessed, through a small cache shared by all
+    // of them. Otherwise all objects are read from the streams into memory
+    shared_ptr<PdfObjectStreamCache> streamCache;
+    if (m_LoadOnDemand && compressedObjects.size() != 0)
+        streamCache = std::make_shared<PdfObjectStreamCache>(*m_Objects, m_buffer);
+
     for (auto& pair : compressedObjects)
     {
-#ifndef VERBOSE_DEBUG_DISABLED
-        if (m_LoadOnDemand)
-            cerr << "Demand loading on, but can't demand-load from object stream." << endl;
-#endif
-        readCompressedObjectFromStream((uint32_t)pair.first, pair.second);
+        readCompressedObjectFromStream((uint32_t)pair.first, pair.second, streamCache);
         m_Objects->AddObjectStream((uint32_t)pair.first);
     }
 
@@ -781,33 +989,136 @@ void PdfParser::readObjectsInternal(InputStreamDevice& device)
         // in a second pass, or (if demand loading is enabled) defer it for later.
         for (auto objToLoad : *m_Objects)
         {
+            // Objects read from object streams have no stream to parse
             auto obj = dynamic_cast<PdfParserObject*>(objToLoad);
-            obj->ParseStream();
+            if (obj != nullptr)
+                obj->ParseStream();
         }
     }
 
     updateDocumentVersion();
 }
 
-void PdfParser::readCompressedObjectFromStream(uint32_t objNo, const cspan<int64_t>& objectList)
+void PdfParser::readObjectsParallel(const string_view& view, const map<int64_t, vector<int64_t>>& compressedObjects)
+{
+    // Parse the object or its stream reading from the device of the
+    // worker, which is positioned independently from the others
+    auto parseFrom = [](PdfParserObject& obj, InputStreamDevice& device, bool parseStream) {
+        auto prevDevice = obj.m_device;
+        obj.m_device = &device;
+        try
+        {
+            if (parseStream)
+                obj.ParseStream();
+            else
+                obj.Parse();
+        }
+        catch (...)
+        {
+            obj.m_device = prevDevice;
+            throw;
+        }
+        obj.m_device = prevDevice;
+    };
+
+    // Once the XRef offsets are known, objects are independent byte
+    // ranges: parse them sorted by offset, so each worker reads
+    // a disjoint region of the input. No reference is resolved here
+    auto objects = getParserObjectsByOffset();
+    RunParallel(m_LoadThreadCount, view, objects.size(), [&](InputStreamDevice& device, size_t index) {
+        parseFrom(*objects[index], device, false);
+    });
+
+    // Object streams are independent as well. Their /Length may reference
+    // only regular objects, which are all parsed now. The compressed
+    // objects are then merged in the same order as the sequential load
+    vector<pair<PdfParserObject*, cspan<int64_t>>> streams;
+    for (auto& pair : compressedObjects)
+        streams.push_back({ getObjectStream((uint32_t)pair.first), pair.second });
+
+    vector<vector<unique_ptr<PdfObject>>> streamObjects(streams.size());
+    RunParallel(m_LoadThreadCount, view, streams.size(), [&](InputStreamDevice& device, size_t index) {
+        auto streamObj = streams[index].first;
+        if (streamObj == nullptr)
+            return;
+
+        parseFrom(*streamObj, device, true);
+        PdfObjectStreamParser parserObject(*streamObj, *m_Objects,
+            std::make_shared<charbuff>(PdfTokenizer::BufferSize));
+        parserObject.Read(streams[index].second, streamObjects[index]);
+    });
+
+    unsigned i = 0;
+    for (auto& pair : compressedObjects)
+    {
+        for (auto& obj : streamObjects[i])
+            m_Objects->PushObject(obj.release());
+
+        m_Objects->AddObjectStream((uint32_t)pair.first);
+        i++;
+    }
+
+    // Finally read the streams: all the objects they may
+    // reference for /Length, /Filter or /DecodeParms are loaded
+    objects = getParserObjectsByOffset();
+    RunParallel(m_LoadThreadCount, view, objects.size(), [&](InputStreamDevice& device, size_t index) {
+        parseFrom(*objects[index], device, true);
+    });
+}
+
+vector<PdfParserObject*> PdfParser::getParserObjectsByOffset()
+{
+    vector<PdfParserObject*> ret;
+    for (auto obj : *m_Objects)
+    {
+        // Objects read from object streams don't need further parsing
+        auto parserObj = dynamic_cast<PdfParserObject*>(obj);
+        if (parserObj != nullptr)
+            ret.push_back(parserObj);
+    }
+
+    std::sort(ret.begin(), ret.end(), [](const PdfParserObject* lhs, const PdfParserObject* rhs) {
+        return lhs->GetOffset() < rhs->GetOffset();
+    });
+    return ret;
+}
+
+PdfParserObject* PdfParser::getObjectStream(uint32_t objNo)
 {
     // generation number of object streams is always 0
     auto streamObj = dynamic_cast<PdfParserObject*>(m_Objects->GetObject(PdfReference(objNo, 0)));
     if (streamObj == nullptr)
     {
         if (m_IgnoreBrokenObjects)
-        {
             PoDoFo::LogMessage(PdfLogSeverity::Error, "Loading of object {} 0 R failed!", objNo);
-            return;
-        }
         else
-        {
             PODOFO_RAISE_ERROR_INFO(PdfErrorCode::InvalidObject, "Loading of object {} 0 R failed!", objNo);
-        }
     }
 
-    PdfObjectStreamParser parserObject(*streamObj, *m_Objects, m_buffer);
-    parserObject.Parse(objectList);
+    return streamObj;
+}
+
+void PdfParser::readCompressedObjectFromStream(uint32_t objNo, const cspan<int64_t>& objectList,
+    const shared_ptr<PdfObjectStreamCache>& streamCache)
+{
+    auto streamObj = getObjectStream(objNo);
+    if (streamObj == nullptr)
+        return;
+
+    if (streamCache == nullptr)
+    {
+        PdfObjectStreamParser parserObject(*streamObj, *m_Objects, m_buffer);
+        parserObject.Parse(objectList);
+        return;
+    }
+
+    for (int64_t compressedObjNo : objectList)
+    {
+        // The generation number of any compressed object is implicitly zero
+        auto& entry = m_entries[(unsigned)compressedObjNo];
+        m_Objects->PushObject(new PdfCompressedObject(m_Objects->GetDocument(),
+            PdfReference((uint32_t)compressedObjNo, 0), objNo, entry.Index, streamCache));
+    }
 }
 
 void PdfParser::findTokenBackward(InputStreamDevice& device, const char* token, size_t range, size_t searchEnd)
@@ -1017,3 +1328,99 @@ bool ReadMagicWord(char ch, unsigned& cursoridx)
 
     return false;
 }
+
+void RunParallel(unsigned threadCount, const string_view& view, size_t count,
+    const function<void(InputStreamDevice& device, size_t index)>& task)
+{
+    // Each task reads from its own device over the
+    // view, which is positioned independently
+    utls::RunParallel(threadCount, count, [&](size_t index) {
+        SpanStreamDevice device(view);
+        task(device, index);
+    });
+}
+
+size_t FindToken(const string_view& view, const string_view& token, size_t pos)
+{
+    PODOFO_ASSERT(token.size() != 0);
+
+    // Look for the last character of the token with memchr, which
+    // is vectorized by the C runtime, then compare the rest of it.
+    // The last characters of the keywords searched while
+    // reconstructing the xref are rare in regular contents
+    size_t last = token.size() - 1;
+    const char* data = view.data();
+    size_t size = view.size();
+    size_t i = pos + last;
+    while (i < size)
+    {
+        auto found = (const char*)std::memchr(data + i, token[last], size - i);
+        if (found == nullptr)
+            break;
+
+        i = (size_t)(found - data);
+        if (std::memcmp(found - last, token.data(), last) == 0)
+            return i - last;
+
+        i++;
+    }
+
+    return string_view::npos;
+}
+
+bool TryReadObjectHeader(const string_view& view, size_t objPos,
+    uint32_t& objNum, uint16_t& generation, size_t& offset)
+{
+    // Match "<number> <generation> obj" backwards from the "obj" keyword
+    if (objPos + 3 < view.size() && IsCharRegular(view[objPos + 3]))
+        return false;
+
+    auto skipWhitespaces = [&view](size_t& i) {
+        size_t end = i;
+        while (i != 0 && IsCharWhitespace(view[i - 1]))
+            i--;
+
+        return i != end;
+    };
+
+    auto readNumberBackward = [&view](size_t& i, unsigned maxDigits, uint64_t& num) {
+        uint64_t multiplier = 1;
+        unsigned digits = 0;
+        num = 0;
+        while (i != 0 && digits < maxDigits && view[i - 1] >= '0' && view[i - 1] <= '9')
+        {
+            num += (uint64_t)(view[i - 1] - '0') * multiplier;
+            multiplier *= 10;
+            digits++;
+            i--;
+        }
+
+        return digits != 0;
+    };
+
+    size_t i = objPos;
+    uint64_t gen;
+    uint64_t num;
+    if (!skipWhitespaces(i)
+        || !readNumberBackward(i, 5, gen)
+        || !skipWhitespaces(i)
+        || !readNumberBackward(i, 10, num)
+        || (i != 0 && IsCharRegular(view[i - 1]))
+        || gen > numeric_limits<uint16_t>::max()
+        || num > numeric_limits<uint32_t>::max())
+    {
+        return false;
+    }
+
+    objNum = (uint32_t)num;
+    generation = (uint16_t)gen;
+    offset = i;
+    return true;
+}
+
+bool IsXRefStreamDictionary(const string_view& dict)
+{
+    size_t pos = FindToken(dict, "/XRef", 0);
+    return pos != string_view::npos
+        && (pos + 5 == dict.size() || !IsCharRegular(dict[pos + 5]));
+}
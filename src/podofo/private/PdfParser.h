@@ -16,6 +16,7 @@
 namespace PoDoFo {
 
 class PdfEncrypt;
+class PdfObjectStreamCache;
 
 /**
  * PdfParser reads a PDF file into memory.
@@ -27,6 +28,7 @@ class PdfParser
 {
     friend class PdfParserTest;
     friend class PdfDocument;
+    friend class PdfDocumentProbe;
     friend class PdfWriter;
 
 public:
@@ -129,10 +131,9 @@ public:
      * Strict parsing is by default disabled.
      *
      * If you enable strict parsing, PoDoFo will fail
-     * on a few more common PDF failures. Please note
-     * that PoDoFo's parser is by default very strict
-     * already and does not recover from e.g. wrong XREF
-     * tables.
+     * on a few more common PDF failures. In particular
+     * the xref entries are not reconstructed by scanning
+     * the file when the xref structure is broken.
      *
      * \param strict new setting for strict parsing mode.
      */
@@ -155,6 +156,30 @@ public:
      */
     inline void SetIgnoreBrokenObjects(bool broken) { m_IgnoreBrokenObjects = broken; }
 
+    /**
+     * \returns the number of threads used to parse the objects
+     *      when the document is not loaded on demand
+     */
+    inline unsigned GetLoadThreadCount() const { return m_LoadThreadCount; }
+
+    /**
+     * Set the number of threads used to parse the objects
+     * when the document is not loaded on demand.
+     *
+     * Default is 1, which parses all objects on the calling thread.
+     * If 0, std::thread::hardware_concurrency() is used. Parallel
+     * parsing is performed only if the contents of the input device
+     * are contiguous in memory (see InputStreamDevice::TryGetView())
+     * and the document is not encrypted, otherwise it falls back
+     * to sequential parsing.
+     *
+     * \remarks the objects vector should have no observers
+     *      attached, as streams are read concurrently. For the same
+     *      reason the memory resource of the document, if any, must
+     *      be thread safe (e.g. std::pmr::synchronized_pool_resource)
+     */
+    inline void SetLoadThreadCount(unsigned count) { m_LoadThreadCount = count; }
+
     inline size_t GetXRefOffset() const { return m_XRefOffset; }
 
     inline bool HasXRefStream() const { return m_HasXRefStream; }
@@ -253,21 +278,47 @@ private:
      */
     void readObjectsInternal(InputStreamDevice& device);
 
-    /** Read the object with index from the object stream nObjNo
-     *  and push it on the objects vector
+    /** Read the objects in the list from the object stream objNo
+     *  and push them on the objects vector
      *
-     *  All objects are read from this stream and the stream object
-     *  is free'd from memory. Further calls who try to read from the
-     *  same stream simply do nothing.
+     *  If a stream cache is supplied, the objects are pushed as
+     *  placeholders that will decode the stream on first access,
+     *  otherwise they are all read into memory immediately
      *
      *  \param objNo object number of the stream object
-     *  \param index index of the object which should be parsed
+     *  \param objectList numbers of the objects which should be read
+     *  \param streamCache cache of decoded object streams, or nullptr
+     */
+    void readCompressedObjectFromStream(uint32_t objNo, const cspan<int64_t>& objectList,
+        const std::shared_ptr<PdfObjectStreamCache>& streamCache);
+
+    /** Parse all the objects, the object streams and the streams
+     *  on a pool of threads, each reading from its own device
+     *  over the given view of the input
      *
+     *  \param view the whole input contents
+     *  \param compressedObjects numbers of the objects to read from each object stream
+     */
+    void readObjectsParallel(const std::string_view& view,
+        const std::map<int64_t, std::vector<int64_t>>& compressedObjects);
+
+    /** Get the objects to be parsed from the input, sorted by offset
      */
-    void readCompressedObjectFromStream(uint32_t objNo, const cspan<int64_t>& objectList);
+    std::vector<PdfParserObject*> getParserObjectsByOffset();
+
+    /** Get the object stream with the given number
+     *  \returns nullptr if not found and broken objects are ignored
+     */
+    PdfParserObject* getObjectStream(uint32_t objNo);
 
     void readNextTrailer(InputStreamDevice& device, bool skipFollowPrevious);
 
+    /** Rebuild the xref entries and the trailer when the xref
+     *  structure is broken, scanning the whole input once for
+     *  object headers, trailers and xref streams
+     */
+    void reconstructXRef(InputStreamDevice& device);
+
 
     /** Checks for the existence of the %%EOF marker at the end of the file.
      *  When strict mode is off it will also attempt to setup the parser to ignore
@@ -321,6 +372,7 @@ private:
 
     bool m_StrictParsing;
     bool m_IgnoreBrokenObjects;
+    unsigned m_LoadThreadCount;
 
     unsigned m_IncrementalUpdateCount;
 
@@ -9,6 +9,7 @@
 
 #include <podofo/main/PdfArray.h>
 #include <podofo/main/PdfDictionary.h>
+#include <podofo/main/PdfDocument.h>
 
 #include "PdfFilterFactory.h"
 
@@ -69,7 +70,7 @@ void PdfParserObject::ParseStream()
 
 void PdfParserObject::delayedLoad()
 {
-    PdfTokenizer tokenizer;
+    PdfTokenizer tokenizer(GetTokenizerOptions());
     m_device->Seek(m_Offset);
     if (!m_IsTrailer)
         checkReference(tokenizer);
@@ -111,6 +112,16 @@ void PdfParserObject::SetRevised()
     m_IsRevised = true;
 }
 
+PdfTokenizerOptions PdfParserObject::GetTokenizerOptions() const
+{
+    PdfTokenizerOptions options;
+    auto doc = GetDocument();
+    if (doc != nullptr)
+        options.MemoryResource = doc->GetMemoryResource();
+
+    return options;
+}
+
 PdfReference PdfParserObject::ReadReference(PdfTokenizer& tokenizer)
 {
     m_device->Seek(m_Offset);
@@ -20,6 +20,7 @@ namespace PoDoFo {
 class PdfParserObject : public PdfObject
 {
     friend class PdfParser;
+    friend class PdfDocumentProbe;
 
 private:
     /** Parse the object data from the given file handle starting at
@@ -71,6 +72,11 @@ protected:
     PdfReference ReadReference(PdfTokenizer& tokenizer);
     void Parse(PdfTokenizer& tokenizer);
 
+    /** Get the options to tokenize the object, allocating the
+     *  read containers from the memory resource of the document
+     */
+    PdfTokenizerOptions GetTokenizerOptions() const;
+
     /** Returns if this object has a stream object appended.
      *  which has to be parsed.
      *  \returns true if there is a stream
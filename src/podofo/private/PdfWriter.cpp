@@ -10,7 +10,9 @@
 #include <podofo/auxiliary/StreamDevice.h>
 #include <podofo/main/PdfDate.h>
 #include <podofo/main/PdfDictionary.h>
+#include <podofo/main/PdfMemoryObjectStream.h>
 #include "PdfParserObject.h"
+#include "PdfFilterFactory.h"
 #include "PdfXRefStream.h"
 #include "OpenSSLInternal.h"
 
@@ -23,17 +25,32 @@ using namespace PoDoFo;
 
 static PdfWriteFlags toWriteFlags(PdfSaveOptions opts, PdfALevel pdfaLevel);
 
+// The object stream being filled. The objects are serialized
+// in the data, while the header holds the pairs of object
+// numbers and offsets in the data, as per ISO 32000-2:2020 7.5.7
+struct PdfWriter::ObjectStream
+{
+    uint32_t ObjectNumber;
+    unsigned Count;
+    charbuff Header;
+    charbuff Data;
+};
+
 PdfWriter::PdfWriter(PdfIndirectObjectList* objects, const PdfObject& trailer) :
     m_Objects(objects),
     m_Trailer(&trailer),
     m_Version(PdfVersionDefault),
     m_PdfALevel(PdfALevel::Unknown),
     m_UseXRefStream(false),
+    m_ObjectStreamSize(DefaultObjectStreamSize),
+    m_SaveThreadCount(1),
     m_Encrypt(nullptr),
     m_EncryptObj(nullptr),
     m_SaveOptions(PdfSaveOptions::None),
     m_WriteFlags(PdfWriteFlags::None),
+    m_nextQueuedStream(0),
     m_PrevXRefOffset(0),
+    m_XRefOffset(-1),
     m_IncrementalUpdate(false),
     m_rewriteXRefTable(false)
 {
@@ -67,6 +84,10 @@ void PdfWriter::initWriteFlags()
 
 void PdfWriter::Write(OutputStreamDevice& device)
 {
+    // Compressed objects can be referenced only by a XRef stream
+    if (!m_IncrementalUpdate && (m_SaveOptions & PdfSaveOptions::UseObjectStreams) != PdfSaveOptions::None)
+        SetUseXRefStream(true);
+
     CreateFileIdentifier(m_identifier, *m_Trailer, &m_originalIdentifier);
 
     // setup encrypt dictionary
@@ -96,6 +117,7 @@ void PdfWriter::Write(OutputStreamDevice& device)
             xRef->SetFirstEmptyBlock();
 
         xRef->Write(device, m_buffer);
+        m_XRefOffset = (int64_t)xRef->GetOffset();
     }
     catch (PdfError& e)
     {
@@ -128,64 +150,284 @@ void PdfWriter::WritePdfHeader(OutputStreamDevice& device)
 
 void PdfWriter::WritePdfObjects(OutputStreamDevice& device, const PdfIndirectObjectList& objects, PdfXRef& xref)
 {
-    unique_ptr<PdfStatefulEncrypt> encrypt;
+    if (m_IncrementalUpdate && !m_rewriteXRefTable)
+    {
+        // Only the objects set dirty since the last write are written. The
+        // other objects will not be output in the XRef entries but they
+        // will be counted in trailer's /Size
+        xref.AddInUseObject(PdfReference(objects.GetLastObjectNumber(), 0), nullptr);
+
+        vector<PdfObject*> dirtyObjects;
+        m_Objects->GetDirtyObjects(dirtyObjects);
+        if (m_SaveThreadCount != 1)
+            queueStreams(dirtyObjects);
+
+        for (auto obj : dirtyObjects)
+            writeObject(device, *obj, xref);
+
+        // Stop tracking the objects only after all of them have
+        // been written, so they are written again after a failure
+        m_Objects->ClearDirtyObjects();
+    }
+    else
+    {
+        writeAllObjects(device, objects, xref);
+    }
+
+    // Drop the encoded streams of the objects that were not written
+    m_streamQueue.clear();
+    m_streamQueueIndices.clear();
+    m_encodedStreams.clear();
+
+    for (auto& freeObjectRef : objects.GetFreeObjects())
+    {
+        xref.AddFreeObject(freeObjectRef);
+    }
+}
+
+void PdfWriter::writeAllObjects(OutputStreamDevice& device, const PdfIndirectObjectList& objects, PdfXRef& xref)
+{
+    // The object streams are not added to the object list and
+    // take the object numbers following the ones of the document
+    unique_ptr<ObjectStream> objStream;
+    if (m_UseXRefStream && !m_IncrementalUpdate
+        && (m_SaveOptions & PdfSaveOptions::UseObjectStreams) != PdfSaveOptions::None)
+    {
+        objStream.reset(new ObjectStream());
+        objStream->ObjectNumber = objects.GetObjectCount() + 1;
+        objStream->Count = 0;
+    }
+
+    if (m_SaveThreadCount != 1)
+    {
+        // Clean objects are not written in incremental updates,
+        // unless their offset can't be determined
+        vector<PdfObject*> writtenObjects;
+        for (auto obj : objects)
+        {
+            if (!m_IncrementalUpdate || obj->IsDirty())
+                writtenObjects.push_back(obj);
+        }
+
+        queueStreams(writtenObjects);
+    }
+
     for (PdfObject* obj : objects)
     {
-        if (m_Encrypt != nullptr && obj != m_EncryptObj)
-            encrypt.reset(new PdfStatefulEncrypt(m_Encrypt->GetEncrypt(), m_Encrypt->GetContext(), obj->GetIndirectReference()));
-        else
-            encrypt.reset();
+        if (objStream != nullptr && objects.IsObjectStream(obj->GetIndirectReference().ObjectNumber()))
+        {
+            // The object streams read from the document are
+            // superseded by the ones being written
+            continue;
+        }
 
         if (m_IncrementalUpdate && !obj->IsDirty())
         {
-            if (m_rewriteXRefTable)
+            PdfParserObject* parserObject = dynamic_cast<PdfParserObject*>(obj);
+            if (parserObject != nullptr)
             {
-                PdfParserObject* parserObject = dynamic_cast<PdfParserObject*>(obj);
-                if (parserObject != nullptr)
+                // Try to see if we can just write the reference to previous entry
+                // without rewriting the entry
+
+                // the reference looks like "0 0 R", while the object identifier like "0 0 obj", thus add two letters
+                size_t objRefLength = obj->GetIndirectReference().ToString().length() + 2;
+
+                // the offset points just after the "0 0 obj" string
+                if (parserObject->GetOffset() - (ssize_t)objRefLength > 0)
                 {
-                    // Try to see if we can just write the reference to previous entry
-                    // without rewriting the entry
-
-                    // the reference looks like "0 0 R", while the object identifier like "0 0 obj", thus add two letters
-                    size_t objRefLength = obj->GetIndirectReference().ToString().length() + 2;
-
-                    // the offset points just after the "0 0 obj" string
-                    if (parserObject->GetOffset() - (ssize_t)objRefLength > 0)
-                    {
-                        xref.AddInUseObject(obj->GetIndirectReference(), parserObject->GetOffset() - objRefLength);
-                        continue;
-                    }
+                    xref.AddInUseObject(obj->GetIndirectReference(), parserObject->GetOffset() - objRefLength);
+                    continue;
                 }
             }
-            else
-            {
-                // The object will not be output in the XRef entries but it will be
-                // counted in trailer's /Size
-                xref.AddInUseObject(obj->GetIndirectReference(), nullptr);
-                continue;
-            }
         }
 
-        if (xref.ShouldSkipWrite(obj->GetIndirectReference()))
+        if (objStream != nullptr && !xref.ShouldSkipWrite(obj->GetIndirectReference())
+            && canCompressObject(*obj))
         {
-            // If we skip write of this object, we supply a dummy
-            // offset of the object and not retrieve it from the device
-            xref.AddInUseObject(obj->GetIndirectReference(), 0xFFFFFFFF);
+            addToObjectStream(*objStream, *obj, xref);
+            if (objStream->Count == m_ObjectStreamSize)
+                writeObjectStream(device, *objStream, xref);
         }
         else
         {
-            xref.AddInUseObject(obj->GetIndirectReference(), device.GetPosition());
-            // Also make sure that we do not encrypt the encryption dictionary!
-            obj->WriteFinal(device, m_WriteFlags, encrypt.get(), m_buffer);
+            writeObject(device, *obj, xref);
         }
     }
 
-    for (auto& freeObjectRef : objects.GetFreeObjects())
+    if (objStream != nullptr)
     {
-        xref.AddFreeObject(freeObjectRef);
+        if (objStream->Count != 0)
+            writeObjectStream(device, *objStream, xref);
+
+        // Reserve the numbers of the object streams, so they are not
+        // taken by the objects created later and saved in an update
+        if (objStream->ObjectNumber != objects.GetObjectCount() + 1)
+            m_Objects->tryIncrementObjectCount(PdfReference(objStream->ObjectNumber - 1, 0));
+    }
+
+    // All the objects are clean now
+    m_Objects->ClearDirtyObjects();
+}
+
+void PdfWriter::writeObject(OutputStreamDevice& device, PdfObject& obj, PdfXRef& xref)
+{
+    if (xref.ShouldSkipWrite(obj.GetIndirectReference()))
+    {
+        // If we skip write of this object, we supply a dummy
+        // offset of the object and not retrieve it from the device
+        xref.AddInUseObject(obj.GetIndirectReference(), 0xFFFFFFFF);
+        return;
+    }
+
+    // Also make sure that we do not encrypt the encryption dictionary!
+    unique_ptr<PdfStatefulEncrypt> encrypt;
+    if (m_Encrypt != nullptr && &obj != m_EncryptObj)
+        encrypt.reset(new PdfStatefulEncrypt(m_Encrypt->GetEncrypt(), m_Encrypt->GetContext(), obj.GetIndirectReference()));
+
+    xref.AddInUseObject(obj.GetIndirectReference(), device.GetPosition());
+    auto found = m_encodedStreams.find(&obj);
+    if (found == m_encodedStreams.end())
+    {
+        // Compress the window of streams starting from this one
+        auto queued = m_streamQueueIndices.find(&obj);
+        if (queued != m_streamQueueIndices.end() && queued->second >= m_nextQueuedStream)
+        {
+            compressStreams(queued->second);
+            found = m_encodedStreams.find(&obj);
+        }
+    }
+
+    if (found == m_encodedStreams.end())
+    {
+        obj.WriteFinal(device, m_WriteFlags, encrypt.get(), m_buffer);
+    }
+    else
+    {
+        obj.WriteFinalFlateEncoded(device, m_WriteFlags, encrypt.get(), found->second, m_buffer);
+        m_encodedStreams.erase(found);
+    }
+}
+
+void PdfWriter::queueStreams(const vector<PdfObject*>& objects)
+{
+    // Load the streams on the calling thread, as they may be
+    // read from the input device, then select the ones held
+    // in memory that would be compressed while writing
+    m_streamQueue.clear();
+    m_streamQueueIndices.clear();
+    m_nextQueuedStream = 0;
+    for (auto obj : objects)
+    {
+        obj->DelayedLoadStream();
+        if (obj->canFlateCompressStream(m_WriteFlags)
+            && dynamic_cast<const PdfMemoryObjectStream*>(&std::as_const(*obj->getStream()).GetProvider()) != nullptr)
+        {
+            m_streamQueueIndices[obj] = m_streamQueue.size();
+            m_streamQueue.push_back(obj);
+        }
     }
 }
 
+void PdfWriter::compressStreams(size_t index)
+{
+    // The objects are written in queue order, so the streams of
+    // the previous windows still held have been skipped
+    m_encodedStreams.clear();
+
+    size_t end = index;
+    size_t size = 0;
+    do
+    {
+        auto& stream = std::as_const(*m_streamQueue[end]->getStream());
+        size += static_cast<const PdfMemoryObjectStream&>(stream.GetProvider()).GetBuffer().size();
+        end++;
+    } while (end < m_streamQueue.size() && size < CompressWindowSize);
+
+    // The workers just encode the data in their own buffers
+    vector<charbuff> encoded(end - index);
+    utls::RunParallel(m_SaveThreadCount, encoded.size(), [&](size_t i) {
+        auto& stream = std::as_const(*m_streamQueue[index + i]->getStream());
+        auto& provider = static_cast<const PdfMemoryObjectStream&>(stream.GetProvider());
+        auto filter = PdfFilterFactory::Create(PdfFilterType::FlateDecode);
+        filter->EncodeTo(encoded[i], provider.GetBuffer());
+    });
+
+    // The encoded data is written in place of the stream data
+    // of the objects, which are left untouched
+    for (size_t i = 0; i < encoded.size(); i++)
+        m_encodedStreams[m_streamQueue[index + i]] = std::move(encoded[i]);
+
+    m_nextQueuedStream = end;
+}
+
+bool PdfWriter::canCompressObject(const PdfObject& obj) const
+{
+    // Streams, objects with a non-zero generation number and the
+    // encryption dictionary can't be stored in object streams
+    if (obj.GetIndirectReference().GenerationNumber() != 0
+        || &obj == m_EncryptObj || obj.HasStream())
+    {
+        return false;
+    }
+
+    // Signature dictionaries hold raw data with write beacons, for
+    // /Contents and /ByteRange, that must be patched at their offset
+    // in the file, which is unknown inside an object stream
+    const PdfDictionary* dict;
+    if (!obj.TryGetDictionary(dict))
+        return true;
+
+    for (auto& pair : *dict)
+    {
+        if (pair.second.IsRawData())
+            return false;
+    }
+
+    return true;
+}
+
+void PdfWriter::addToObjectStream(ObjectStream& stream, PdfObject& obj, PdfXRef& xref)
+{
+    xref.AddCompressedObject(obj.GetIndirectReference(), stream.ObjectNumber, stream.Count);
+    utls::FormatTo(m_buffer, "{} {} ", obj.GetIndirectReference().ObjectNumber(), stream.Data.size());
+    stream.Header.append(m_buffer);
+
+    // NOTE: The objects are not encrypted individually,
+    // the object stream is encrypted as a whole
+    BufferStreamDevice device(stream.Data);
+    obj.GetVariant().Write(device, m_WriteFlags, nullptr, m_buffer);
+    device.Write('\n');
+    obj.ResetDirty();
+    stream.Count++;
+}
+
+void PdfWriter::writeObjectStream(OutputStreamDevice& device, ObjectStream& stream, PdfXRef& xref)
+{
+    // The generation number of object streams is always 0
+    PdfReference ref(stream.ObjectNumber, 0);
+    PdfObject streamObj;
+    streamObj.SetIndirectReference(ref);
+    auto& dict = streamObj.GetDictionary();
+    dict.AddKey("Type"_n, "ObjStm"_n);
+    dict.AddKey("N"_n, static_cast<int64_t>(stream.Count));
+    dict.AddKey("First"_n, static_cast<int64_t>(stream.Header.size()));
+
+    stream.Header.append(stream.Data);
+    streamObj.GetOrCreateStream().SetData(stream.Header);
+
+    unique_ptr<PdfStatefulEncrypt> encrypt;
+    if (m_Encrypt != nullptr)
+        encrypt.reset(new PdfStatefulEncrypt(m_Encrypt->GetEncrypt(), m_Encrypt->GetContext(), ref));
+
+    xref.AddInUseObject(ref, device.GetPosition());
+    streamObj.WriteFinal(device, m_WriteFlags, encrypt.get(), m_buffer);
+
+    stream.ObjectNumber++;
+    stream.Count = 0;
+    stream.Header.clear();
+    stream.Data.clear();
+}
+
 void PdfWriter::FillTrailerObject(PdfObject& trailer, size_t size, bool onlySizeKey) const
 {
     trailer.GetDictionary().AddKey("Size"_n, static_cast<int64_t>(size));
@@ -326,6 +568,16 @@ void PdfWriter::SetEncrypt(PdfEncryptSession& encrypt)
     m_Encrypt = &encrypt;
 }
 
+void PdfWriter::SetObjectStreamSize(unsigned size)
+{
+    // The index of the objects in the stream must fit
+    // the field of the XRef stream entries
+    if (size == 0 || size > numeric_limits<uint16_t>::max())
+        PODOFO_RAISE_ERROR_INFO(PdfErrorCode::ValueOutOfRange, "The object stream size must be between 1 and 65535");
+
+    m_ObjectStreamSize = size;
+}
+
 void PdfWriter::SetUseXRefStream(bool useXRefStream)
 {
     if (useXRefStream && m_Version < PdfVersion::V1_5)
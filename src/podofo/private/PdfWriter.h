@@ -66,6 +66,15 @@ public:
     void FillTrailerObject(PdfObject& trailer, size_t size, bool onlySizeKey) const;
 
 public:
+    /** The default maximum number of objects packed in each object stream
+     */
+    static constexpr unsigned DefaultObjectStreamSize = 100;
+
+    /** The raw size of the streams compressed ahead of being written
+     *  at a time, when saving on multiple threads
+     */
+    static constexpr size_t CompressWindowSize = 16 * 1024 * 1024;
+
     void SetSaveOptions(PdfSaveOptions saveOptions);
 
     inline PdfSaveOptions GetSaveOptions() const { return m_SaveOptions; }
@@ -95,6 +104,27 @@ public:
      */
     inline bool GetUseXRefStream() const { return m_UseXRefStream; }
 
+    /** Set the maximum number of objects packed in each object stream,
+     *  when the PdfSaveOptions::UseObjectStreams option is set.
+     *  The default is DefaultObjectStreamSize
+     *  \param size the number of objects, from 1 to 65535
+     */
+    void SetObjectStreamSize(unsigned size);
+
+    inline unsigned GetObjectStreamSize() const { return m_ObjectStreamSize; }
+
+    /** Set the number of threads used to flate compress the streams
+     *  before writing them.
+     *
+     *  Default is 1, which compresses each stream on the calling thread
+     *  while writing it. If 0, std::thread::hardware_concurrency() is used.
+     *  Only streams held in memory are compressed ahead, the other ones
+     *  are still compressed while writing them
+     */
+    inline void SetSaveThreadCount(unsigned count) { m_SaveThreadCount = count; }
+
+    inline unsigned GetSaveThreadCount() const { return m_SaveThreadCount; }
+
     /** Sets an offset to the previous XRef table. Set it to lower than
      *  or equal to 0, to not write a reference to the previous XRef table.
      *  The default is 0.
@@ -110,6 +140,12 @@ public:
      */
     inline int64_t GetPrevXRefOffset() const { return m_PrevXRefOffset; }
 
+    /**
+     *  \returns offset of the XRef table or stream written by the
+     *     last call to Write, or -1 if nothing has been written yet
+     */
+    inline int64_t GetXRefOffset() const { return m_XRefOffset; }
+
     /** Set whether writing an incremental update.
      *  Default is false.
      *  \param incrementalUpdate if true an incremental update will be written
@@ -166,8 +202,44 @@ protected:
     void SetEncryptObj(PdfObject& obj);
 
 private:
+    struct ObjectStream;
+
     void initWriteFlags();
 
+    /** Write all the objects of the list, as in a full save or
+     *  in an incremental update that rewrites the XRef table
+     */
+    void writeAllObjects(OutputStreamDevice& device, const PdfIndirectObjectList& objects, PdfXRef& xref);
+
+    void writeObject(OutputStreamDevice& device, PdfObject& obj, PdfXRef& xref);
+
+    /** Select the streams of the given objects, in write order, that
+     *  would be Flate compressed while writing them. They are compressed
+     *  on multiple threads in windows, just ahead of being written
+     */
+    void queueStreams(const std::vector<PdfObject*>& objects);
+
+    /** Flate compress the queued streams in a window starting from the
+     *  given index and bounded in size, so that only the window is held
+     *  in memory. The encoded data is kept by the writer until it's
+     *  written and the objects are not modified
+     */
+    void compressStreams(size_t index);
+
+    /** \returns true if the object can be stored in an object stream
+     */
+    bool canCompressObject(const PdfObject& obj) const;
+
+    /** Serialize the object in the object stream and add its compressed
+     *  entry to the XRef
+     */
+    void addToObjectStream(ObjectStream& stream, PdfObject& obj, PdfXRef& xref);
+
+    /** Write the object stream with the objects added so far, then reset it
+     *  for the objects that follow, with the next object number
+     */
+    void writeObjectStream(OutputStreamDevice& device, ObjectStream& stream, PdfXRef& xref);
+
 protected:
     charbuff m_buffer;
 
@@ -178,6 +250,8 @@ private:
     PdfALevel m_PdfALevel;
 
     bool m_UseXRefStream;
+    unsigned m_ObjectStreamSize;
+    unsigned m_SaveThreadCount;
 
     PdfEncryptSession* m_Encrypt;             // If not nullptr encrypt all strings and streams and
                                               // create an encryption dictionary in the trailer
@@ -187,8 +261,18 @@ private:
     PdfWriteFlags m_WriteFlags;
 
     PdfString m_identifier;
+
+    // Streams to be compressed ahead, with their index in the queue,
+    // and the index of the first one not compressed yet
+    std::vector<PdfObject*> m_streamQueue;
+    std::unordered_map<const PdfObject*, size_t> m_streamQueueIndices;
+    size_t m_nextQueuedStream;
+    // Streams encoded ahead by compressStreams(), written in
+    // place of the stream data of the objects
+    std::unordered_map<const PdfObject*, charbuff> m_encodedStreams;
     PdfString m_originalIdentifier; // used for incremental update
     int64_t m_PrevXRefOffset;
+    int64_t m_XRefOffset;
     bool m_IncrementalUpdate;
     bool m_rewriteXRefTable; // Only used if incremental update
 };
@@ -27,31 +27,39 @@ PdfXRef::~PdfXRef() { }
 
 void PdfXRef::AddInUseObject(const PdfReference& ref, nullable<uint64_t> offset)
 {
-    addObject(ref, offset, true);
+    if (offset == nullptr)
+    {
+        // Objects with no offset provided will not be written
+        // in the entry list
+        if (ref.ObjectNumber() > m_maxObjCount)
+            m_maxObjCount = ref.ObjectNumber();
+
+        return;
+    }
+
+    addObject(ref, PdfXRefEntry::CreateInUse(*offset, ref.GenerationNumber()));
 }
 
 void PdfXRef::AddFreeObject(const PdfReference& ref)
 {
-    addObject(ref, nullptr, false);
+    addObject(ref, PdfXRefEntry::CreateFree(0, ref.GenerationNumber()));
+}
+
+void PdfXRef::AddCompressedObject(const PdfReference& ref, uint32_t streamObjectNum, unsigned index)
+{
+    addObject(ref, PdfXRefEntry::CreateCompressed(streamObjectNum, index));
 }
 
-void PdfXRef::addObject(const PdfReference& ref, nullable<uint64_t> offset, bool inUse)
+void PdfXRef::addObject(const PdfReference& ref, const PdfXRefEntry& entry)
 {
     if (ref.ObjectNumber() > m_maxObjCount)
         m_maxObjCount = ref.ObjectNumber();
 
-    if (inUse && offset == nullptr)
-    {
-        // Objects with no offset provided will not be written
-        // in the entry list
-        return;
-    }
-
     bool insertDone = false;
 
     for (auto& block : m_blocks)
     {
-        if (block.InsertItem(ref, offset, inUse))
+        if (block.InsertItem(ref, entry))
         {
             insertDone = true;
             break;
@@ -63,10 +71,10 @@ void PdfXRef::addObject(const PdfReference& ref, nullable<uint64_t> offset, bool
         PdfXRefBlock block;
         block.First = ref.ObjectNumber();
         block.Count = 1;
-        if (inUse)
-            block.Items.push_back(XRefItem(ref, offset.value()));
-        else
+        if (entry.Type == PdfXRefEntryType::Free)
             block.FreeItems.push_back(ref);
+        else
+            block.Items.push_back(XRefItem(ref, entry));
 
         m_blocks.push_back(block);
         std::sort(m_blocks.begin(), m_blocks.end());
@@ -129,8 +137,7 @@ void PdfXRef::Write(OutputStreamDevice& device, charbuff& buffer)
                 itFree++;
             }
 
-            this->WriteXRefEntry(device, itItems->Reference,
-                PdfXRefEntry::CreateInUse(itItems->Offset, itItems->Reference.GenerationNumber()), buffer);
+            this->WriteXRefEntry(device, itItems->Reference, itItems->Entry, buffer);
             itItems++;
         }
 
@@ -318,16 +325,16 @@ bool PdfXRef::ShouldSkipWrite(const PdfReference& ref)
     return false;
 }
 
-bool PdfXRef::PdfXRefBlock::InsertItem(const PdfReference& ref, nullable<uint64_t> offset, bool inUse)
+bool PdfXRef::PdfXRefBlock::InsertItem(const PdfReference& ref, const PdfXRefEntry& entry)
 {
-    PODOFO_ASSERT(!inUse || offset.has_value());
+    bool inUse = entry.Type != PdfXRefEntryType::Free;
     if (ref.ObjectNumber() == First + Count)
     {
         // Insert at back
         Count++;
 
         if (inUse)
-            Items.push_back(XRefItem(ref, offset.value()));
+            Items.push_back(XRefItem(ref, entry));
         else
             FreeItems.push_back(ref);
 
@@ -341,7 +348,7 @@ bool PdfXRef::PdfXRefBlock::InsertItem(const PdfReference& ref, nullable<uint64_
 
         // This is known to be slow, but should not occur actually
         if (inUse)
-            Items.insert(Items.begin(), XRefItem(ref, offset.value()));
+            Items.insert(Items.begin(), XRefItem(ref, entry));
         else
             FreeItems.insert(FreeItems.begin(), ref);
 
@@ -355,7 +362,7 @@ bool PdfXRef::PdfXRefBlock::InsertItem(const PdfReference& ref, nullable<uint64_
 
         if (inUse)
         {
-            Items.push_back(XRefItem(ref, offset.value()));
+            Items.push_back(XRefItem(ref, entry));
             std::sort(Items.begin(), Items.end());
         }
         else
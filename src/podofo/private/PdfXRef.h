@@ -35,11 +35,11 @@ public:
 protected:
     struct XRefItem
     {
-        XRefItem(const PdfReference& ref, uint64_t off)
-            : Reference(ref), Offset(off) { }
+        XRefItem(const PdfReference& ref, const PdfXRefEntry& entry)
+            : Reference(ref), Entry(entry) { }
 
         PdfReference Reference;
-        uint64_t Offset;
+        PdfXRefEntry Entry;     ///< An InUse or Compressed entry
 
         bool operator<(const XRefItem& rhs) const
         {
@@ -57,7 +57,7 @@ protected:
 
         PdfXRefBlock(const PdfXRefBlock& rhs) = default;
 
-        bool InsertItem(const PdfReference& ref, nullable<uint64_t> offset, bool bUsed);
+        bool InsertItem(const PdfReference& ref, const PdfXRefEntry& entry);
 
         bool operator<(const PdfXRefBlock& rhs) const
         {
@@ -96,6 +96,15 @@ public:
      */
     void AddFreeObject(const PdfReference& ref);
 
+    /** Add an object stored in an object stream to the XRef table.
+     *  Compressed entries can be written only in XRef streams
+     *
+     *  \param ref reference of this object
+     *  \param streamObjectNum the object number of the object stream
+     *  \param index the index of the object in the object stream
+     */
+    void AddCompressedObject(const PdfReference& ref, uint32_t streamObjectNum, unsigned index);
+
     /** Write the XRef table to an output device.
      *
      *  \param device an output device (usually a PDF file)
@@ -166,7 +175,7 @@ protected:
     virtual void EndWriteImpl(OutputStreamDevice& device, charbuff& buffer);
 
 private:
-    void addObject(const PdfReference& ref, nullable<uint64_t> offset, bool inUse);
+    void addObject(const PdfReference& ref, const PdfXRefEntry& entry);
 
     /** Called at the end of writing the XRef table.
      *  Sub classes can overload this method to finish a XRef table.
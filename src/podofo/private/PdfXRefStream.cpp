@@ -67,15 +67,21 @@ void PdfXRefStream::WriteXRefEntry(OutputStreamDevice& device, const PdfReferenc
     {
         case PdfXRefEntryType::Free:
             stmEntry.Variant = AS_BIG_ENDIAN(static_cast<uint32_t>(entry.ObjectNumber));
+            stmEntry.Generation = AS_BIG_ENDIAN(static_cast<uint16_t>(entry.Generation));
             break;
         case PdfXRefEntryType::InUse:
             stmEntry.Variant = AS_BIG_ENDIAN(static_cast<uint32_t>(entry.Offset));
+            stmEntry.Generation = AS_BIG_ENDIAN(static_cast<uint16_t>(entry.Generation));
+            break;
+        case PdfXRefEntryType::Compressed:
+            // The third field is the index of the object in the object stream
+            stmEntry.Variant = AS_BIG_ENDIAN(static_cast<uint32_t>(entry.ObjectNumber));
+            stmEntry.Generation = AS_BIG_ENDIAN(static_cast<uint16_t>(entry.Index));
             break;
         default:
             PODOFO_RAISE_ERROR(PdfErrorCode::InvalidEnumValue);
     }
 
-    stmEntry.Generation = AS_BIG_ENDIAN(static_cast<uint16_t>(entry.Generation));
     m_rawEntries.push_back(stmEntry);
 }
 
@@ -33,7 +33,7 @@ void PdfXRefStreamParserObject::delayedLoad()
 {
     // NOTE: Ignore the encryption in the XREF as the XREF stream must no be encrypted (see PDF Reference 3.4.7)
 
-    PdfTokenizer tokenizer;
+    PdfTokenizer tokenizer(GetTokenizerOptions());
     auto reference = ReadReference(tokenizer);
     SetIndirectReference(reference);
     PdfParserObject::Parse(tokenizer);
@@ -0,0 +1,35 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#include "PdfDeclarationsPrivate.h"
+#include "TimestampSizeCache.h"
+
+using namespace std;
+using namespace PoDoFo;
+
+TimestampSizeCache& TimestampSizeCache::instance()
+{
+    static TimestampSizeCache cache;
+    return cache;
+}
+
+size_t TimestampSizeCache::estimate(const string& key, bool floored)
+{
+    lock_guard<mutex> lock(m_mutex);
+    auto found = m_sizes.find(key);
+    if (found == m_sizes.end())
+        return DefaultReserve;
+
+    size_t size = found->second + std::max(MinReserveMargin, found->second * ReserveMarginPercent / 100);
+    return floored ? std::max(size, DefaultReserve) : size;
+}
+
+void TimestampSizeCache::update(const string& key, size_t tokenSize)
+{
+    lock_guard<mutex> lock(m_mutex);
+    auto& size = m_sizes[key];
+    size = std::max(size, tokenSize);
+}
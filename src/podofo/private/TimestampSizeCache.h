@@ -0,0 +1,59 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#ifndef PDF_TIMESTAMP_SIZE_CACHE_H
+#define PDF_TIMESTAMP_SIZE_CACHE_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace PoDoFo {
+
+/**
+ * Process-wide cache of the timestamp token sizes observed per signing
+ * certificate chain, conformance level and TSA. It allows reserving a tight
+ * signature /Contents instead of a fixed, mostly empty, 20 KB placeholder
+ */
+class TimestampSizeCache final
+{
+public:
+    /** Room reserved for a token before any token size has been observed
+     *  for the key, and at least reserved when the TSA is unknown
+     */
+    static constexpr size_t DefaultReserve = 20000;
+
+    /** Tokens issued by the same TSA differ in size (serial number, nonce,
+     *  time precision, embedded certificates), so the room reserved exceeds
+     *  the largest observed size by a percentage of it, and at least by a minimum
+     */
+    static constexpr size_t ReserveMarginPercent = 10;
+    static constexpr size_t MinReserveMargin = 512;
+
+public:
+    static TimestampSizeCache& instance();
+
+    /** \returns the room to reserve for a token, the largest size observed plus a margin
+     * \param floored if true, never return less than the default reservation, as the
+     *     tokens may come from a different TSA than the ones observed
+     */
+    size_t estimate(const std::string& key, bool floored);
+
+    /** Record the size of a token issued for the key
+     */
+    void update(const std::string& key, size_t tokenSize);
+
+private:
+    TimestampSizeCache() = default;
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<std::string, size_t> m_sizes;
+};
+
+}
+
+#endif // PDF_TIMESTAMP_SIZE_CACHE_H
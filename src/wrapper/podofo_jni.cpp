@@ -41,6 +41,15 @@ std::unique_ptr<PoDoFoWrapper> PoDoFoWrapper::initialize(const std::string& conf
     }
 }
 
+PoDoFoWrapper::~PoDoFoWrapper() {
+    if (metricsListener && javaVm) {
+        JNIEnv* env = nullptr;
+        if (javaVm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) == JNI_OK) {
+            releaseMetricsListener(env);
+        }
+    }
+}
+
 bool PoDoFoWrapper::isLoaded() const {
     return nativeSession != nullptr;
 }
@@ -189,6 +198,75 @@ std::string PoDoFoWrapper::getCertificateIssuerUrlFromCertificate(const std::str
 	}
 }
 
+static const char* signingPhaseToString(PoDoFo::PdfSigningPhase phase) {
+    switch (phase) {
+        case PoDoFo::PdfSigningPhase::Load:
+            return "load";
+        case PoDoFo::PdfSigningPhase::Save:
+            return "save";
+        case PoDoFo::PdfSigningPhase::Hash:
+            return "hash";
+        case PoDoFo::PdfSigningPhase::ComputeSignature:
+            return "computeSignature";
+        case PoDoFo::PdfSigningPhase::DssUpdate:
+            return "dssUpdate";
+        default:
+            return "unknown";
+    }
+}
+
+void PoDoFoWrapper::setMetricsListener(JNIEnv* env, jobject listener) {
+    if (!nativeSession) {
+        throw std::runtime_error("PoDoFo session is not initialized.");
+    }
+
+    releaseMetricsListener(env);
+    if (!listener) {
+        nativeSession->setMetricsHandler(nullptr);
+        return;
+    }
+
+    env->GetJavaVM(&javaVm);
+    metricsListener = env->NewGlobalRef(listener);
+    nativeSession->setMetricsHandler([this](const PoDoFo::PdfSigningPhaseMetrics& metrics) {
+        forwardMetrics(metrics);
+    });
+}
+
+void PoDoFoWrapper::releaseMetricsListener(JNIEnv* env) {
+    if (metricsListener) {
+        env->DeleteGlobalRef(metricsListener);
+        metricsListener = nullptr;
+    }
+}
+
+void PoDoFoWrapper::forwardMetrics(const PoDoFo::PdfSigningPhaseMetrics& metrics) {
+    // The session reports synchronously, so this runs on the Java
+    // thread that called into the native method
+    JNIEnv* env = nullptr;
+    if (!metricsListener || javaVm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) {
+        return;
+    }
+
+    jclass listenerClass = env->GetObjectClass(metricsListener);
+    jmethodID onPhaseCompleted = env->GetMethodID(listenerClass, "onPhaseCompleted", "(Ljava/lang/String;JJ)V");
+    env->DeleteLocalRef(listenerClass);
+    if (!onPhaseCompleted) {
+        env->ExceptionClear();
+        return;
+    }
+
+    jstring phase = env->NewStringUTF(signingPhaseToString(metrics.Phase));
+    env->CallVoidMethod(metricsListener, onPhaseCompleted, phase,
+        static_cast<jlong>(metrics.Duration.count()), static_cast<jlong>(metrics.ByteCount));
+    env->DeleteLocalRef(phase);
+    if (env->ExceptionCheck()) {
+        // Don't let a failing listener abort the signing
+        __android_log_print(ANDROID_LOG_WARN, "PoDoFo", "Exception in the metrics listener");
+        env->ExceptionClear();
+    }
+}
+
 // Helper functions
 void throwJavaException(JNIEnv* env, const char* message) {
     jclass exceptionClass = env->FindClass("com/podofo/android/PoDoFoException");
@@ -608,4 +686,20 @@ extern "C" {
             return nullptr;
         }
     }
+
+    JNIEXPORT void JNICALL Java_com_podofo_android_PoDoFoWrapper_nativeSetMetricsListener(
+        JNIEnv* env, jobject thiz, jlong nativeHandle, jobject jListener) {
+
+        if (!nativeHandle) {
+            throwJavaException(env, "Session not initialized");
+            return;
+        }
+
+        try {
+            auto* wrapper = reinterpret_cast<PoDoFoWrapper*>(nativeHandle);
+            wrapper->setMetricsListener(env, jListener);
+        } catch (const std::exception& e) {
+            throwJavaException(env, e.what());
+        }
+    }
 }
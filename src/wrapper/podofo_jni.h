@@ -11,11 +11,16 @@
 class PoDoFoWrapper {
 private:
     std::unique_ptr<PoDoFo::PdfRemoteSignDocumentSession> nativeSession;
+    JavaVM* javaVm = nullptr;
+    jobject metricsListener = nullptr; // Global reference to the Java listener
+
+    void releaseMetricsListener(JNIEnv* env);
+    void forwardMetrics(const PoDoFo::PdfSigningPhaseMetrics& metrics);
 
 public:
     // Constructor - made public so std::make_unique can access it
     PoDoFoWrapper() = default;
-    ~PoDoFoWrapper() = default;
+    ~PoDoFoWrapper();
 
     // Static factory method
     static std::unique_ptr<PoDoFoWrapper> initialize(const std::string& conformanceLevel,
@@ -37,6 +42,7 @@ public:
     std::string getOCSPFromCertificate(const std::string& base64Cert, const std::string& base64IssuerCert);
     std::string buildOCSPRequestFromCertificates(const std::string& base64Cert, const std::string& base64IssuerCert);
     std::string getCertificateIssuerUrlFromCertificate(const std::string& base64Cert);
+    void setMetricsListener(JNIEnv* env, jobject listener);
 };
 
 // Helper methods for JNI
@@ -91,6 +97,9 @@ extern "C" {
 
     JNIEXPORT jstring JNICALL Java_com_podofo_android_PoDoFoWrapper_nativeGetCertificateIssuerUrlFromCertificate(
         JNIEnv* env, jobject thiz, jlong nativeHandle, jstring jBase64Cert);
+
+    JNIEXPORT void JNICALL Java_com_podofo_android_PoDoFoWrapper_nativeSetMetricsListener(
+        JNIEnv* env, jobject thiz, jlong nativeHandle, jobject jListener);
 }
 
 #endif // PODOFO_JNI_H
@@ -8,6 +8,7 @@
 
 #include <PdfTest.h>
 #include <podofo/optional/PdfNames.h>
+#include <podofo/private/BinaryToText.h>
 
 using namespace std;
 using namespace PoDoFo;
@@ -251,6 +252,213 @@ TEST_CASE("TestAssignObjects")
     }
 }
 
+TEST_CASE("TestObjectListIterators")
+{
+    PdfMemDocument doc;
+    auto& objects = doc.GetObjects();
+    vector<PdfReference> created;
+    auto& arr = doc.GetCatalog().GetDictionary().AddKey("Test"_n, PdfArray()).GetArray();
+    for (unsigned i = 0; i < 10; i++)
+    {
+        auto& obj = objects.CreateObject(PdfObject(static_cast<int64_t>(i)));
+        created.push_back(obj.GetIndirectReference());
+        if (i % 2 == 0)
+            arr.Add(obj.GetIndirectReference());
+    }
+
+    // Unreferenced objects leave empty slots that are skipped
+    unsigned size = objects.GetSize();
+    objects.CollectGarbage();
+    REQUIRE(objects.GetSize() == size - 5);
+    REQUIRE(objects.GetObject(created[1]) == nullptr);
+    REQUIRE(objects.GetObject(created[2]) != nullptr);
+    REQUIRE(objects.GetObject(PdfReference(created[2].ObjectNumber(), 1)) == nullptr);
+
+    vector<PdfReference> forward;
+    for (auto obj : objects)
+        forward.push_back(obj->GetIndirectReference());
+    REQUIRE(forward.size() == objects.GetSize());
+    REQUIRE(std::is_sorted(forward.begin(), forward.end()));
+
+    vector<PdfReference> backward;
+    for (auto it = objects.rbegin(); it != objects.rend(); it++)
+        backward.push_back((*it)->GetIndirectReference());
+    std::reverse(backward.begin(), backward.end());
+    REQUIRE(backward == forward);
+
+    // Free object numbers are reused
+    auto& reused = objects.CreateObject(PdfObject(static_cast<int64_t>(42)));
+    REQUIRE(reused.GetIndirectReference().ObjectNumber() == created[1].ObjectNumber());
+    REQUIRE(reused.GetIndirectReference().GenerationNumber() == 1);
+    REQUIRE(objects.GetObject(reused.GetIndirectReference()) == &reused);
+    REQUIRE(objects.GetObject(created[1]) == nullptr);
+}
+
+TEST_CASE("TestDictionaryEntries")
+{
+    // Insert keys out of order, filling several blocks of entries
+    PdfDictionary dict;
+    vector<string> keys;
+    for (unsigned i = 0; i < 40; i++)
+    {
+        unsigned num = (i * 7) % 40;
+        keys.push_back((num < 10 ? "Key0" : "Key") + std::to_string(num));
+    }
+
+    auto& first = dict.AddKey(PdfName(keys[0]), PdfObject(static_cast<int64_t>(0)));
+    for (unsigned i = 1; i < keys.size(); i++)
+        dict.AddKey(PdfName(keys[i]), PdfObject(static_cast<int64_t>(i)));
+
+    // References to the entries are stable
+    REQUIRE(&first == dict.GetKey(keys[0]));
+    REQUIRE(dict.GetSize() == 40);
+
+    vector<string> iterated;
+    for (auto& pair : dict)
+        iterated.push_back((string)pair.first.GetString());
+    std::sort(keys.begin(), keys.end());
+    REQUIRE(iterated == keys);
+
+    // Removed entries don't affect the others
+    auto& last = dict.MustGetKey("Key39");
+    REQUIRE(dict.RemoveKey("Key10"));
+    REQUIRE(!dict.RemoveKey("Key10"));
+    REQUIRE(dict.GetKey("Key10") == nullptr);
+    REQUIRE(&last == &dict.MustGetKey("Key39"));
+    dict.AddKey("Key10"_n, PdfObject(static_cast<int64_t>(42)));
+    REQUIRE(dict.MustGetKey("Key10").GetNumber() == 42);
+    REQUIRE(dict.GetSize() == 40);
+
+    // Existing keys are replaced
+    dict.AddKey("Key00"_n, PdfObject(static_cast<int64_t>(43)));
+    REQUIRE(&first == dict.GetKey("Key00"));
+    REQUIRE(first.GetNumber() == 43);
+
+    PdfDictionary copy(dict);
+    REQUIRE(copy == dict);
+    copy.AddKey("Other"_n, PdfName("Value"));
+    REQUIRE(copy != dict);
+
+    PdfDictionary moved(std::move(copy));
+    REQUIRE(moved.GetSize() == 41);
+    REQUIRE(moved.MustGetKey("Other").GetName() == "Value");
+}
+
+namespace
+{
+    // A resource tracking the allocated bytes, that can be made to fail
+    class TestMemoryResource final : public std::pmr::memory_resource
+    {
+    public:
+        size_t Allocated = 0;
+        bool Fail = false;
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            if (Fail)
+                throw bad_alloc();
+            Allocated += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            Allocated -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+TEST_CASE("TestDictionaryMapAssignment")
+{
+    TestMemoryResource resource;
+    {
+        PdfDictionaryMap src;
+        for (unsigned i = 0; i < 20; i++)
+            src.try_emplace(PdfName("Key" + std::to_string(i)), PdfObject(static_cast<int64_t>(i)));
+
+        PdfDictionaryMap dst(&resource);
+        dst.try_emplace("A"_n, PdfObject(static_cast<int64_t>(1)));
+        dst.try_emplace("B"_n, PdfObject(static_cast<int64_t>(2)));
+
+        // Failed assignments leave both maps untouched
+        resource.Fail = true;
+        REQUIRE_THROWS_AS(dst = src, bad_alloc);
+        REQUIRE_THROWS_AS(dst = std::move(src), bad_alloc);
+        REQUIRE(dst.size() == 2);
+        REQUIRE(dst.find("A")->second.GetNumber() == 1);
+        REQUIRE(src.size() == 20);
+        resource.Fail = false;
+
+        // Assignments keep the resource of the destination
+        dst = src;
+        REQUIRE(dst == src);
+        REQUIRE(dst.get_allocator().resource() == &resource);
+
+        dst = std::move(src);
+        REQUIRE(src.empty());
+        REQUIRE(dst.size() == 20);
+        REQUIRE(dst.find("Key7")->second.GetNumber() == 7);
+        REQUIRE(dst.get_allocator().resource() == &resource);
+
+        PdfDictionaryMap moved(std::move(dst));
+        REQUIRE(moved.get_allocator().resource() == &resource);
+        REQUIRE(moved.size() == 20);
+    }
+    REQUIRE(resource.Allocated == 0);
+}
+
+TEST_CASE("TestDictionaryMapTree")
+{
+    // Insert keys out of order past the threshold, so
+    // the entries are moved to a tree
+    constexpr unsigned count = PdfDictionaryMap::TreeThreshold + 100;
+    TestMemoryResource resource;
+    {
+        PdfDictionaryMap map(&resource);
+        vector<string> keys;
+        for (unsigned i = 0; i < count; i++)
+        {
+            auto key = utls::Format("Key{:05}", (i * 7919) % count);
+            map.try_emplace(PdfName(key), PdfObject(static_cast<int64_t>(i)));
+            keys.push_back(key);
+        }
+
+        auto& first = map.find(keys[0])->second;
+        REQUIRE(map.size() == count);
+        REQUIRE(!map.try_emplace(PdfName(keys[1]), PdfObject(static_cast<int64_t>(42))).second);
+        REQUIRE(map.find(keys[1])->second.GetNumber() == 1);
+        REQUIRE(map.find("Missing") == map.end());
+
+        vector<string> iterated;
+        for (auto& pair : map)
+            iterated.push_back((string)pair.first.GetString());
+        std::sort(keys.begin(), keys.end());
+        REQUIRE(iterated == keys);
+
+        auto it = map.erase(map.find("Key00010"));
+        REQUIRE(it->first == "Key00011");
+        REQUIRE(map.find("Key00010") == map.end());
+        REQUIRE(map.size() == count - 1);
+        REQUIRE(&first == &map.find(keys[0])->second);
+
+        PdfDictionaryMap copy(map);
+        REQUIRE(copy == map);
+        PdfDictionaryMap moved(std::move(copy));
+        REQUIRE(moved == map);
+        REQUIRE(copy.empty());
+
+        map.clear();
+        REQUIRE(map.empty());
+        map.try_emplace("A"_n, PdfObject(static_cast<int64_t>(1)));
+        REQUIRE(map.begin()->first == "A");
+    }
+    REQUIRE(resource.Allocated == 0);
+}
+
 TEST_CASE("TestObjectAdapter")
 {
     PdfMemDocument doc;
@@ -263,3 +471,58 @@ TEST_CASE("TestObjectAdapter")
     REQUIRE(info.FindKeyParentAs<PdfString>("Producer") == "PoDoFo - http://podofo.sf.net");
     REQUIRE(info.FindKeyParentAsSafe<PdfString>("Prod", "fallback") == "fallback");
 }
+
+TEST_CASE("TestBinaryToTextCodecs")
+{
+    auto encodeBase64 = [](const string_view& data) {
+        string ret(utls::GetBase64EncodedSize(data.size()), '\0');
+        ret.resize(utls::EncodeBase64To(ret, data));
+        return ret;
+    };
+    auto decodeBase64 = [](const string_view& str, string& decoded) {
+        decoded.resize(utls::GetBase64DecodedMaxSize(str.size()));
+        size_t decodedSize;
+        bool ret = utls::TryDecodeBase64To(decoded, str, decodedSize);
+        decoded.resize(decodedSize);
+        return ret;
+    };
+
+    // RFC 4648 test vectors
+    REQUIRE(encodeBase64("") == "");
+    REQUIRE(encodeBase64("f") == "Zg==");
+    REQUIRE(encodeBase64("fo") == "Zm8=");
+    REQUIRE(encodeBase64("foo") == "Zm9v");
+    REQUIRE(encodeBase64("foob") == "Zm9vYg==");
+    REQUIRE(encodeBase64("fooba") == "Zm9vYmE=");
+    REQUIRE(encodeBase64("foobar") == "Zm9vYmFy");
+
+    string decoded;
+    REQUIRE(decodeBase64("Zm9vYmFy", decoded));
+    REQUIRE(decoded == "foobar");
+    REQUIRE(decodeBase64("Zm9vYg==", decoded));
+    REQUIRE(decoded == "foob");
+    REQUIRE(decodeBase64("Zm9vYg", decoded));
+    REQUIRE(decoded == "foob");
+    REQUIRE(decodeBase64("Zm9v\r\nYmE=\n", decoded));
+    REQUIRE(decoded == "fooba");
+    REQUIRE(!decodeBase64("Zm9v*mFy", decoded));
+    REQUIRE(!decodeBase64("Zg==Zg==", decoded));
+    REQUIRE(!decodeBase64("Z", decoded));
+
+    string binary;
+    for (unsigned i = 0; i < 1024; i++)
+        binary.push_back((char)(i * 7 + i / 256));
+    REQUIRE(decodeBase64(encodeBase64(binary), decoded));
+    REQUIRE(decoded == binary);
+
+    string hex(6, '\0');
+    utls::EncodeHexTo(hex, "\x01\xAB\xFF"sv);
+    REQUIRE(hex == "01ABFF");
+    utls::EncodeHexTo(hex, "\x01\xAB\xFF"sv, true);
+    REQUIRE(hex == "01abff");
+
+    string_view toEscape = "a+b/c=d-e_f.g~h";
+    string url(utls::GetUrlEncodedSize(toEscape), '\0');
+    REQUIRE(utls::UrlEncodeTo(url, toEscape) == url.size());
+    REQUIRE(url == "a%2Bb%2Fc%3Dd-e_f.g~h");
+}
@@ -36,6 +36,29 @@ TEST_CASE("TestSaveIncremental")
     doc.Load(testPath);
 }
 
+TEST_CASE("TestMappedFileDevice")
+{
+    auto testPath = TestUtils::GetTestOutputFilePath("TestMappedFileDevice.pdf");
+    {
+        PdfMemDocument doc;
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        doc.Save(testPath);
+    }
+
+    auto device = std::make_shared<MappedFileStreamDevice>(testPath);
+    string_view view;
+    REQUIRE(device->TryGetView(view));
+    REQUIRE(view.size() == device->GetLength());
+    REQUIRE(view.substr(0, 5) == "%PDF-");
+
+    PdfMemDocument doc;
+    doc.Load(device);
+    REQUIRE(doc.GetPages().GetCount() == 2);
+
+    ASSERT_THROW_WITH_ERROR_CODE(device->Write("test"), PdfErrorCode::InternalLogic);
+}
+
 TEST_CASE("TestStreamedDocument")
 {
     auto testPath = TestUtils::GetTestOutputFilePath("TestStreamedDocument.pdf");
@@ -49,3 +72,108 @@ TEST_CASE("TestStreamedDocument")
     painter.DrawText("Hello World!", 56.69, page.GetRect().Height - 56.69);
     painter.FinishDrawing();
 }
+
+TEST_CASE("TestDeltaStreamDevice")
+{
+    string baseBuffer = "0123456789";
+    string deltaBuffer;
+    auto base = std::make_shared<SpanStreamDevice>(baseBuffer);
+    auto delta = std::make_shared<StringStreamDevice>(deltaBuffer);
+    DeltaStreamDevice device(base, delta);
+    REQUIRE(device.GetBaseLength() == 10);
+    REQUIRE(device.GetLength() == 10);
+
+    // The contents are a view of the base until something is appended
+    string_view view;
+    REQUIRE(device.TryGetView(view));
+    REQUIRE(view == baseBuffer);
+
+    ASSERT_THROW_WITH_ERROR_CODE(device.Write("x"), PdfErrorCode::IOError);
+
+    device.Seek(0, SeekDirection::End);
+    device.Write("abcdef");
+    device.Flush();
+    REQUIRE(deltaBuffer == "abcdef");
+    REQUIRE(baseBuffer == "0123456789");
+    REQUIRE(device.GetLength() == 16);
+    REQUIRE(device.GetPosition() == 16);
+    REQUIRE(device.Eof());
+    REQUIRE(!device.TryGetView(view));
+
+    // Reads across the boundary
+    char buffer[16];
+    bool eof;
+    device.Seek(7);
+    REQUIRE(device.Read(buffer, 6, eof) == 6);
+    REQUIRE(string_view(buffer, 6) == "789abc");
+    REQUIRE(!eof);
+    REQUIRE(device.GetPosition() == 13);
+
+    device.Seek(0);
+    REQUIRE(device.Read(buffer, 16, eof) == 16);
+    REQUIRE(string_view(buffer, 16) == "0123456789abcdef");
+    REQUIRE(eof);
+
+    // Reads past the end are truncated
+    device.Seek(-2, SeekDirection::End);
+    REQUIRE(device.Read(buffer, 10, eof) == 2);
+    REQUIRE(string_view(buffer, 2) == "ef");
+    REQUIRE(eof);
+
+    // Characters on both sides of the boundary
+    char ch;
+    device.Seek(9);
+    REQUIRE(device.Peek(ch));
+    REQUIRE(ch == '9');
+    REQUIRE(device.ReadChar() == '9');
+    REQUIRE(device.GetPosition() == 10);
+    REQUIRE(device.Peek(ch));
+    REQUIRE(ch == 'a');
+    REQUIRE(device.ReadChar() == 'a');
+    device.Seek(-1, SeekDirection::Current);
+    REQUIRE(device.GetPosition() == 10);
+    device.Seek(0, SeekDirection::End);
+    REQUIRE(!device.Peek(ch));
+    REQUIRE(!device.Read(ch));
+
+    // Writes inside the delta overwrite it
+    device.Seek(12);
+    device.Write("XY");
+    REQUIRE(deltaBuffer == "abXYef");
+    REQUIRE(device.GetLength() == 16);
+    device.Seek(11);
+    device.Write("0123456");
+    REQUIRE(deltaBuffer == "a0123456");
+    REQUIRE(device.GetLength() == 18);
+    ASSERT_THROW_WITH_ERROR_CODE(device.Seek(19), PdfErrorCode::ValueOutOfRange);
+}
+
+TEST_CASE("TestDeltaStreamDeviceSaveUpdate")
+{
+    charbuff baseBuffer;
+    {
+        PdfMemDocument doc;
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        StringStreamDevice device(baseBuffer);
+        doc.Save(device);
+    }
+
+    // Only the incremental update is stored in the delta
+    charbuff deltaBuffer;
+    auto base = std::make_shared<SpanStreamDevice>(baseBuffer);
+    auto device = std::make_shared<DeltaStreamDevice>(base, std::make_shared<StringStreamDevice>(deltaBuffer));
+    {
+        PdfMemDocument doc;
+        doc.Load(device);
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        doc.SaveUpdate(*device);
+    }
+
+    REQUIRE(deltaBuffer.size() != 0);
+    REQUIRE(device->GetLength() == baseBuffer.size() + deltaBuffer.size());
+
+    auto buffer = baseBuffer + deltaBuffer;
+    PdfMemDocument doc;
+    doc.LoadFromBuffer(buffer);
+    REQUIRE(doc.GetPages().GetCount() == 2);
+}
@@ -0,0 +1,821 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#include <PdfTest.h>
+
+#include <podofo/private/PdfDecodedStreamCache.h>
+#include <podofo/private/PdfWriter.h>
+
+using namespace std;
+using namespace PoDoFo;
+
+namespace PoDoFo
+{
+    class PdfDocumentTest
+    {
+    public:
+        static const PdfDecodedStreamCache& GetDecodedStreams(const PdfDocument& doc)
+        {
+            return *doc.m_DecodedStreams;
+        }
+
+        static const InputStreamDevice* GetDevice(const PdfMemDocument& doc)
+        {
+            return doc.m_device.get();
+        }
+    };
+}
+
+namespace
+{
+    // Signer that just records the signed data and returns
+    // a fixed signature, to check the /ByteRange coverage
+    class RecordingSigner final : public PdfSigner
+    {
+    public:
+        static constexpr string_view Signature = "RecordingSigner";
+
+        charbuff SignedData;
+
+        void Reset() override
+        {
+            SignedData.clear();
+        }
+
+        void AppendData(const bufferview& data) override
+        {
+            SignedData.append(data.data(), data.size());
+        }
+
+        void ComputeSignature(charbuff& contents, bool dryrun) override
+        {
+            (void)dryrun;
+            contents = Signature;
+        }
+
+        string GetSignatureSubFilter() const override
+        {
+            return "adbe.pkcs7.detached";
+        }
+
+        string GetSignatureType() const override
+        {
+            return "Sig";
+        }
+    };
+
+    // Get the /Contents of the signature dictionary in the file, if any
+    string getSignatureContents(const string_view& path)
+    {
+        PdfMemDocument doc;
+        doc.Load(path);
+        for (auto obj : doc.GetObjects())
+        {
+            const PdfDictionary* dict;
+            const PdfName* type;
+            if (obj->TryGetDictionary(dict) && dict->TryFindKeyAs("Type", type) && *type == "Sig")
+                return string(dict->MustFindKey("Contents").GetString().GetRawData());
+        }
+
+        return { };
+    }
+}
+
+TEST_CASE("TestSaveObjectStreams")
+{
+    static constexpr unsigned objectCount = 250;
+    auto createDocument = [](PdfMemDocument& doc) {
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        auto& fields = doc.GetCatalog().GetDictionary().AddKey("Extra", PdfArray()).GetArray();
+        for (unsigned i = 0; i < objectCount; i++)
+        {
+            auto& obj = doc.GetObjects().CreateDictionaryObject("Extra");
+            obj.GetDictionary().AddKey("Index", static_cast<int64_t>(i));
+            obj.GetDictionary().AddKey("Text", PdfString("Field text"));
+            fields.AddIndirect(obj);
+        }
+    };
+
+    charbuff plain;
+    {
+        PdfMemDocument doc;
+        createDocument(doc);
+        StringStreamDevice device(plain);
+        doc.Save(device, PdfSaveOptions::NoMetadataUpdate);
+    }
+
+    charbuff packed;
+    {
+        PdfMemDocument doc;
+        createDocument(doc);
+        doc.SetObjectStreamSize(40);
+        StringStreamDevice device(packed);
+        doc.Save(device, PdfSaveOptions::NoMetadataUpdate | PdfSaveOptions::UseObjectStreams);
+    }
+
+    REQUIRE(packed.size() < plain.size());
+
+    auto checkDocument = [](PdfMemDocument& doc) {
+        REQUIRE(doc.GetPages().GetCount() == 1);
+        auto& fields = doc.GetCatalog().GetDictionary().MustFindKey("Extra").GetArray();
+        REQUIRE(fields.GetSize() == objectCount);
+        for (unsigned i = 0; i < objectCount; i++)
+        {
+            auto& field = fields.MustFindAt(i).GetDictionary();
+            REQUIRE(field.MustFindKey("Index").GetNumber() == (int64_t)i);
+            REQUIRE(field.MustFindKey("Text").GetString() == "Field text");
+        }
+
+        // The objects are packed in the given number of object streams
+        unsigned objStmCount = 0;
+        for (auto obj : doc.GetObjects())
+        {
+            PdfDictionary* dict;
+            if (!obj->TryGetDictionary(dict))
+                continue;
+
+            auto typeObj = dict->GetKey("Type");
+            if (typeObj != nullptr && typeObj->IsName() && typeObj->GetName() == "ObjStm")
+                objStmCount++;
+        }
+        REQUIRE(objStmCount != 0);
+        REQUIRE(objStmCount <= objectCount / 40 + 2);
+    };
+
+    PdfMemDocument doc;
+    doc.LoadFromBuffer(packed);
+    REQUIRE(doc.GetMetadata().GetPdfVersion() >= PdfVersion::V1_5);
+    checkDocument(doc);
+
+    // The object streams of an encrypted document are encrypted as a whole
+    charbuff encrypted;
+    {
+        doc.SetEncrypted("user", "owner");
+        StringStreamDevice device(encrypted);
+        doc.Save(device, PdfSaveOptions::NoMetadataUpdate | PdfSaveOptions::UseObjectStreams);
+    }
+
+    PdfMemDocument encryptedDoc;
+    encryptedDoc.LoadFromBuffer(encrypted, "user");
+    checkDocument(encryptedDoc);
+}
+
+TEST_CASE("TestSaveObjectStreamsUpdate")
+{
+    PdfMemDocument doc;
+    doc.GetPages().CreatePage(PdfPageSize::A4);
+    auto& extra = doc.GetCatalog().GetDictionary().AddKey("Extra", PdfArray()).GetArray();
+    for (unsigned i = 0; i < 100; i++)
+    {
+        auto& obj = doc.GetObjects().CreateDictionaryObject();
+        obj.GetDictionary().AddKey("Index"_n, static_cast<int64_t>(i));
+        extra.AddIndirect(obj);
+    }
+
+    charbuff buffer;
+    doc.SetObjectStreamSize(40);
+    {
+        StringStreamDevice device(buffer);
+        doc.Save(device, PdfSaveOptions::NoMetadataUpdate | PdfSaveOptions::UseObjectStreams);
+    }
+
+    // The object created after the save doesn't take
+    // the number of one of the object streams written
+    auto& added = doc.GetObjects().CreateDictionaryObject();
+    added.GetDictionary().AddKey("Index"_n, static_cast<int64_t>(100));
+    extra.AddIndirect(added);
+    {
+        StringStreamDevice device(buffer);
+        doc.SaveUpdate(device, PdfSaveOptions::NoMetadataUpdate);
+    }
+
+    PdfMemDocument reloaded;
+    reloaded.LoadFromBuffer(buffer);
+    auto& reloadedExtra = reloaded.GetCatalog().GetDictionary().MustFindKey("Extra").GetArray();
+    REQUIRE(reloadedExtra.GetSize() == 101);
+    for (unsigned i = 0; i < reloadedExtra.GetSize(); i++)
+        REQUIRE(reloadedExtra.MustFindAt(i).GetDictionary().MustFindKey("Index").GetNumber() == (int64_t)i);
+}
+
+TEST_CASE("TestSaveUpdateDirtyObjects")
+{
+    charbuff buffer;
+    {
+        PdfMemDocument doc;
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        auto& extra = doc.GetCatalog().GetDictionary().AddKey("Extra", PdfArray()).GetArray();
+        for (unsigned i = 0; i < 100; i++)
+            extra.AddIndirect(doc.GetObjects().CreateDictionaryObject("Extra"));
+
+        StringStreamDevice device(buffer);
+        doc.Save(device);
+    }
+
+    auto countObjects = [](const string_view& data) {
+        unsigned count = 0;
+        size_t pos = 0;
+        while ((pos = data.find(" obj", pos)) != string_view::npos)
+        {
+            count++;
+            pos++;
+        }
+        return count;
+    };
+
+    PdfMemDocument doc;
+    doc.LoadFromBuffer(buffer);
+    auto& extra = doc.GetCatalog().GetDictionary().MustFindKey("Extra").GetArray();
+    extra.MustFindAt(10).GetDictionary().AddKey("Index", static_cast<int64_t>(10));
+    auto newRef = doc.GetObjects().CreateDictionaryObject("Extra").GetIndirectReference();
+
+    // Only the modified and the new objects are written in the update
+    charbuff updated = buffer;
+    {
+        StringStreamDevice device(updated);
+        doc.SaveUpdate(device, PdfSaveOptions::NoMetadataUpdate | PdfSaveOptions::NoCollectGarbage);
+    }
+    REQUIRE(countObjects(string_view(updated).substr(buffer.size())) == 2);
+
+    // No object is written if nothing changed since the last update
+    size_t length = updated.size();
+    {
+        StringStreamDevice device(updated);
+        doc.SaveUpdate(device, PdfSaveOptions::NoMetadataUpdate | PdfSaveOptions::NoCollectGarbage);
+    }
+    REQUIRE(countObjects(string_view(updated).substr(length)) == 0);
+
+    // Objects set dirty again after an update are written again
+    extra.MustFindAt(20).GetDictionary().AddKey("Index", static_cast<int64_t>(20));
+    extra.MustFindAt(10).GetDictionary().AddKey("Index", static_cast<int64_t>(11));
+    length = updated.size();
+    {
+        StringStreamDevice device(updated);
+        doc.SaveUpdate(device, PdfSaveOptions::NoMetadataUpdate | PdfSaveOptions::NoCollectGarbage);
+    }
+    REQUIRE(countObjects(string_view(updated).substr(length)) == 2);
+
+    // Objects that couldn't be written because of a failure
+    // are written by the next update
+    extra.MustFindAt(30).GetDictionary().AddKey("Index", static_cast<int64_t>(30));
+    {
+        charbuff full = updated;
+        SpanStreamDevice device(full.data(), full.size());
+        ASSERT_THROW_WITH_ERROR_CODE(doc.SaveUpdate(device, PdfSaveOptions::NoMetadataUpdate | PdfSaveOptions::NoCollectGarbage),
+            PdfErrorCode::ValueOutOfRange);
+    }
+    length = updated.size();
+    {
+        StringStreamDevice device(updated);
+        doc.SaveUpdate(device, PdfSaveOptions::NoMetadataUpdate | PdfSaveOptions::NoCollectGarbage);
+    }
+    REQUIRE(countObjects(string_view(updated).substr(length)) == 1);
+
+    PdfMemDocument reloaded;
+    reloaded.LoadFromBuffer(updated);
+    auto& reloadedExtra = reloaded.GetCatalog().GetDictionary().MustFindKey("Extra").GetArray();
+    REQUIRE(reloadedExtra.MustFindAt(10).GetDictionary().MustFindKey("Index").GetNumber() == 11);
+    REQUIRE(reloadedExtra.MustFindAt(20).GetDictionary().MustFindKey("Index").GetNumber() == 20);
+    REQUIRE(reloadedExtra.MustFindAt(30).GetDictionary().MustFindKey("Index").GetNumber() == 30);
+    REQUIRE(reloaded.GetObjects().GetObject(newRef) != nullptr);
+}
+
+TEST_CASE("TestSaveUpdatePrevChain")
+{
+    // Two updates appended to the loaded document, as when
+    // adding the DSS and then the document timestamp
+    for (auto opts : { PdfSaveOptions::None, PdfSaveOptions::UseObjectStreams })
+    {
+        charbuff buffer;
+        {
+            PdfMemDocument doc;
+            doc.GetPages().CreatePage(PdfPageSize::A4);
+            StringStreamDevice device(buffer);
+            doc.Save(device, opts | PdfSaveOptions::NoMetadataUpdate);
+        }
+
+        // The loaded buffer must outlive the document
+        charbuff loaded = buffer;
+        PdfMemDocument doc;
+        doc.LoadFromBuffer(loaded);
+        StringStreamDevice device(buffer);
+        for (int64_t i = 0; i < 2; i++)
+        {
+            doc.GetCatalog().GetDictionary().AddKey("Revision"_n, i);
+            doc.SaveUpdate(device, PdfSaveOptions::NoMetadataUpdate);
+        }
+
+        // Each revision refers to the xref of the previous one
+        vector<size_t> xrefOffsets;
+        size_t pos = 0;
+        while ((pos = buffer.find("startxref", pos)) != string::npos)
+        {
+            pos += 9;
+            xrefOffsets.push_back((size_t)std::stoull(buffer.substr(pos, 32)));
+        }
+        REQUIRE(xrefOffsets.size() == 3);
+        for (unsigned i = 1; i < xrefOffsets.size(); i++)
+        {
+            auto prev = buffer.find("/Prev ", xrefOffsets[i]);
+            REQUIRE(prev < buffer.find("startxref", xrefOffsets[i]));
+            REQUIRE((size_t)std::stoull(buffer.substr(prev + 6, 32)) == xrefOffsets[i - 1]);
+        }
+
+        PdfMemDocument reloaded;
+        reloaded.LoadFromBuffer(buffer);
+        REQUIRE(reloaded.GetCatalog().GetDictionary().MustFindKey("Revision").GetNumber() == 1);
+        REQUIRE(reloaded.GetPages().GetCount() == 1);
+    }
+}
+
+TEST_CASE("TestSaveParallelStreamCompression")
+{
+    PdfMemDocument doc;
+    doc.GetPages().CreatePage(PdfPageSize::A4);
+    auto& extra = doc.GetCatalog().GetDictionary().AddKey("Extra", PdfArray()).GetArray();
+    vector<PdfReference> refs;
+    for (unsigned i = 0; i < 50; i++)
+    {
+        auto& obj = doc.GetObjects().CreateDictionaryObject();
+        obj.GetOrCreateStream().SetData(string(1000 + i, (char)('a' + i % 26)), true);
+        extra.AddIndirect(obj);
+        refs.push_back(obj.GetIndirectReference());
+    }
+
+    charbuff buffer;
+    doc.SetSaveThreadCount(0);
+    {
+        StringStreamDevice device(buffer);
+        doc.Save(device);
+    }
+
+    // The streams of the document are not modified by the save
+    for (unsigned i = 0; i < refs.size(); i++)
+    {
+        auto& obj = doc.GetObjects().MustGetObject(refs[i]);
+        REQUIRE(obj.MustGetStream().GetFilters().size() == 0);
+        REQUIRE(!obj.GetDictionary().HasKey("Filter"));
+        REQUIRE(!obj.IsDirty());
+        REQUIRE(obj.MustGetStream().GetCopy() == string(1000 + i, (char)('a' + i % 26)));
+    }
+
+    // A further save without compression writes the plain data
+    charbuff plain;
+    {
+        StringStreamDevice device(plain);
+        doc.Save(device, PdfSaveOptions::NoFlateCompress);
+    }
+    REQUIRE(plain.find(string(1000, 'a')) != string::npos);
+
+    // The streams encoded ahead are encrypted when writing them
+    charbuff encrypted;
+    {
+        PdfMemDocument encryptedDoc;
+        encryptedDoc.LoadFromBuffer(plain);
+        encryptedDoc.SetEncrypted("user", "owner");
+        encryptedDoc.SetSaveThreadCount(4);
+        StringStreamDevice device(encrypted);
+        encryptedDoc.Save(device);
+    }
+
+    PdfMemDocument decrypted;
+    decrypted.LoadFromBuffer(encrypted, "user");
+    for (unsigned i = 0; i < refs.size(); i++)
+        REQUIRE(decrypted.GetObjects().MustGetObject(refs[i]).MustGetStream().GetCopy() == string(1000 + i, (char)('a' + i % 26)));
+
+    PdfMemDocument reloaded;
+    reloaded.LoadFromBuffer(buffer);
+    for (unsigned i = 0; i < refs.size(); i++)
+    {
+        auto& obj = reloaded.GetObjects().MustGetObject(refs[i]);
+        REQUIRE(obj.GetDictionary().MustFindKey("Filter").GetName() == "FlateDecode");
+        REQUIRE(obj.MustGetStream().GetCopy() == string(1000 + i, (char)('a' + i % 26)));
+    }
+
+    // New streams are compressed in incremental updates as well
+    auto& added = reloaded.GetObjects().CreateDictionaryObject();
+    added.GetOrCreateStream().SetData(string(2000, 'z'), true);
+    reloaded.GetCatalog().GetDictionary().AddKeyIndirect("Added"_n, added);
+    reloaded.SetSaveThreadCount(4);
+    charbuff updated = buffer;
+    {
+        StringStreamDevice device(updated);
+        reloaded.SaveUpdate(device);
+    }
+
+    PdfMemDocument reloadedUpdate;
+    reloadedUpdate.LoadFromBuffer(updated);
+    auto& addedReloaded = reloadedUpdate.GetCatalog().GetDictionary().MustFindKey("Added");
+    REQUIRE(addedReloaded.GetDictionary().MustFindKey("Filter").GetName() == "FlateDecode");
+    REQUIRE(addedReloaded.MustGetStream().GetCopy() == string(2000, 'z'));
+    REQUIRE(added.MustGetStream().GetFilters().size() == 0);
+}
+
+TEST_CASE("TestSaveParallelStreamCompressionWindows")
+{
+    // The streams span several windows of compression ahead
+    PdfMemDocument doc;
+    doc.GetPages().CreatePage(PdfPageSize::A4);
+    auto& extra = doc.GetCatalog().GetDictionary().AddKey("Extra", PdfArray()).GetArray();
+    size_t streamSize = PdfWriter::CompressWindowSize / 3 + 1;
+    vector<PdfReference> refs;
+    for (unsigned i = 0; i < 7; i++)
+    {
+        auto& obj = doc.GetObjects().CreateDictionaryObject();
+        obj.GetOrCreateStream().SetData(string(streamSize, (char)('a' + i)), true);
+        extra.AddIndirect(obj);
+        refs.push_back(obj.GetIndirectReference());
+    }
+
+    charbuff buffer;
+    doc.SetSaveThreadCount(4);
+    {
+        StringStreamDevice device(buffer);
+        doc.Save(device);
+    }
+
+    PdfMemDocument reloaded;
+    reloaded.LoadFromBuffer(buffer);
+    for (unsigned i = 0; i < refs.size(); i++)
+    {
+        auto& obj = reloaded.GetObjects().MustGetObject(refs[i]);
+        REQUIRE(obj.GetDictionary().MustFindKey("Filter").GetName() == "FlateDecode");
+        REQUIRE(obj.MustGetStream().GetCopy() == string(streamSize, (char)('a' + i)));
+    }
+}
+
+TEST_CASE("TestSaveObjectStreamsOnSigning")
+{
+    PdfMemDocument doc;
+    auto& page = doc.GetPages().CreatePage(PdfPageSize::A4);
+    auto& signature = page.CreateField<PdfSignature>("Signature", Rect(100, 600, 100, 100));
+    signature.SetSignatureDate(PdfDate::LocalNow());
+
+    charbuff buffer;
+    {
+        StringStreamDevice device(buffer);
+        RecordingSigner signer;
+        SignDocument(doc, device, signer, signature,
+            PdfSaveOptions::SaveOnSigning | PdfSaveOptions::UseObjectStreams);
+
+        // The signature dictionary is written outside of the object
+        // streams, so the /ByteRange covers all the file but /Contents
+        PdfArray byteRange;
+        {
+            PdfMemDocument signedDoc;
+            signedDoc.LoadFromBuffer(buffer);
+            unsigned objStmCount = 0;
+            const PdfDictionary* sigDict = nullptr;
+            for (auto obj : signedDoc.GetObjects())
+            {
+                const PdfDictionary* dict;
+                const PdfName* type;
+                if (!obj->TryGetDictionary(dict) || !dict->TryFindKeyAs("Type", type))
+                    continue;
+
+                if (*type == "ObjStm")
+                    objStmCount++;
+                else if (*type == "Sig")
+                    sigDict = dict;
+            }
+
+            REQUIRE(objStmCount != 0);
+            REQUIRE(sigDict != nullptr);
+            byteRange = sigDict->MustFindKey("ByteRange").GetArray();
+            auto contents = sigDict->MustFindKey("Contents").GetString().GetRawData();
+            REQUIRE(contents.substr(0, RecordingSigner::Signature.size()) == RecordingSigner::Signature);
+        }
+
+        REQUIRE(byteRange.GetSize() == 4);
+        auto offset1 = (size_t)byteRange[0].GetNumber();
+        auto length1 = (size_t)byteRange[1].GetNumber();
+        auto offset2 = (size_t)byteRange[2].GetNumber();
+        auto length2 = (size_t)byteRange[3].GetNumber();
+        REQUIRE(offset1 == 0);
+        REQUIRE(offset2 + length2 == buffer.size());
+        REQUIRE(buffer[length1] == '<');
+        REQUIRE(buffer[offset2 - 1] == '>');
+        REQUIRE(signer.SignedData == buffer.substr(0, length1) + buffer.substr(offset2, length2));
+    }
+}
+
+TEST_CASE("TestSigningPipeline")
+{
+    auto inputPath = TestUtils::GetTestOutputFilePath("TestSigningPipeline.pdf");
+    auto outputPath = TestUtils::GetTestOutputFilePath("TestSigningPipelineSigned.pdf");
+    {
+        PdfMemDocument doc;
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        doc.Save(inputPath);
+    }
+    auto inputSize = fs::file_size(fs::u8path(inputPath));
+
+    auto signer = std::make_shared<RecordingSigner>();
+    PdfSigningPipeline pipeline(1);
+    REQUIRE(pipeline.GetWorkerCount() == 1);
+
+    PdfSigningJob job;
+    job.InputPath = inputPath;
+    job.OutputPath = outputPath;
+    job.Prepare = [&signer](PdfMemDocument& doc, PdfSigningContext& ctx) {
+        auto& signature = doc.GetPages().GetPageAt(0).CreateField<PdfSignature>("Signature", Rect());
+        ctx.AddSigner(signature, signer);
+    };
+    REQUIRE(pipeline.Enqueue(job) == 0);
+    pipeline.Wait();
+
+    // The input is copied to the output before signing
+    REQUIRE(fs::file_size(fs::u8path(inputPath)) == inputSize);
+
+    auto contents = getSignatureContents(outputPath);
+    REQUIRE(contents.substr(0, RecordingSigner::Signature.size()) == RecordingSigner::Signature);
+    REQUIRE(getSignatureContents(inputPath).empty());
+    REQUIRE(signer->SignedData.size() != 0);
+
+    // Jobs without a preparation function are rejected
+    ASSERT_THROW_WITH_ERROR_CODE(pipeline.Enqueue(PdfSigningJob()), PdfErrorCode::InvalidHandle);
+}
+
+TEST_CASE("TestSigningPipelineFailingJob")
+{
+    auto inputPath = TestUtils::GetTestOutputFilePath("TestSigningPipelineFailing.pdf");
+    {
+        PdfMemDocument doc;
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        doc.Save(inputPath);
+    }
+
+    auto createJob = [&](const string& outputPath, bool fail) {
+        PdfSigningJob job;
+        job.InputPath = inputPath;
+        job.OutputPath = outputPath;
+        job.Prepare = [fail](PdfMemDocument& doc, PdfSigningContext& ctx) {
+            if (fail)
+                throw runtime_error("Preparation failed");
+
+            auto& signature = doc.GetPages().GetPageAt(0).CreateField<PdfSignature>("Signature", Rect());
+            ctx.AddSigner(signature, std::make_shared<RecordingSigner>());
+        };
+        return job;
+    };
+
+    auto outputPath1 = TestUtils::GetTestOutputFilePath("TestSigningPipelineFailing1.pdf");
+    auto outputPath2 = TestUtils::GetTestOutputFilePath("TestSigningPipelineFailing2.pdf");
+    auto outputPath3 = TestUtils::GetTestOutputFilePath("TestSigningPipelineFailing3.pdf");
+
+    // Without a completed handler the first error is rethrown by Wait(),
+    // while the other jobs are still completed
+    {
+        PdfSigningPipeline pipeline(2);
+        pipeline.Enqueue(createJob(outputPath1, false));
+        pipeline.Enqueue(createJob(outputPath2, true));
+        pipeline.Enqueue(createJob(outputPath3, false));
+        REQUIRE_THROWS_AS(pipeline.Wait(), runtime_error);
+
+        // The error is reported only once
+        pipeline.Wait();
+    }
+
+    REQUIRE(!getSignatureContents(outputPath1).empty());
+    REQUIRE(!getSignatureContents(outputPath3).empty());
+
+    // With a completed handler every job reports its own result
+    mutex mutex;
+    vector<exception_ptr> errors(3);
+    vector<bool> completed(3);
+    {
+        PdfSigningPipeline pipeline(2);
+        pipeline.SetCompletedHandler([&](size_t jobIndex, exception_ptr error) {
+            lock_guard<std::mutex> lock(mutex);
+            errors[jobIndex] = error;
+            completed[jobIndex] = true;
+        });
+        pipeline.Enqueue(createJob(outputPath1, false));
+        pipeline.Enqueue(createJob(outputPath2, true));
+        pipeline.Enqueue(createJob(outputPath3, false));
+        pipeline.Wait();
+    }
+
+    REQUIRE(completed == vector<bool>{ true, true, true });
+    REQUIRE(errors[0] == nullptr);
+    REQUIRE(errors[1] != nullptr);
+    REQUIRE(errors[2] == nullptr);
+    REQUIRE_THROWS_AS(rethrow_exception(errors[1]), runtime_error);
+}
+
+TEST_CASE("TestDecodedStreamCache")
+{
+    charbuff buffer;
+    {
+        PdfMemDocument doc;
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        auto& obj = doc.GetObjects().CreateDictionaryObject();
+        obj.GetOrCreateStream().SetData(string(10000, 'a'));
+        doc.GetCatalog().GetDictionary().AddKeyIndirect("Shared"_n, obj);
+        StringStreamDevice device(buffer);
+        doc.Save(device);
+    }
+
+    PdfMemDocument doc;
+    doc.SetDecodedStreamCacheSize(100000);
+    doc.LoadFromBuffer(buffer);
+    REQUIRE(doc.GetDecodedStreamCacheSize() == 100000);
+    auto& cache = PdfDocumentTest::GetDecodedStreams(doc);
+    REQUIRE(cache.GetBudget() == 100000);
+    REQUIRE(cache.GetSize() == 0);
+    auto& obj = doc.GetCatalog().GetDictionary().MustFindKey("Shared");
+    auto& stream = obj.MustGetStream();
+    REQUIRE(stream.GetCopy() == string(10000, 'a'));
+    REQUIRE(cache.GetSize() == 10000);
+    REQUIRE(stream.GetCopy() == string(10000, 'a'));
+    REQUIRE(cache.GetSize() == 10000);
+    charbuff copied;
+    {
+        StringStreamDevice device(copied);
+        stream.CopyTo(device);
+    }
+    REQUIRE(copied == string(10000, 'a'));
+
+    // The cached data is dropped when the stream is written
+    stream.SetData(string(5000, 'b'));
+    REQUIRE(cache.GetSize() == 0);
+    REQUIRE(stream.GetCopy() == string(5000, 'b'));
+    REQUIRE(cache.GetSize() == 5000);
+    {
+        auto output = stream.GetOutputStream(true);
+        output.Write(string(10, 'c'));
+    }
+    REQUIRE(stream.GetCopy() == string(5000, 'b') + string(10, 'c'));
+
+    // ...and when the dictionary is modified, as the
+    // decode parameters may change the decoded data
+    string predicted;
+    for (unsigned i = 0; i < 10; i++)
+        predicted.append(i == 0 ? string_view("\x02\x01\x02\x03\x04", 5) : string_view("\x02\x01\x01\x01\x01", 5));
+    stream.SetData(predicted);
+    REQUIRE(stream.GetCopy() == predicted);
+    PdfDictionary decodeParms;
+    decodeParms.AddKey("Predictor"_n, static_cast<int64_t>(12));
+    decodeParms.AddKey("Columns"_n, static_cast<int64_t>(4));
+    obj.GetDictionary().AddKey("DecodeParms"_n, decodeParms);
+    REQUIRE(cache.GetSize() == 0);
+    auto decoded = stream.GetCopy();
+    REQUIRE(decoded.size() == 40);
+    REQUIRE(decoded.substr(36) == string_view("\x0a\x0b\x0c\x0d", 4));
+
+    REQUIRE(cache.GetSize() == 40);
+
+    // Data larger than the budget is still decoded, but not cached
+    doc.SetDecodedStreamCacheSize(10);
+    REQUIRE(cache.GetBudget() == 10);
+    REQUIRE(cache.GetSize() == 0);
+    obj.GetDictionary().RemoveKey("DecodeParms");
+    stream.SetData(string(1000, 'd'));
+    REQUIRE(stream.GetCopy() == string(1000, 'd'));
+    REQUIRE(cache.GetSize() == 0);
+    REQUIRE(stream.GetCopy() == string(1000, 'd'));
+
+    // Streamed copies are written directly, and cached only if they fit
+    charbuff streamed;
+    {
+        StringStreamDevice device(streamed);
+        stream.CopyTo(device);
+    }
+    REQUIRE(streamed == string(1000, 'd'));
+    REQUIRE(cache.GetSize() == 0);
+    doc.SetDecodedStreamCacheSize(2000);
+    streamed.clear();
+    {
+        StringStreamDevice device(streamed);
+        stream.CopyTo(device);
+    }
+    REQUIRE(streamed == string(1000, 'd'));
+    REQUIRE(cache.GetSize() == 1000);
+
+    doc.SetDecodedStreamCacheSize(0);
+    REQUIRE(doc.GetDecodedStreamCacheSize() == 0);
+    REQUIRE(stream.GetCopy() == string(1000, 'd'));
+}
+
+TEST_CASE("TestDecodedStreamCacheEviction")
+{
+    charbuff buffer;
+    {
+        PdfMemDocument doc;
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        auto& streams = doc.GetCatalog().GetDictionary().AddKey("Streams"_n, PdfArray()).GetArray();
+        for (size_t size : { 100, 200, 150 })
+        {
+            auto& obj = doc.GetObjects().CreateDictionaryObject();
+            obj.GetOrCreateStream().SetData(string(size, 'a'));
+            streams.AddIndirect(obj);
+        }
+        StringStreamDevice device(buffer);
+        doc.Save(device);
+    }
+
+    PdfMemDocument doc;
+    doc.SetDecodedStreamCacheSize(300);
+    doc.LoadFromBuffer(buffer);
+    auto& cache = PdfDocumentTest::GetDecodedStreams(doc);
+    auto& streams = doc.GetCatalog().GetDictionary().MustFindKey("Streams").GetArray();
+    auto& stream1 = streams.MustFindAt(0).MustGetStream();
+    auto& stream2 = streams.MustFindAt(1).MustGetStream();
+    auto& stream3 = streams.MustFindAt(2).MustGetStream();
+
+    REQUIRE(stream1.GetCopy() == string(100, 'a'));
+    REQUIRE(stream2.GetCopy() == string(200, 'a'));
+    REQUIRE(cache.GetSize() == 300);
+
+    // Reading the first stream again makes the second
+    // the least recently used, so it's the one evicted
+    REQUIRE(stream1.GetCopy() == string(100, 'a'));
+    REQUIRE(cache.GetSize() == 300);
+    REQUIRE(stream3.GetCopy() == string(150, 'a'));
+    REQUIRE(cache.GetSize() == 250);
+
+    // Lowering the budget evicts the least recently used first
+    doc.SetDecodedStreamCacheSize(200);
+    REQUIRE(cache.GetSize() == 150);
+    REQUIRE(stream3.GetCopy() == string(150, 'a'));
+    REQUIRE(cache.GetSize() == 150);
+}
+
+TEST_CASE("TestDecodedStreamCacheLRU")
+{
+    auto data = [](size_t size) {
+        return std::make_shared<const charbuff>(string(size, 'a'));
+    };
+
+    PdfDecodedStreamCache cache(300);
+    auto data1 = data(100);
+    cache.Add(1, data1);
+    cache.Add(2, data(100));
+    cache.Add(3, data(100));
+    REQUIRE(cache.GetSize() == 300);
+    REQUIRE(cache.Find(1) == data1);
+    REQUIRE(cache.Find(4) == nullptr);
+
+    // The entry 2 is now the least recently used
+    cache.Add(4, data(100));
+    REQUIRE(cache.GetSize() == 300);
+    REQUIRE(cache.Find(2) == nullptr);
+    REQUIRE(cache.Find(1) == data1);
+    REQUIRE(cache.Find(3) != nullptr);
+    REQUIRE(cache.Find(4) != nullptr);
+
+    // Adding an existing key replaces the data
+    cache.Add(1, data(50));
+    REQUIRE(cache.GetSize() == 250);
+    REQUIRE(cache.Find(1)->size() == 50);
+
+    // Data larger than the budget is not added
+    cache.Add(5, data(301));
+    REQUIRE(cache.Find(5) == nullptr);
+    REQUIRE(cache.GetSize() == 250);
+
+    // The order is now 1, 4, 3 from the most recently used
+    cache.SetBudget(150);
+    REQUIRE(cache.GetBudget() == 150);
+    REQUIRE(cache.GetSize() == 150);
+    REQUIRE(cache.Find(3) == nullptr);
+    REQUIRE(cache.Find(4) != nullptr);
+
+    cache.Remove(4);
+    REQUIRE(cache.GetSize() == 50);
+    cache.Clear();
+    REQUIRE(cache.GetSize() == 0);
+    REQUIRE(cache.Find(1) == nullptr);
+}
+
+TEST_CASE("TestParallelLoadFile")
+{
+    PdfMemDocument doc;
+    doc.GetPages().CreatePage(PdfPageSize::A4);
+    auto& extra = doc.GetCatalog().GetDictionary().AddKey("Extra", PdfArray()).GetArray();
+    for (unsigned i = 0; i < 20; i++)
+    {
+        auto& obj = doc.GetObjects().CreateDictionaryObject();
+        obj.GetDictionary().AddKey("Index"_n, (int64_t)i);
+        extra.AddIndirect(obj);
+    }
+    auto path = TestUtils::GetTestOutputFilePath("TestParallelLoadFile.pdf");
+    doc.Save(path);
+
+    // The file is mapped, so the objects are parsed in parallel from its view
+    PdfMemDocument parallel;
+    parallel.SetLoadThreadCount(4);
+    parallel.Load(path);
+    REQUIRE(dynamic_cast<const MappedFileStreamDevice*>(PdfDocumentTest::GetDevice(parallel)) != nullptr);
+    for (auto obj : parallel.GetObjects())
+        REQUIRE(obj->IsDelayedLoadDone());
+    auto& parallelExtra = parallel.GetCatalog().GetDictionary().MustFindKey("Extra").GetArray();
+    REQUIRE(parallelExtra.GetSize() == 20);
+    REQUIRE(parallelExtra.MustFindAt(19).GetDictionary().MustFindKey("Index").GetNumber() == 19);
+
+    PdfMemDocument onDemand;
+    onDemand.Load(path);
+    REQUIRE(dynamic_cast<const FileStreamDevice*>(PdfDocumentTest::GetDevice(onDemand)) != nullptr);
+}
@@ -34,6 +34,89 @@ TEST_CASE("TestFilters")
     }
 }
 
+TEST_CASE("TestFlateBuffers")
+{
+    auto filter = PdfFilterFactory::Create(PdfFilterType::FlateDecode);
+    auto decodeByBlocks = [&](const bufferview& encoded, const PdfDictionary* decodeParms) {
+        charbuff decoded;
+        BufferStreamDevice stream(decoded);
+        filter->BeginDecode(stream, decodeParms);
+        filter->DecodeBlock(encoded);
+        filter->EndDecode();
+        return decoded;
+    };
+
+    // Highly compressible data makes the whole buffer
+    // decoding grow the output buffer many times
+    string data;
+    for (unsigned i = 0; i < 100000; i++)
+        data.append(utls::Format("{} ", i % 100));
+
+    charbuff encoded;
+    filter->EncodeTo(encoded, data);
+    charbuff decoded;
+    filter->DecodeTo(decoded, encoded);
+    REQUIRE(decoded == data);
+    REQUIRE(decodeByBlocks(encoded, nullptr) == data);
+
+    // Truncated streams are decoded as far as possible
+    auto truncated = bufferview(encoded).subspan(0, encoded.size() / 2);
+    decoded.clear();
+    filter->DecodeTo(decoded, truncated);
+    REQUIRE(decoded.size() != 0);
+    REQUIRE(decoded == decodeByBlocks(truncated, nullptr));
+
+    // A spurious carriage return before the header is skipped
+    charbuff spurious("\r", 1);
+    spurious.append(encoded);
+    decoded.clear();
+    filter->DecodeTo(decoded, spurious);
+    REQUIRE(decoded == data);
+
+    // PNG Up predictor, with rows of 4 bytes
+    string predicted;
+    string expected;
+    for (unsigned i = 0; i < 1000; i++)
+    {
+        predicted.push_back(2);
+        predicted.append(i == 0 ? string_view("\x01\x02\x03\x04", 4) : string_view("\x01\x01\x01\x01", 4));
+        for (unsigned j = 0; j < 4; j++)
+            expected.push_back((char)(i + j + 1));
+    }
+
+    PdfDictionary decodeParms;
+    decodeParms.AddKey("Predictor"_n, static_cast<int64_t>(12));
+    decodeParms.AddKey("Columns"_n, static_cast<int64_t>(4));
+    encoded.clear();
+    filter->EncodeTo(encoded, predicted);
+    decoded.clear();
+    filter->DecodeTo(decoded, encoded, &decodeParms);
+    REQUIRE(decoded == expected);
+    REQUIRE(decodeByBlocks(encoded, &decodeParms) == expected);
+
+    // The compression level applies to both whole buffer and block encoding
+    charbuff defaultEncoded;
+    filter->EncodeTo(defaultEncoded, data);
+    PdfCommon::SetFlateCompressionLevel(0);
+    charbuff storedEncoded;
+    filter->EncodeTo(storedEncoded, data);
+    charbuff blocksEncoded;
+    {
+        BufferStreamDevice stream(blocksEncoded);
+        filter->BeginEncode(stream);
+        filter->EncodeBlock(data);
+        filter->EndEncode();
+    }
+    PdfCommon::SetFlateCompressionLevel(-1);
+    REQUIRE(storedEncoded.size() > data.size());
+    REQUIRE(blocksEncoded.size() > data.size());
+    REQUIRE(defaultEncoded.size() < data.size());
+    decoded.clear();
+    filter->DecodeTo(decoded, storedEncoded);
+    REQUIRE(decoded == data);
+    ASSERT_THROW_WITH_ERROR_CODE(PdfCommon::SetFlateCompressionLevel(10), PdfErrorCode::ValueOutOfRange);
+}
+
 void testFilter(PdfFilterType filterType, const bufferview& view)
 {
     charbuff encoded;
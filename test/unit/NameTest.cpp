@@ -101,6 +101,27 @@ TEST_CASE("TestFromEscaped")
     TestFromEscape("Length#20With#20Spaces", "Length With Spaces");
 }
 
+TEST_CASE("TestKnownNames")
+{
+    // Well known names share the same storage
+    auto type1 = PdfName::FromEscaped("Type");
+    PdfName type2("Type");
+    REQUIRE(type1.GetRawData().data() == type2.GetRawData().data());
+    REQUIRE(type1 == type2);
+    REQUIRE(type1 == "Type"_n);
+    REQUIRE(PdfName::FromRaw(bufferview("Length", 6)) == "Length"_n);
+
+    // Escaped known names are equal to the unescaped ones
+    auto escaped = PdfName::FromEscaped("#54ype");
+    REQUIRE(escaped == type1);
+
+    auto unknown1 = PdfName::FromEscaped("NotKnownName");
+    auto unknown2 = PdfName::FromEscaped("NotKnownName");
+    REQUIRE(unknown1.GetRawData().data() != unknown2.GetRawData().data());
+    REQUIRE(unknown1 == unknown2);
+    REQUIRE(unknown1 != type1);
+}
+
 //
 // Test encoding of names.
 // pszString : internal representation, ie unencoded name
@@ -149,6 +149,80 @@ TEST_CASE("TestGetPages")
     testGetPages(doc);
 }
 
+TEST_CASE("TestGetPageOnDemand")
+{
+    auto doc = PdfPageTest::CreateTestTreeCustom();
+    auto& pages = doc.GetPages();
+
+    // Pages found before the tree is traversed are kept by the traversal
+    auto& page = pages.GetPageAt(TEST_NUM_PAGES - 1);
+    REQUIRE(isPageNumber(page, TEST_NUM_PAGES - 1));
+    REQUIRE(page.GetIndex() == TEST_NUM_PAGES - 1);
+    REQUIRE(&pages.GetPageAt(TEST_NUM_PAGES - 1) == &page);
+    auto& page2 = pages.GetPageAt(42);
+    REQUIRE(isPageNumber(page2, 42));
+
+    REQUIRE(pages.GetCount() == TEST_NUM_PAGES);
+    REQUIRE(&pages.GetPageAt(TEST_NUM_PAGES - 1) == &page);
+    REQUIRE(&pages.GetPageAt(42) == &page2);
+    REQUIRE(&pages.GetPage(page.GetObject().GetIndirectReference()) == &page);
+    ASSERT_THROW_WITH_ERROR_CODE(pages.GetPageAt(TEST_NUM_PAGES), PdfErrorCode::ValueOutOfRange);
+}
+
+TEST_CASE("TestGetPageOnDemandWrongCount")
+{
+    // The /Count of a subtree preceding the requested page
+    // contradicts its actual leaves: the whole tree is traversed
+    for (int64_t count : { 9, 11 })
+    {
+        auto doc = PdfPageTest::CreateTestTreeCustom();
+        auto& root = doc.GetCatalog().GetDictionary().MustFindKey("Pages");
+        auto& node = root.GetDictionary().MustFindKey("Kids").GetArray().MustFindAt(2);
+        node.GetDictionary().AddKey("Count"_n, count);
+
+        auto& pages = doc.GetPages();
+        auto& page = pages.GetPageAt(42);
+        REQUIRE(isPageNumber(page, 42));
+        REQUIRE(page.GetIndex() == 42);
+        REQUIRE(pages.GetCount() == TEST_NUM_PAGES);
+        REQUIRE(&pages.GetPageAt(42) == &page);
+    }
+}
+
+TEST_CASE("TestIteratePagesOnDemand")
+{
+    {
+        // Iterating traverses the tree, keeping the pages already found
+        auto doc = PdfPageTest::CreateTestTreeCustom();
+        auto& pages = doc.GetPages();
+        auto& page = pages.GetPageAt(0);
+        unsigned index = 0;
+        for (auto iteratedPage : pages)
+        {
+            REQUIRE(isPageNumber(*iteratedPage, index));
+            REQUIRE(iteratedPage->GetIndex() == index);
+            if (index == 0)
+                REQUIRE(iteratedPage == &page);
+
+            index++;
+        }
+        REQUIRE(index == TEST_NUM_PAGES);
+    }
+
+    {
+        // Iterating with no prior access
+        auto doc = PdfPageTest::CreateTestTreeCustom();
+        const auto& pages = std::as_const(doc).GetPages();
+        unsigned index = 0;
+        for (auto iteratedPage : pages)
+        {
+            REQUIRE(iteratedPage->GetIndex() == index);
+            index++;
+        }
+        REQUIRE(index == TEST_NUM_PAGES);
+    }
+}
+
 TEST_CASE("TestGetPagesReverseCustom")
 {
     auto doc = PdfPageTest::CreateTestTreeCustom();
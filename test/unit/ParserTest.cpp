@@ -28,6 +28,8 @@ using namespace std;
 using namespace PoDoFo;
 
 static string generateXRefEntries(size_t count);
+static string generateObjectStreamPdf(const vector<string>& compressed,
+    const vector<string>& objects = { }, bool indirectLength = false);
 static bool canOutOfMemoryKillUnitTests();
 static size_t getStackOverflowDepth();
 
@@ -2804,6 +2806,255 @@ TEST_CASE("TestReclaimObjectMemory")
     REQUIRE(!imageObj->TryUnload());
 }
 
+TEST_CASE("TestDemandLoadObjectStream")
+{
+    // Objects in object streams are created as placeholders
+    // which decode their stream only when first accessed
+    auto buffer = generateObjectStreamPdf({
+        "<</Type/Catalog /Pages 2 0 R /Extra 4 0 R>>",
+        "<</Type/Pages /Kids [3 0 R] /Count 1>>",
+        "<</Type/Page /Parent 2 0 R /MediaBox [0 0 612 792]>>",
+        "<</Key 42>>",
+    });
+    PdfMemDocument doc;
+    doc.LoadFromBuffer(buffer);
+
+    auto obj = doc.GetObjects().GetObject(PdfReference(4, 0));
+    REQUIRE(obj != nullptr);
+    REQUIRE(!obj->IsDelayedLoadDone());
+    REQUIRE(obj->GetDictionary().MustFindKey("Key").GetNumber() == 42);
+    REQUIRE(obj->IsDelayedLoadDone());
+    REQUIRE(obj->TryUnload());
+    REQUIRE(!obj->IsDelayedLoadDone());
+
+    REQUIRE(doc.GetPages().GetCount() == 1);
+    REQUIRE(doc.GetPages().GetPageAt(0).GetRect().Width == 612);
+
+    // Modified objects can't be reloaded from the stream
+    obj->GetDictionary().AddKey("Key", PdfObject(static_cast<int64_t>(43)));
+    REQUIRE(!obj->TryUnload());
+
+    charbuff output;
+    StringStreamDevice outDev(output);
+    doc.Save(outDev);
+
+    PdfMemDocument doc2;
+    doc2.LoadFromBuffer(output);
+    REQUIRE(doc2.GetObjects().MustGetObject(PdfReference(4, 0)).GetDictionary().MustFindKey("Key").GetNumber() == 43);
+    REQUIRE(doc2.GetPages().GetCount() == 1);
+}
+
+TEST_CASE("TestReconstructXRef")
+{
+    // The stream data contains tokens that must not be
+    // taken as objects or trailers
+    string streamData = "5 0 obj <</Fake true>> endobj\ntrailer <</Root 5 0 R>>";
+    ostringstream oss;
+    oss << "%PDF-1.4\n";
+    oss << "1 0 obj <</Type/Catalog /Pages 2 0 R>> endobj\n";
+    oss << "2 0 obj <</Type/Pages /Kids [3 0 R] /Count 1>> endobj\n";
+    oss << "3 0 obj <</Type/Page /Parent 2 0 R /MediaBox [0 0 612 792] /Contents 4 0 R>> endobj\n";
+    oss << "4 0 obj <</Length " << streamData.size() << ">>stream\n" << streamData << "\nendstream\nendobj\n";
+    oss << "xref\n0 5\nbroken\ntrailer <</Size 5 /Root 1 0 R>>\n";
+    // The later definition of an object replaces the previous one
+    oss << "3 0 obj <</Type/Page /Parent 2 0 R /MediaBox [0 0 300 400] /Contents 4 0 R>> endobj\n";
+    auto body = oss.str();
+
+    auto check = [&streamData](const string& buffer) {
+        PdfMemDocument doc;
+        doc.LoadFromBuffer(buffer);
+        REQUIRE(doc.GetObjects().GetObject(PdfReference(5, 0)) == nullptr);
+        REQUIRE(doc.GetPages().GetCount() == 1);
+        auto& page = doc.GetPages().GetPageAt(0);
+        REQUIRE(page.GetRect().Width == 300);
+        auto contents = doc.GetObjects().MustGetObject(PdfReference(4, 0)).MustGetStream().GetCopy();
+        REQUIRE(contents == streamData);
+    };
+
+    // Invalid startxref offset
+    check(body + "startxref\n99999\n%%EOF");
+    // Missing startxref
+    check(body + "%%EOF");
+}
+TEST_CASE("TestDocumentProbe")
+{
+    charbuff buffer;
+    {
+        PdfMemDocument doc;
+        for (unsigned i = 0; i < 3; i++)
+            doc.GetPages().CreatePage(PdfPageSize::A4);
+
+        doc.GetOrCreateAcroForm().GetDictionary().AddKey("SigFlags"_n, static_cast<int64_t>(2));
+        StringStreamDevice device(buffer);
+        doc.Save(device);
+    }
+
+    PdfDocumentProbe probe;
+    probe.ProbeFromBuffer(buffer);
+    REQUIRE(probe.GetPageCount() == 3);
+    REQUIRE(!probe.IsEncrypted());
+    REQUIRE(probe.GetIncrementalUpdateCount() == 0);
+    REQUIRE(probe.GetSigFlags() == PdfAcroFormSigFlags::AppendOnly);
+    REQUIRE(!probe.HasSignatures());
+    REQUIRE(!probe.HasDSS());
+
+    {
+        PdfMemDocument doc;
+        doc.LoadFromBuffer(buffer);
+        doc.GetCatalog().GetDictionary().AddKey("DSS"_n, PdfDictionary());
+        doc.GetOrCreateAcroForm().GetDictionary().AddKey("SigFlags"_n, static_cast<int64_t>(3));
+        StringStreamDevice device(buffer);
+        doc.SaveUpdate(device);
+    }
+
+    probe.ProbeFromBuffer(buffer);
+    REQUIRE(probe.GetPageCount() == 3);
+    REQUIRE(probe.GetIncrementalUpdateCount() == 1);
+    REQUIRE(probe.HasSignatures());
+    REQUIRE(probe.HasDSS());
+
+    // The catalog and the page tree root are compressed objects
+    // and a top level field is signed, without /SigFlags
+    probe.ProbeFromBuffer(generateObjectStreamPdf({
+        "<</Type/Catalog /Version/1.7 /Pages 2 0 R /AcroForm <</Fields [3 0 R]>>>>",
+        "<</Type/Pages /Kids [] /Count 0>>",
+        "<</FT/Sig /T(Signature1) /V <</Type/Sig>>>>",
+    }, { }, true));
+    REQUIRE(probe.GetPdfVersion() == PdfVersion::V1_7);
+    REQUIRE(probe.HasXRefStream());
+    REQUIRE(probe.GetPageCount() == 0);
+    REQUIRE(probe.GetSigFlags() == PdfAcroFormSigFlags::None);
+    REQUIRE(probe.HasSignatures());
+}
+
+TEST_CASE("TestParallelLoad")
+{
+    // Regular objects, object streams and streams with an
+    // indirect /Length are parsed the same on multiple threads
+    constexpr unsigned compressedCount = 200;
+    constexpr unsigned streamCount = 50;
+
+    // Objects 1 to compressedCount are in the object stream
+    vector<string> compressed = {
+        "<</Type/Catalog /Pages 2 0 R>>",
+        "<</Type/Pages /Kids [] /Count 0>>",
+    };
+    for (unsigned i = 3; i <= compressedCount; i++)
+        compressed.push_back("<</Key " + std::to_string(i) + " /Prev " + std::to_string(i - 1) + " 0 R>>");
+
+    // Each stream is followed by the object with its length
+    unsigned objStmNum = compressedCount + 1;
+    unsigned xrefNum = objStmNum + streamCount * 2 + 1;
+    vector<string> objects;
+    for (unsigned i = 0; i < streamCount; i++)
+    {
+        unsigned streamNum = objStmNum + 1 + i * 2;
+        string data = "Stream data " + std::to_string(i);
+        objects.push_back("<</Length " + std::to_string(streamNum + 1) + " 0 R>>stream\n" + data + "\nendstream");
+        objects.push_back(std::to_string(data.size()));
+    }
+
+    auto buffer = generateObjectStreamPdf(compressed, objects);
+
+    PdfMemDocument doc1;
+    doc1.LoadFromBuffer(buffer);
+
+    PdfMemDocument doc2;
+    doc2.SetLoadThreadCount(4);
+    doc2.LoadFromBuffer(buffer);
+
+    auto& objects1 = doc1.GetObjects();
+    auto& objects2 = doc2.GetObjects();
+    REQUIRE(objects1.GetSize() == xrefNum);
+    REQUIRE(objects2.GetSize() == objects1.GetSize());
+    for (auto obj1 : objects1)
+    {
+        auto obj2 = objects2.GetObject(obj1->GetIndirectReference());
+        REQUIRE(obj2 != nullptr);
+        REQUIRE(obj2->IsDelayedLoadDone());
+        REQUIRE(obj2->ToString() == obj1->ToString());
+        REQUIRE(obj2->HasStream() == obj1->HasStream());
+        if (obj1->HasStream())
+            REQUIRE(obj2->MustGetStream().GetCopy() == obj1->MustGetStream().GetCopy());
+    }
+
+    REQUIRE(objects2.MustGetObject(PdfReference(compressedCount, 0)).GetDictionary().MustFindKey("Key").GetNumber() == compressedCount);
+    REQUIRE(objects2.MustGetObject(PdfReference(objStmNum + 1, 0)).MustGetStream().GetCopy() == "Stream data 0");
+}
+
+namespace
+{
+    class CountingMemoryResource final : public pmr::memory_resource
+    {
+    public:
+        unsigned AllocationCount = 0;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            AllocationCount++;
+            return m_upstream.allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+        {
+            m_upstream.deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    private:
+        pmr::monotonic_buffer_resource m_upstream;
+    };
+}
+
+TEST_CASE("TestMemoryResource")
+{
+    charbuff buffer;
+    {
+        PdfMemDocument doc;
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        auto& obj = doc.GetObjects().CreateDictionaryObject();
+        const int64_t numbers[] = { 1, 2, 3 };
+        obj.GetDictionary().AddKey("Items", PdfArray::FromNumbers(cspan<int64_t>(numbers)));
+        doc.GetCatalog().GetDictionary().AddKeyIndirect("Extra", obj);
+        StringStreamDevice device(buffer);
+        doc.Save(device);
+    }
+
+    auto resource = std::make_shared<CountingMemoryResource>();
+    PdfMemDocument doc;
+    doc.SetMemoryResource(resource);
+    doc.LoadFromBuffer(buffer);
+    REQUIRE(doc.GetMemoryResource() == resource.get());
+
+    // Parsed dictionaries and arrays allocate their entries from the resource
+    REQUIRE(doc.GetPages().GetCount() == 1);
+    auto& items = doc.GetCatalog().GetDictionary().MustFindKey("Extra").GetDictionary().MustFindKey("Items").GetArray();
+    REQUIRE(items.GetSize() == 3);
+    REQUIRE(items[2].GetNumber() == 3);
+    unsigned count = resource->AllocationCount;
+    REQUIRE(count != 0);
+
+    // Copies use the default heap
+    PdfArray copy(items);
+    copy.Add(PdfObject(static_cast<int64_t>(4)));
+    REQUIRE(resource->AllocationCount == count);
+
+    // The resource is released only when the document is reloaded
+    weak_ptr<CountingMemoryResource> weak = resource;
+    doc.SetMemoryResource(nullptr);
+    resource = nullptr;
+    REQUIRE(!weak.expired());
+    doc.LoadFromBuffer(buffer);
+    REQUIRE(weak.expired());
+    REQUIRE(doc.GetMemoryResource() == nullptr);
+    REQUIRE(doc.GetPages().GetCount() == 1);
+}
+
 
 string generateXRefEntries(size_t count)
 {
@@ -2834,6 +3085,69 @@ string generateXRefEntries(size_t count)
     return strXRefEntries;
 }
 
+// Generate a PDF 1.5 file with the compressed objects, numbered from 1,
+// in an object stream, followed by its /Length object when indirect,
+// by the other objects and by an XRef stream with /W [1 4 2]
+string generateObjectStreamPdf(const vector<string>& compressed,
+    const vector<string>& objects, bool indirectLength)
+{
+    string header;
+    string body;
+    for (size_t i = 0; i < compressed.size(); i++)
+    {
+        header.append(std::to_string(i + 1)).append(" ").append(std::to_string(body.size())).append(" ");
+        body.append(compressed[i]).append("\n");
+    }
+
+    size_t objStmNum = compressed.size() + 1;
+    size_t objNum = objStmNum + 1;
+    vector<size_t> offsets;
+    ostringstream oss;
+    oss << "%PDF-1.5\n";
+    offsets.push_back((size_t)oss.tellp());
+    oss << objStmNum << " 0 obj<</Type/ObjStm /N " << compressed.size() << " /First " << header.size() << " /Length ";
+    if (indirectLength)
+        oss << objNum << " 0 R";
+    else
+        oss << header.size() + body.size();
+    oss << ">>stream\n" << header << body << "\nendstream endobj\n";
+
+    if (indirectLength)
+    {
+        offsets.push_back((size_t)oss.tellp());
+        oss << objNum << " 0 obj " << header.size() + body.size() << " endobj\n";
+        objNum++;
+    }
+
+    for (auto& obj : objects)
+    {
+        offsets.push_back((size_t)oss.tellp());
+        oss << objNum << " 0 obj " << obj << " endobj\n";
+        objNum++;
+    }
+
+    string xref;
+    auto appendEntry = [&xref](char type, size_t field2, unsigned field3) {
+        xref.push_back(type);
+        for (int shift = 24; shift >= 0; shift -= 8)
+            xref.push_back((char)((field2 >> shift) & 0xFF));
+        xref.push_back((char)(field3 >> 8));
+        xref.push_back((char)(field3 & 0xFF));
+    };
+    size_t xrefOffset = (size_t)oss.tellp();
+    offsets.push_back(xrefOffset);
+    appendEntry(0, 0, 0xFFFF);
+    for (size_t i = 0; i < compressed.size(); i++)
+        appendEntry(2, objStmNum, (unsigned)i);
+    for (size_t offset : offsets)
+        appendEntry(1, offset, 0);
+
+    oss << objNum << " 0 obj<</Type/XRef /Size " << objNum + 1 << " /W [1 4 2] /Root 1 0 R /Length "
+        << xref.size() << ">>stream\n" << xref << "\nendstream endobj\n";
+    oss << "startxref\n" << xrefOffset << "\n%%EOF";
+    return oss.str();
+}
+
 bool canOutOfMemoryKillUnitTests()
 {
     // test if out of memory conditions will kill the unit test process
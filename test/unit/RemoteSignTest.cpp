@@ -0,0 +1,539 @@
+/**
+ * SPDX-FileCopyrightText: (C) 2026 PoDoFo contributors
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ * SPDX-License-Identifier: MPL-2.0
+ */
+
+#include <PdfTest.h>
+
+#include <podofo/private/BinaryToText.h>
+#include <podofo/private/DerCache.h>
+#include <podofo/private/TimestampSizeCache.h>
+
+namespace PoDoFo
+{
+    class PdfSigningContextTest
+    {
+    public:
+        static void AddSignerUnsafe(PdfSigningContext& ctx, const PdfSignature& signature, PdfSigner& signer)
+        {
+            ctx.AddSignerUnsafe(signature, signer);
+        }
+    };
+}
+
+using namespace std;
+using namespace PoDoFo;
+
+namespace
+{
+    // A signer recording the data to sign
+    class RecordingSigner final : public PdfSigner
+    {
+    public:
+        charbuff Data;
+    public:
+        void Reset() override
+        {
+            Data.clear();
+        }
+        void AppendData(const bufferview& data) override
+        {
+            Data.append(data.data(), data.size());
+        }
+        void ComputeSignature(charbuff& contents, bool dryrun) override
+        {
+            contents = string(64, dryrun ? '\0' : 'S');
+        }
+        void FetchIntermediateResult(charbuff& result) override
+        {
+            result = Data;
+        }
+        void ComputeSignatureDeferred(const bufferview& processedResult, charbuff& contents, bool dryrun) override
+        {
+            (void)processedResult;
+            ComputeSignature(contents, dryrun);
+        }
+        string GetSignatureSubFilter() const override
+        {
+            return "adbe.pkcs7.detached";
+        }
+        string GetSignatureType() const override
+        {
+            return "Sig";
+        }
+    };
+}
+
+TEST_CASE("TestDocTimeStampByteRangeOffset")
+{
+    PdfMemDocument doc;
+    auto& page = doc.GetPages().CreatePage(PdfPageSize::A4);
+    auto& signature = page.CreateField<PdfSignature>("Signature", Rect(0, 0, 0, 0));
+    signature.EnsureValueObject();
+    REQUIRE(!signature.GetByteRangeOffset().has_value());
+
+    // An object written after the signature dictionary, holding
+    // a /ByteRange look-alike that must not be used for hashing
+    auto& decoy = doc.GetObjects().CreateDictionaryObject();
+    decoy.GetOrCreateStream().SetData("/ByteRange [ 0 10 20 30 ]"sv, PdfFilterList());
+    doc.GetCatalog().GetDictionary().AddKeyIndirect("Decoy"_n, decoy);
+
+    charbuff buffer;
+    auto device = std::make_shared<StringStreamDevice>(buffer);
+    auto signer = std::make_shared<PdfDocTimeStampSigner>();
+
+    PdfSigningContext ctx;
+    auto signerId = ctx.AddSigner(signature, signer);
+    PdfSigningResults results;
+    ctx.StartSigning(doc, device, results, PdfSaveOptions::SaveOnSigning | PdfSaveOptions::NoFlateCompress);
+
+    auto offset = signature.GetByteRangeOffset();
+    REQUIRE(offset.has_value());
+    REQUIRE(buffer[*offset] == '[');
+    REQUIRE(buffer.rfind("/ByteRange") > *offset);
+
+    istringstream iss(buffer.substr(*offset + 1, buffer.find(']', *offset) - *offset - 1));
+    size_t ranges[4];
+    REQUIRE(iss >> ranges[0] >> ranges[1] >> ranges[2] >> ranges[3]);
+    REQUIRE(ranges[2] + ranges[3] == buffer.size());
+    charbuff signedData = buffer.substr(ranges[0], ranges[1]) + buffer.substr(ranges[2], ranges[3]);
+    REQUIRE(results.Intermediate[signerId] == ssl::ComputeHash(signedData, PdfHashingAlgorithm::SHA256));
+}
+
+TEST_CASE("TestMultipleSignersByteRange")
+{
+    PdfMemDocument doc;
+    auto& page = doc.GetPages().CreatePage(PdfPageSize::A4);
+    auto& signature1 = page.CreateField<PdfSignature>("Signature1", Rect(0, 0, 0, 0));
+    auto& signature2 = page.CreateField<PdfSignature>("Signature2", Rect(0, 0, 0, 0));
+    signature1.EnsureValueObject();
+    signature2.EnsureValueObject();
+
+    charbuff buffer;
+    auto device = std::make_shared<StringStreamDevice>(buffer);
+    RecordingSigner signer1;
+    RecordingSigner signer2;
+    PdfSigningContext ctx;
+    PdfSigningContextTest::AddSignerUnsafe(ctx, signature1, signer1);
+    PdfSigningContextTest::AddSignerUnsafe(ctx, signature2, signer2);
+    PdfSigningResults results;
+    ctx.StartSigning(doc, device, results, PdfSaveOptions::SaveOnSigning | PdfSaveOptions::NoFlateCompress);
+
+    // The device is read once, but each signer receives
+    // exactly the data covered by its own /ByteRange
+    auto getSignedData = [&buffer](const PdfSignature& signature) {
+        auto offset = signature.GetByteRangeOffset();
+        REQUIRE(offset.has_value());
+        istringstream iss(buffer.substr(*offset + 1, buffer.find(']', *offset) - *offset - 1));
+        size_t ranges[4];
+        REQUIRE(iss >> ranges[0] >> ranges[1] >> ranges[2] >> ranges[3]);
+        REQUIRE(ranges[0] == 0);
+        REQUIRE(ranges[2] + ranges[3] == buffer.size());
+        return charbuff(buffer.substr(ranges[0], ranges[1]) + buffer.substr(ranges[2], ranges[3]));
+    };
+    auto signedData1 = getSignedData(signature1);
+    auto signedData2 = getSignedData(signature2);
+    REQUIRE(signedData1 != signedData2);
+    REQUIRE(signer1.Data == signedData1);
+    REQUIRE(signer2.Data == signedData2);
+    REQUIRE(results.Intermediate.size() == 2);
+
+    // Both the hex encoded signatures are written
+    ctx.FinishSigning(results);
+    string contents;
+    for (unsigned i = 0; i < 64; i++)
+        contents.append("53");
+    auto found = buffer.find(contents);
+    REQUIRE(found != string::npos);
+    REQUIRE(buffer.find(contents, found + contents.size()) != string::npos);
+}
+
+TEST_CASE("TestSigningMetrics")
+{
+    PdfMemDocument doc;
+    auto& page = doc.GetPages().CreatePage(PdfPageSize::A4);
+    auto& signature = page.CreateField<PdfSignature>("Signature", Rect(0, 0, 0, 0));
+    signature.EnsureValueObject();
+
+    charbuff buffer;
+    StringStreamDevice device(buffer);
+    auto signer = std::make_shared<RecordingSigner>();
+    PdfSigningContext ctx;
+    (void)ctx.AddSigner(signature, signer);
+    vector<PdfSigningPhaseMetrics> reported;
+    ctx.SetMetricsHandler([&reported](const PdfSigningPhaseMetrics& metrics) {
+        reported.push_back(metrics);
+    });
+    ctx.Sign(doc, device, PdfSaveOptions::SaveOnSigning);
+
+    // The phases are reported in order, with the bytes written,
+    // read back and written again into the /Contents
+    auto offset = signature.GetByteRangeOffset();
+    REQUIRE(offset.has_value());
+    istringstream iss(buffer.substr(*offset + 1, buffer.find(']', *offset) - *offset - 1));
+    size_t ranges[4];
+    REQUIRE(iss >> ranges[0] >> ranges[1] >> ranges[2] >> ranges[3]);
+    REQUIRE(reported.size() == 3);
+    REQUIRE(reported[0].Phase == PdfSigningPhase::Save);
+    REQUIRE(reported[0].ByteCount == buffer.size());
+    REQUIRE(reported[1].Phase == PdfSigningPhase::Hash);
+    REQUIRE(reported[1].ByteCount == buffer.size());
+    REQUIRE(reported[2].Phase == PdfSigningPhase::ComputeSignature);
+    REQUIRE(reported[2].ByteCount == ranges[2] - ranges[1]);
+    for (auto& metrics : reported)
+        REQUIRE(metrics.Duration.count() >= 0);
+
+    // A removed handler is not called anymore
+    reported.clear();
+    ctx.SetMetricsHandler(nullptr);
+    charbuff buffer2;
+    StringStreamDevice device2(buffer2);
+    ctx.Sign(doc, device2, PdfSaveOptions::SaveOnSigning);
+    REQUIRE(reported.empty());
+}
+
+TEST_CASE("TestDerCache")
+{
+    auto& cache = DerCache::Instance();
+    unsigned decodeCount = 0;
+    auto decode = [&decodeCount](const string_view& base64) {
+        decodeCount++;
+        vector<unsigned char> der(utls::GetBase64DecodedMaxSize(base64.size()));
+        size_t decodedSize;
+        REQUIRE(utls::TryDecodeBase64To(bufferspan((char*)der.data(), der.size()), base64, decodedSize));
+        der.resize(decodedSize);
+        return der;
+    };
+
+    // Unique data, as the cache is process-wide
+    string base64 = "VGVzdERlckNhY2hlIGFydGlmYWN0IDE=";
+    auto entry = cache.Get(base64, [&] { return decode(base64); });
+    REQUIRE(decodeCount == 1);
+    REQUIRE(entry->Der == "TestDerCache artifact 1");
+    REQUIRE(entry->Digest == ssl::ComputeHash(entry->Der, PdfHashingAlgorithm::SHA256));
+    REQUIRE(DerCache::GetCertificate(*entry) == nullptr);
+    auto parseError = entry->ParseError;
+    REQUIRE(!parseError.empty());
+
+    // The parse error is kept for the later requests,
+    // also from threads with an empty OpenSSL error queue
+    REQUIRE(DerCache::GetCertificate(*entry) == nullptr);
+    X509* threadCert = nullptr;
+    std::thread([&] { threadCert = DerCache::GetCertificate(*entry); }).join();
+    REQUIRE(threadCert == nullptr);
+    REQUIRE(entry->ParseError == parseError);
+
+    // The same text is a hit
+    REQUIRE(cache.Get(base64, [&] { return decode(base64); }) == entry);
+    REQUIRE(decodeCount == 1);
+
+    // The same base64 with different line wrapping is a hit as well
+    string wrapped = "VGVzdERlckNh\r\nY2hlIGFydGlm\nYWN0IDE=\n";
+    REQUIRE(cache.Get(wrapped, [&] { return decode(wrapped); }) == entry);
+    REQUIRE(decodeCount == 1);
+
+    // Different data is a miss
+    string other = "VGVzdERlckNhY2hlIGFydGlmYWN0IDI=";
+    auto otherEntry = cache.Get(other, [&] { return decode(other); });
+    REQUIRE(decodeCount == 2);
+    REQUIRE(otherEntry != entry);
+    REQUIRE(otherEntry->Der == "TestDerCache artifact 2");
+    REQUIRE(cache.Get(other, [&] { return decode(other); }) == otherEntry);
+    REQUIRE(decodeCount == 2);
+}
+
+using EVP_PKEY_ptr = unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>;
+using X509_ptr = unique_ptr<X509, decltype(&X509_free)>;
+
+// Create a throwaway self-signed certificate with the given extensions
+static X509_ptr createTestCertificate(EVP_PKEY* pkey, const vector<pair<int, string>>& extensions = { })
+{
+    X509_ptr cert(X509_new(), X509_free);
+    X509_set_version(cert.get(), 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert.get()), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert.get()), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert.get()), 3600);
+    auto name = X509_get_subject_name(cert.get());
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char*)"PoDoFo Test", -1, -1, 0);
+    X509_set_issuer_name(cert.get(), name);
+    X509_set_pubkey(cert.get(), pkey);
+    for (auto& extension : extensions)
+    {
+        auto ext = X509V3_EXT_conf_nid(nullptr, nullptr, extension.first, extension.second.c_str());
+        REQUIRE(ext != nullptr);
+        X509_add_ext(cert.get(), ext, -1);
+        X509_EXTENSION_free(ext);
+    }
+    REQUIRE(X509_sign(cert.get(), pkey, EVP_sha256()) != 0);
+    return cert;
+}
+
+// Create a throwaway self-signed certificate, as DER
+static vector<unsigned char> createTestCertificate()
+{
+    EVP_PKEY_ptr pkey(EVP_RSA_gen(2048), EVP_PKEY_free);
+    REQUIRE(pkey != nullptr);
+    auto cert = createTestCertificate(pkey.get());
+
+    int size = i2d_X509(cert.get(), nullptr);
+    REQUIRE(size > 0);
+    vector<unsigned char> der((size_t)size);
+    auto p = der.data();
+    i2d_X509(cert.get(), &p);
+    return der;
+}
+
+TEST_CASE("TestBatchSessionFailingDocument")
+{
+    SigningRequest request;
+    request.endEntityCertificate = createTestCertificate();
+    request.hashAlgorithmOID = "2.16.840.1.101.3.4.2.1";
+    for (unsigned i = 0; i < 3; i++)
+    {
+        PdfMemDocument doc;
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        auto inputPath = TestUtils::GetTestOutputFilePath("TestBatchSessionInput" + std::to_string(i) + ".pdf");
+        doc.Save(inputPath);
+        request.documents.push_back({ inputPath,
+            TestUtils::GetTestOutputFilePath("TestBatchSessionOutput" + std::to_string(i) + ".pdf"), "ADES_B_B" });
+    }
+
+    PdfRemoteSignBatchSession batch(request);
+    auto hashes = batch.beginSigning();
+    REQUIRE(hashes.size() == 3);
+
+    // The second signed value is invalid, the documents
+    // after it must be signed nonetheless
+    string signedValue(utls::GetBase64EncodedSize(256), '\0');
+    utls::EncodeBase64To(signedValue, string(256, 'S'));
+    REQUIRE_THROWS_AS(batch.finishSigning({ signedValue }), runtime_error);
+    auto errors = batch.finishSigning({ signedValue, "", signedValue });
+    REQUIRE(errors.size() == 3);
+    REQUIRE(errors[0] == nullptr);
+    REQUIRE(errors[1] != nullptr);
+    REQUIRE_THROWS_AS(std::rethrow_exception(errors[1]), runtime_error);
+    REQUIRE(errors[2] == nullptr);
+
+    for (unsigned i : { 0u, 2u })
+    {
+        PdfMemDocument doc;
+        doc.Load(request.documents[i].document_output_path);
+        const PdfObject* contents = nullptr;
+        for (auto obj : doc.GetObjects())
+        {
+            PdfName type;
+            if (obj->IsDictionary() && obj->GetDictionary().TryFindKeyAs("Type", type) && type == "Sig")
+                contents = obj->GetDictionary().FindKey("Contents");
+        }
+        REQUIRE(contents != nullptr);
+        // The CMS embeds the signed value as it is
+        REQUIRE(contents->GetString().GetRawData().find(string(256, 'S')) != string::npos);
+    }
+
+    // Finishing is allowed once
+    REQUIRE_THROWS_AS(batch.finishSigning({ signedValue, signedValue, signedValue }), runtime_error);
+}
+
+TEST_CASE("TestBatchSessionBeginRollback")
+{
+    SigningRequest request;
+    request.endEntityCertificate = createTestCertificate();
+    request.hashAlgorithmOID = "2.16.840.1.101.3.4.2.1";
+    for (unsigned i = 0; i < 3; i++)
+    {
+        PdfMemDocument doc;
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        auto inputPath = TestUtils::GetTestOutputFilePath("TestBatchSessionRollbackInput" + std::to_string(i) + ".pdf");
+        doc.Save(inputPath);
+        request.documents.push_back({ inputPath,
+            TestUtils::GetTestOutputFilePath("TestBatchSessionRollbackOutput" + std::to_string(i) + ".pdf"), "ADES_B_B" });
+    }
+
+    // The second document can't be loaded
+    auto& brokenPath = request.documents[1].document_input_path;
+    {
+        ofstream broken(brokenPath, ios::binary | ios::trunc);
+        broken << "Not a PDF";
+    }
+
+    // The document prepared before it is rolled back
+    PdfRemoteSignBatchSession batch(request);
+    REQUIRE_THROWS(batch.beginSigning());
+    REQUIRE(fs::file_size(request.documents[0].document_output_path)
+        == fs::file_size(request.documents[0].document_input_path));
+    string signedValue(utls::GetBase64EncodedSize(256), '\0');
+    utls::EncodeBase64To(signedValue, string(256, 'S'));
+    REQUIRE_THROWS_AS(batch.finishSigning({ signedValue, signedValue, signedValue }), runtime_error);
+
+    // The batch can be started again once the document is fixed
+    {
+        PdfMemDocument doc;
+        doc.GetPages().CreatePage(PdfPageSize::A4);
+        doc.Save(brokenPath);
+    }
+    REQUIRE(batch.beginSigning().size() == 3);
+    auto errors = batch.finishSigning({ signedValue, signedValue, signedValue });
+    REQUIRE(errors.size() == 3);
+    for (auto& error : errors)
+        REQUIRE(error == nullptr);
+
+    for (auto& document : request.documents)
+    {
+        PdfMemDocument doc;
+        doc.Load(document.document_output_path);
+        REQUIRE(doc.GetAcroForm() != nullptr);
+        REQUIRE(fs::file_size(document.document_output_path) > fs::file_size(document.document_input_path));
+    }
+}
+
+TEST_CASE("TestTimestampSizeCache")
+{
+    auto& cache = TimestampSizeCache::instance();
+
+    // Unique keys, as the cache is process-wide
+    string key = "TestTimestampSizeCache";
+    REQUIRE(cache.estimate(key, false) == TimestampSizeCache::DefaultReserve);
+    REQUIRE(cache.estimate(key, true) == TimestampSizeCache::DefaultReserve);
+
+    // Small tokens get the minimum margin
+    cache.update(key, 1000);
+    REQUIRE(cache.estimate(key, false) == 1000 + TimestampSizeCache::MinReserveMargin);
+
+    // Larger tokens get a margin proportional to their size
+    cache.update(key, 8000);
+    REQUIRE(cache.estimate(key, false) == 8800);
+
+    // The largest size observed is kept
+    cache.update(key, 6000);
+    REQUIRE(cache.estimate(key, false) == 8800);
+
+    // With an unknown TSA the default reservation is the minimum,
+    // but larger observed tokens are still accounted
+    REQUIRE(cache.estimate(key, true) == TimestampSizeCache::DefaultReserve);
+    cache.update(key, 30000);
+    REQUIRE(cache.estimate(key, true) == 33000);
+    REQUIRE(cache.estimate(key, false) == 33000);
+}
+
+// Create a base64 TimeStampResp granting a token of at least the given size,
+// padded with a comment in the TSA certificate embedded in the token
+static string createTestTsr(size_t size)
+{
+    EVP_PKEY_ptr pkey(EVP_RSA_gen(2048), EVP_PKEY_free);
+    REQUIRE(pkey != nullptr);
+    auto cert = createTestCertificate(pkey.get(), {
+        { NID_ext_key_usage, "critical,timeStamping" },
+        { NID_netscape_comment, string(size, 'T') } });
+
+    unique_ptr<TS_REQ, decltype(&TS_REQ_free)> request(TS_REQ_new(), TS_REQ_free);
+    unique_ptr<TS_MSG_IMPRINT, decltype(&TS_MSG_IMPRINT_free)> imprint(TS_MSG_IMPRINT_new(), TS_MSG_IMPRINT_free);
+    unique_ptr<X509_ALGOR, decltype(&X509_ALGOR_free)> algorithm(X509_ALGOR_new(), X509_ALGOR_free);
+    X509_ALGOR_set_md(algorithm.get(), EVP_sha256());
+    TS_MSG_IMPRINT_set_algo(imprint.get(), algorithm.get());
+    unsigned char digest[32] = { };
+    TS_MSG_IMPRINT_set_msg(imprint.get(), digest, sizeof(digest));
+    TS_REQ_set_version(request.get(), 1);
+    TS_REQ_set_msg_imprint(request.get(), imprint.get());
+    TS_REQ_set_cert_req(request.get(), 1);
+
+    unique_ptr<BIO, decltype(&BIO_free)> requestBio(BIO_new(BIO_s_mem()), BIO_free);
+    REQUIRE(i2d_TS_REQ_bio(requestBio.get(), request.get()) != 0);
+
+    unique_ptr<TS_RESP_CTX, decltype(&TS_RESP_CTX_free)> ctx(TS_RESP_CTX_new(), TS_RESP_CTX_free);
+    unique_ptr<ASN1_OBJECT, decltype(&ASN1_OBJECT_free)> policy(OBJ_txt2obj("1.2.3.4", 1), ASN1_OBJECT_free);
+    TS_RESP_CTX_set_signer_cert(ctx.get(), cert.get());
+    TS_RESP_CTX_set_signer_key(ctx.get(), pkey.get());
+    TS_RESP_CTX_set_signer_digest(ctx.get(), EVP_sha256());
+    TS_RESP_CTX_set_def_policy(ctx.get(), policy.get());
+    TS_RESP_CTX_add_md(ctx.get(), EVP_sha256());
+    unique_ptr<TS_RESP, decltype(&TS_RESP_free)> response(TS_RESP_create_response(ctx.get(), requestBio.get()), TS_RESP_free);
+    REQUIRE(response != nullptr);
+    REQUIRE(TS_RESP_get_token(response.get()) != nullptr);
+
+    int tsrSize = i2d_TS_RESP(response.get(), nullptr);
+    REQUIRE(tsrSize > (int)size);
+    string tsr((size_t)tsrSize, '\0');
+    auto p = (unsigned char*)tsr.data();
+    i2d_TS_RESP(response.get(), &p);
+
+    string ret(utls::GetBase64EncodedSize(tsr.size()), '\0');
+    utls::EncodeBase64To(ret, tsr);
+    return ret;
+}
+
+TEST_CASE("TestTimestampReserveExceeded")
+{
+    auto cert = createTestCertificate();
+    string certBase64(utls::GetBase64EncodedSize(cert.size()), '\0');
+    utls::EncodeBase64To(certBase64, bufferview((const char*)cert.data(), cert.size()));
+    string signedValue(utls::GetBase64EncodedSize(256), '\0');
+    utls::EncodeBase64To(signedValue, string(256, 'S'));
+
+    // Larger than the default reservation used when no token has been observed
+    string tsr = createTestTsr(TimestampSizeCache::DefaultReserve + 5000);
+
+    for (auto mode : { SigningOutputMode::Copy, SigningOutputMode::InPlace, SigningOutputMode::Delta })
+    {
+        auto suffix = std::to_string((int)mode) + ".pdf";
+        auto inputPath = TestUtils::GetTestOutputFilePath("TestTimestampReserveExceededInput" + suffix);
+        auto outputPath = TestUtils::GetTestOutputFilePath("TestTimestampReserveExceededOutput" + suffix);
+        {
+            PdfMemDocument doc;
+            doc.GetPages().CreatePage(PdfPageSize::A4);
+            doc.Save(inputPath);
+        }
+        auto inputSize = fs::file_size(inputPath);
+
+        PdfRemoteSignDocumentSession session("ADES_B_T", "2.16.840.1.101.3.4.2.1", inputPath, outputPath, certBase64, { });
+        session.setOutputMode(mode);
+        // Unique TSA, as the cache is process-wide
+        session.setTimestampAuthorityUrl("https://tsa.test/TestTimestampReserveExceeded/" + suffix);
+        auto hash = session.beginSigning();
+
+        // The token doesn't fit, the document is prepared again
+        string newHash;
+        try
+        {
+            session.finishSigning(signedValue, tsr);
+            FAIL("The timestamp token should not fit");
+        }
+        catch (const TimestampReserveExceededError& ex)
+        {
+            newHash = ex.getHash();
+        }
+        REQUIRE(!newHash.empty());
+        REQUIRE(newHash != hash);
+
+        // The values for the new hash fit
+        session.finishSigning(signedValue, tsr);
+
+        charbuff signedDoc;
+        utls::ReadTo(signedDoc, mode == SigningOutputMode::InPlace ? inputPath : outputPath);
+        if (mode == SigningOutputMode::Delta)
+        {
+            charbuff input;
+            utls::ReadTo(input, inputPath);
+            REQUIRE(input.size() == inputSize);
+            signedDoc = input + signedDoc;
+        }
+
+        // A single signed revision was appended
+        size_t revisions = 0;
+        for (size_t pos = signedDoc.find("%%EOF"); pos != string::npos; pos = signedDoc.find("%%EOF", pos + 1))
+            revisions++;
+        REQUIRE(revisions == 2);
+
+        PdfMemDocument doc;
+        doc.LoadFromBuffer(signedDoc);
+        const PdfObject* contents = nullptr;
+        for (auto obj : doc.GetObjects())
+        {
+            PdfName type;
+            if (obj->IsDictionary() && obj->GetDictionary().TryFindKeyAs("Type", type) && type == "Sig")
+                contents = obj->GetDictionary().FindKey("Contents");
+        }
+        REQUIRE(contents != nullptr);
+        REQUIRE(contents->GetString().GetRawData().find(string(1000, 'T')) != string::npos);
+    }
+}
@@ -171,6 +171,58 @@ TEST_CASE("TestComments")
     TestStreamIsNextToken(pszBuffer, pszTokens);
 }
 
+TEST_CASE("TestViewTokenization")
+{
+    // SpanStreamDevice exposes its contents as a view, so the tokenizer
+    // scans them directly: it must match the character based reading
+    string buffer = "1 0 obj% comment after a token\n<</A(str\\(ing\\)\\101)/B<41 4\n2>"
+        "/C[1 2 R -4]/D/#41b>>stream\r\nendobj %eof comment\n{ } <> > <";
+
+    SpanStreamDevice viewDevice(buffer);
+    istringstream stream(buffer);
+    StandardStreamDevice device(stream);
+    PdfTokenizer viewTokenizer;
+    PdfTokenizer tokenizer;
+    string_view viewToken;
+    string_view token;
+    PdfTokenType viewTokenType;
+    PdfTokenType tokenType;
+    while (true)
+    {
+        bool gotViewToken = viewTokenizer.TryReadNextToken(viewDevice, viewToken, viewTokenType);
+        bool gotToken = tokenizer.TryReadNextToken(device, token, tokenType);
+        REQUIRE(gotViewToken == gotToken);
+        if (!gotToken)
+            break;
+
+        REQUIRE(viewToken == token);
+        REQUIRE(viewTokenType == tokenType);
+        REQUIRE(viewDevice.GetPosition() == device.GetPosition());
+    }
+
+    SpanStreamDevice viewDevice2(buffer);
+    istringstream stream2(buffer);
+    StandardStreamDevice device2(stream2);
+    int64_t num;
+    REQUIRE(viewTokenizer.TryReadNextNumber(viewDevice2, num));
+    REQUIRE(tokenizer.TryReadNextNumber(device2, num));
+    REQUIRE(viewTokenizer.TryReadNextNumber(viewDevice2, num));
+    REQUIRE(tokenizer.TryReadNextNumber(device2, num));
+    REQUIRE(viewTokenizer.TryReadNextToken(viewDevice2, viewToken));
+    REQUIRE(tokenizer.TryReadNextToken(device2, token));
+
+    PdfVariant viewVariant;
+    PdfVariant variant;
+    viewTokenizer.ReadNextVariant(viewDevice2, viewVariant);
+    tokenizer.ReadNextVariant(device2, variant);
+    string viewStr;
+    string str;
+    viewVariant.ToString(viewStr);
+    variant.ToString(str);
+    REQUIRE(viewStr == str);
+    REQUIRE(viewStr == "<</A(str\\(ing\\)A)/B<4142>/C[ 1 2 R -4]/D/Ab>>");
+}
+
 TEST_CASE("TestLocale")
 {
     // Test with a locale thate uses "," instead of "." for doubles 